@@ -1,25 +1,44 @@
-
-
 if (BUILD_WITH_ZYDIS)
     message(STATUS "BUILD_WITH_ZYDIS=ON; forcing Zydis backend and skipping Cargo lookup")
-    add_compile_definitions(ICED_NOT_FOUND)
-    return()
+    set(ICED_USE_ZYDIS TRUE)
+else()
+    find_program(CARGO_EXECUTABLE cargo)
+
+    if (NOT CARGO_EXECUTABLE)
+        message("Cargo not found. Default to Zydis.")
+        set(ICED_NOT_FOUND TRUE CACHE BOOL "Rust/Cargo not found => building with the Zydis backend")
+        set(ICED_USE_ZYDIS TRUE)
+    endif()
 endif()
 
-find_program(CARGO_EXECUTABLE cargo)
+include(FetchContent)
+
+if (ICED_USE_ZYDIS)
+    set(ZYDIS_BUILD_TOOLS OFF CACHE BOOL "" FORCE)
+    set(ZYDIS_BUILD_EXAMPLES OFF CACHE BOOL "" FORCE)
+    set(ZYDIS_BUILD_DOXYGEN OFF CACHE BOOL "" FORCE)
 
-if (NOT CARGO_EXECUTABLE)
-    message("Cargo not found. Default to Zydis.")
-    set(ICED_NOT_FOUND TRUE CACHE BOOL "Rust/Cargo not found => building with the Zydis backend")
-    add_compile_definitions(ICED_NOT_FOUND)
+    FetchContent_Declare(
+        Zydis
+        GIT_REPOSITORY https://github.com/zyantific/zydis.git
+        GIT_TAG v4.1.0
+    )
+
+    FetchContent_MakeAvailable(Zydis)
+
+    # Same C interface as the Rust crate, so icedpp links against Iced_Wrapper either way
+    add_library(Iced_Wrapper STATIC ${CMAKE_CURRENT_LIST_DIR}/../icedpp_zydis/zydis_backend.cpp)
+    target_include_directories(Iced_Wrapper PRIVATE ${CMAKE_CURRENT_LIST_DIR}/../icedpp)
+    target_compile_features(Iced_Wrapper PRIVATE cxx_std_17)
+    target_link_libraries(Iced_Wrapper PUBLIC Zydis)
+    # Carried by the target, so every consumer sees the right iced::backendName wherever it is defined
+    target_compile_definitions(Iced_Wrapper PUBLIC ICED_NOT_FOUND)
 
     return()
 endif()
 
 message("Cargo found. Default to Iced.")
 
-include(FetchContent)
-
 FetchContent_Declare(
     Corrosion
     GIT_REPOSITORY https://github.com/NaC-L/corrosion.git # some issue with linker, i forgot, enabling flag should help?, hopefully my patch doesnt break anything
@@ -32,4 +51,4 @@ corrosion_import_crate(MANIFEST_PATH icedpp_rust_lib/Cargo.toml)
 
 
 set(ICED_FOUND TRUE CACHE BOOL "Rust/Cargo found => building with the Iced (Rust) backend")
-add_compile_definitions(ICED_FOUND)
+target_compile_definitions(Iced_Wrapper INTERFACE ICED_FOUND)
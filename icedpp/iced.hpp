@@ -18,6 +18,10 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 
 #ifdef ICED_USE_STD_STRING
 #include <string>
@@ -53,6 +57,40 @@
 extern "C" {
 	int disas ( void* obj, const void* code, std::size_t len );
 	int disas2 ( void* obj, const void* code, std::size_t len );
+	int disas2_intel ( void* obj, const void* code, std::size_t len );
+	int disas2_masm ( void* obj, const void* code, std::size_t len );
+	int disas2_nasm ( void* obj, const void* code, std::size_t len );
+	int disas2_gas ( void* obj, const void* code, std::size_t len );
+	std::ptrdiff_t format_batch ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count );
+	std::ptrdiff_t format_batch_intel ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count );
+	std::ptrdiff_t format_batch_masm ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count );
+	std::ptrdiff_t format_batch_nasm ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count );
+	std::ptrdiff_t format_batch_gas ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count );
+	std::ptrdiff_t format_batch_sym ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,
+		__iced_internal::IcedSymbolCallback resolver, void* context );
+	std::ptrdiff_t format_batch_sym_intel ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,
+		__iced_internal::IcedSymbolCallback resolver, void* context );
+	std::ptrdiff_t format_batch_sym_masm ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,
+		__iced_internal::IcedSymbolCallback resolver, void* context );
+	std::ptrdiff_t format_batch_sym_nasm ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,
+		__iced_internal::IcedSymbolCallback resolver, void* context );
+	std::ptrdiff_t format_batch_sym_gas ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,
+		__iced_internal::IcedSymbolCallback resolver, void* context );
+	std::ptrdiff_t disas_superset ( void* lengths, void* flows, const void* code, std::size_t len, std::size_t first, std::size_t count );
+	std::ptrdiff_t disas_gather ( void* out, const void* code, std::size_t len, std::uint64_t baseAddress, const std::uint64_t* ips, std::size_t count );
+	std::ptrdiff_t disas_find_cpuid ( std::uint64_t* out, std::size_t capacity, const void* code, std::size_t len, std::uint64_t baseAddress,
+		std::size_t first, std::uint8_t groups, std::size_t* next );
+	void warm_up_thread ( );
 }
 
 NODISCARD constexpr OpKindSimple opkind_map_to_simple ( OpKind rawType ) {
@@ -96,12 +134,254 @@ constexpr bool operator==( OpKindSimple lhs, OpKind rhs ) noexcept {
 /* CLASSES */
 namespace iced
 {
-	class Instruction {
-	public:
-		Instruction ( ) = default;
-		Instruction ( const __iced_internal::IcedInstruction& instruction, std::uint64_t ip_ ) : icedInstr ( instruction ), ip ( ip_ ) { }
-		~Instruction ( ) { }
+	/// Backend Iced_Wrapper was built from; chosen at configure time (BUILD_WITH_ZYDIS, or no cargo)
+#ifdef ICED_NOT_FOUND
+	inline constexpr std::string_view backendName = "zydis";
+#else
+	inline constexpr std::string_view backendName = "iced";
+#endif
+
+	/// <summary>
+	///  Output syntax policies for DebugDecoder and BatchFormatter. Each one binds
+	///  to its own monomorphized Rust entry points, so the choice costs nothing at runtime.
+	/// </summary>
+	namespace syntax
+	{
+		/// iced's SpecializedFormatter, Intel-like output; the fastest option
+		struct Fast {
+			static constexpr auto decode = disas2;
+			static constexpr auto format = format_batch;
+			static constexpr auto format_symbols = format_batch_sym;
+		};
+
+		struct Intel {
+			static constexpr auto decode = disas2_intel;
+			static constexpr auto format = format_batch_intel;
+			static constexpr auto format_symbols = format_batch_sym_intel;
+		};
+
+		struct Masm {
+			static constexpr auto decode = disas2_masm;
+			static constexpr auto format = format_batch_masm;
+			static constexpr auto format_symbols = format_batch_sym_masm;
+		};
+
+		struct Nasm {
+			static constexpr auto decode = disas2_nasm;
+			static constexpr auto format = format_batch_nasm;
+			static constexpr auto format_symbols = format_batch_sym_nasm;
+		};
+
+		/// AT&T syntax
+		struct Gas {
+			static constexpr auto decode = disas2_gas;
+			static constexpr auto format = format_batch_gas;
+			static constexpr auto format_symbols = format_batch_sym_gas;
+		};
+	};
+
+	/// <summary>
+	///  Register metadata from the generated table in iced_internal.hpp. Everything is
+	///  constexpr and resolved with a single indexed load, no call into the backend.
+	/// </summary>
+	NODISCARD constexpr const __iced_internal::IcedRegisterInfo& register_info ( Register reg ) noexcept {
+		return __iced_internal::registerInfo [ static_cast< std::uint8_t >( reg ) ];
+	}
+
+	/// Size in bytes, 0 for Register::None
+	NODISCARD constexpr std::uint16_t register_size ( Register reg ) noexcept { return register_info ( reg ).size; }
+	NODISCARD constexpr RegisterClass register_class ( Register reg ) noexcept { return register_info ( reg ).kind; }
+	/// First register of the same kind, e.g. EAX for R9D
+	NODISCARD constexpr Register register_base ( Register reg ) noexcept { return register_info ( reg ).base; }
+	/// Index within its kind, e.g. 9 for R9D, 4 for AH
+	NODISCARD constexpr std::uint8_t register_number ( Register reg ) noexcept { return register_info ( reg ).number; }
+	/// Widest register this one is part of: AL/AH/AX/EAX -> RAX, XMM0/YMM0 -> ZMM0, EIP -> RIP
+	NODISCARD constexpr Register full_register ( Register reg ) noexcept { return register_info ( reg ).full; }
+	/// Same as full_register ( ), except general purpose registers map to their 32-bit form
+	NODISCARD constexpr Register full_register32 ( Register reg ) noexcept { return register_info ( reg ).full32; }
+
+	NODISCARD constexpr bool is_gpr8 ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Gpr8; }
+	NODISCARD constexpr bool is_gpr16 ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Gpr16; }
+	NODISCARD constexpr bool is_gpr32 ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Gpr32; }
+	NODISCARD constexpr bool is_gpr64 ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Gpr64; }
+	NODISCARD constexpr bool is_gpr ( Register reg ) noexcept {
+		return register_class ( reg ) >= RegisterClass::Gpr8 && register_class ( reg ) <= RegisterClass::Gpr64;
+	}
+	NODISCARD constexpr bool is_ip ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Ip; }
+	NODISCARD constexpr bool is_segment_register ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Segment; }
+	NODISCARD constexpr bool is_xmm ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Xmm; }
+	NODISCARD constexpr bool is_ymm ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Ymm; }
+	NODISCARD constexpr bool is_zmm ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Zmm; }
+	NODISCARD constexpr bool is_vector_register ( Register reg ) noexcept {
+		return register_class ( reg ) >= RegisterClass::Xmm && register_class ( reg ) <= RegisterClass::Zmm;
+	}
+	NODISCARD constexpr bool is_k ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::K; }
+	NODISCARD constexpr bool is_bnd ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Bnd; }
+	NODISCARD constexpr bool is_cr ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Cr; }
+	NODISCARD constexpr bool is_dr ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Dr; }
+	NODISCARD constexpr bool is_st ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::St; }
+	NODISCARD constexpr bool is_mm ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Mm; }
+	NODISCARD constexpr bool is_tr ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Tr; }
+	NODISCARD constexpr bool is_tmm ( Register reg ) noexcept { return register_class ( reg ) == RegisterClass::Tmm; }
+
+	/// <summary>
+	///  The `size`-byte register covering the low bytes of `reg`'s full register:
+	///  ( RAX, 1 ) -> AL, ( R9D, 2 ) -> R9W, ( ZMM3, 16 ) -> XMM3
+	/// </summary>
+	/// <returns>Register::None if no such register exists</returns>
+	NODISCARD constexpr Register sub_register ( Register reg, std::uint16_t size ) noexcept {
+		const auto kind = register_class ( reg );
+		const auto offset = [ ] ( Register base, std::uint8_t number ) {
+			return static_cast< Register >( static_cast< std::uint8_t >( base ) + number );
+		};
+
+		if ( is_gpr ( reg ) ) {
+			const auto number = register_number ( full_register ( reg ) );
+			switch ( size ) {
+				case 1:
+					// AH..BH sit between BL and SPL
+					return offset ( Register::AL, static_cast< std::uint8_t >( number < 4 ? number : number + 4 ) );
+				case 2:
+					return offset ( Register::AX, number );
+				case 4:
+					return offset ( Register::EAX, number );
+				case 8:
+					return offset ( Register::RAX, number );
+				default:
+					return Register::None;
+			}
+		}
+
+		if ( kind >= RegisterClass::Xmm && kind <= RegisterClass::Zmm ) {
+			const auto number = register_number ( reg );
+			switch ( size ) {
+				case 16:
+					return offset ( Register::XMM0, number );
+				case 32:
+					return offset ( Register::YMM0, number );
+				case 64:
+					return offset ( Register::ZMM0, number );
+				default:
+					return Register::None;
+			}
+		}
+
+		return register_size ( reg ) == size ? reg : Register::None;
+	}
+
+	/// AH, CH, DH or BH for registers of RAX..RBX, otherwise Register::None
+	NODISCARD constexpr Register high_byte_register ( Register reg ) noexcept {
+		const auto number = register_number ( full_register ( reg ) );
+		return is_gpr ( reg ) && number < 4 ? static_cast< Register >( static_cast< std::uint8_t >( Register::AH ) + number ) : Register::None;
+	}
+
+	/// <summary>
+	///  Whether writing one register can change the other (same full register, except
+	///  that the high and low byte registers, e.g. AH and AL, do not overlap)
+	/// </summary>
+	NODISCARD constexpr bool registers_overlap ( Register lhs, Register rhs ) noexcept {
+		if ( lhs == rhs ) {
+			return lhs != Register::None;
+		}
+
+		if ( full_register ( lhs ) != full_register ( rhs ) || full_register ( lhs ) == Register::None ) {
+			return false;
+		}
+
+		return !( is_gpr8 ( lhs ) && is_gpr8 ( rhs ) );
+	}
+
+	/// Lowercase name, e.g. "vpaddd"; empty for out-of-range values
+	NODISCARD constexpr std::string_view mnemonic_name ( Mnemonic mnemonic ) noexcept {
+		return mnemonic < Mnemonic::COUNT ? __iced_internal::mnemonicNames [ static_cast< std::uint16_t >( mnemonic ) ] : "";
+	}
+
+	/// Lowercase name, e.g. "r8d"; empty for the reserved values
+	NODISCARD constexpr std::string_view register_name ( Register reg ) noexcept {
+		return __iced_internal::registerNames [ static_cast< std::uint8_t >( reg ) ];
+	}
+
+	/// <summary>
+	///  Case-insensitive name to Mnemonic through a generated perfect hash: two hashes,
+	///  one table probe and one string compare, also usable in constant expressions
+	/// </summary>
+	/// <returns>Mnemonic::INVALID for unknown names</returns>
+	NODISCARD constexpr Mnemonic parse_mnemonic ( std::string_view name ) noexcept {
+		const auto value = __iced_internal::name_lookup ( __iced_internal::mnemonicHashSeeds, __iced_internal::mnemonicHashSlots,
+															 __iced_internal::mnemonicNames, name.data ( ), name.size ( ) );
+		return value < 0 ? Mnemonic::INVALID : static_cast< Mnemonic >( value );
+	}
+
+	/// <returns>Register::None for unknown names</returns>
+	NODISCARD constexpr Register parse_register ( std::string_view name ) noexcept {
+		const auto value = __iced_internal::name_lookup ( __iced_internal::registerHashSeeds, __iced_internal::registerHashSlots,
+															 __iced_internal::registerNames, name.data ( ), name.size ( ) );
+		return value < 0 ? Register::None : static_cast< Register >( value );
+	}
+
+	static_assert( full_register ( Register::AH ) == Register::RAX, "invalid register table" );
+	static_assert( full_register ( Register::R10W ) == Register::R10, "invalid register table" );
+	static_assert( full_register ( Register::YMM17 ) == Register::ZMM17, "invalid register table" );
+	static_assert( register_size ( Register::XMM3 ) == 16 && register_size ( Register::DIL ) == 1, "invalid register table" );
+	static_assert( sub_register ( Register::RSI, 1 ) == Register::SIL, "invalid register table" );
+	static_assert( parse_mnemonic ( "VPADDD" ) == Mnemonic::Vpaddd && mnemonic_name ( Mnemonic::Vpaddd ) == "vpaddd", "invalid name table" );
+	static_assert( parse_register ( "r8d" ) == Register::R8D && parse_register ( "r8" ) == Register::R8, "invalid name table" );
+
+	/// <summary>
+	///  Upper bound on Code values (iced-x86 1.21 has fewer than 5000); 13 bits leave room for
+	///  later versions. The `code` ctest fails if the backend reports a Code at or above it.
+	/// </summary>
+	inline constexpr std::size_t codeTableSize = 8192;
+
+	/// Lowercase names of the CpuidGroup bits, lowest bit first
+	inline constexpr std::string_view cpuidGroupNames [ 8 ] = { "general", "x87", "mmx", "sse", "avx", "avx512", "amx", "system" };
+
+	/// <summary>
+	///  CpuidGroup of one CPUID feature as spelled by iced (SSE4_1, AVX512_BF16, FPU387) or of
+	///  one Zydis ISA extension (SSE4, AVX512EVEX, X87, VTX). The Rust library applies the same
+	///  prefixes to iced's CpuidFeature names.
+	/// </summary>
+	NODISCARD constexpr CpuidGroup cpuid_group ( std::string_view feature ) noexcept {
+		const auto starts = [ feature ] ( std::string_view prefix ) { return feature.substr ( 0, prefix.size ( ) ) == prefix; };
+
+		if ( starts ( "AVX512" ) || starts ( "AVX10" ) ) {
+			return CpuidGroup::Avx512;
+		}
+		if ( starts ( "AMX" ) ) {
+			return CpuidGroup::Amx;
+		}
+		if ( starts ( "AVX" ) || starts ( "FMA" ) || starts ( "F16C" ) || starts ( "XOP" ) || starts ( "VAES" ) || starts ( "VPCLMULQDQ" ) ||
+			 starts ( "SHA512" ) || starts ( "SM3" ) || starts ( "SM4" ) ) {
+			return CpuidGroup::Avx;
+		}
+		if ( starts ( "SSE" ) || starts ( "SSSE" ) || starts ( "AES" ) || starts ( "PCLMULQDQ" ) || feature == "SHA" || starts ( "GFNI" ) ) {
+			return CpuidGroup::Sse;
+		}
+		if ( feature == "MMX" || starts ( "D3NOW" ) || starts ( "AMD3DNOW" ) ) {
+			return CpuidGroup::Mmx;
+		}
+		if ( starts ( "FPU" ) || feature == "X87" ) {
+			return CpuidGroup::X87;
+		}
+		for ( const auto prefix : { "VMX", "VTX", "SVM", "SMX", "SGX", "TDX", "SEV" } ) {
+			if ( starts ( prefix ) ) {
+				return CpuidGroup::System;
+			}
+		}
+		return CpuidGroup::General;
+	}
+
+	static_assert( cpuid_group ( "AVX512_BF16" ) == CpuidGroup::Avx512 && cpuid_group ( "AVX2" ) == CpuidGroup::Avx, "invalid cpuid group" );
+	static_assert( cpuid_group ( "SSSE3" ) == CpuidGroup::Sse && cpuid_group ( "SHA512" ) == CpuidGroup::Avx, "invalid cpuid group" );
+	static_assert( cpuid_group ( "FPU387" ) == CpuidGroup::X87 && cpuid_group ( "INTEL8086" ) == CpuidGroup::General, "invalid cpuid group" );
 
+	/// <summary>
+	///  Accessors shared by every instruction representation. Derived types expose
+	///  the decoded record through record ( ) and the instruction address through `ip`.
+	/// </summary>
+	template<typename Derived>
+	class InstructionAccessors {
+	public:
 		NODISCARD FlowControl flow_control ( ) const noexcept {
 			if ( jcc ( ) ) {
 				return FlowControl::ConditionalBranch;
@@ -122,7 +402,7 @@ namespace iced
 				return FlowControl::Call;
 			}
 
-			switch ( icedInstr.mnemonic ) {
+			switch ( instr ( ).mnemonic ) {
 				case Mnemonic::Syscall:
 				case Mnemonic::Sysenter:
 				case Mnemonic::Vmlaunch:
@@ -190,7 +470,7 @@ namespace iced
 					4    // FarBranch
 			};
 
-			return lookup [ static_cast< uint8_t >( icedInstr.types [ index ] ) ];
+			return lookup [ static_cast< uint8_t >( instr ( ).types [ index ] ) ];
 		}
 		/// <summary>
 		///  Calculates size of operand in bytes
@@ -241,13 +521,13 @@ namespace iced
 		/// <returns>Width in bits</returns>
 		NODISCARD FORCE_INLINE std::size_t op3_bit_width ( ) const noexcept { return op_bit_width ( 3 ); }
 
-		NODISCARD FORCE_INLINE OpKind op_kind ( std::size_t index ) const noexcept { return static_cast< OpKind >( icedInstr.types [ index ] ); }
+		NODISCARD FORCE_INLINE OpKind op_kind ( std::size_t index ) const noexcept { return static_cast< OpKind >( instr ( ).types [ index ] ); }
 		NODISCARD FORCE_INLINE OpKind op0_kind ( ) const noexcept { return op_kind ( 0 ); }
 		NODISCARD FORCE_INLINE OpKind op1_kind ( ) const noexcept { return op_kind ( 1 ); }
 		NODISCARD FORCE_INLINE OpKind op2_kind ( ) const noexcept { return op_kind ( 2 ); }
 		NODISCARD FORCE_INLINE OpKind op3_kind ( ) const noexcept { return op_kind ( 3 ); }
 
-		NODISCARD FORCE_INLINE OpKindSimple op_kind_simple ( std::size_t index ) const noexcept { return opkind_map_to_simple ( icedInstr.types [ index ] ); }
+		NODISCARD FORCE_INLINE OpKindSimple op_kind_simple ( std::size_t index ) const noexcept { return opkind_map_to_simple ( instr ( ).types [ index ] ); }
 
 		NODISCARD ICED_STR op_kind_simple_str ( std::size_t operandIndex ) const noexcept {
 			switch ( op_kind_simple ( operandIndex ) ) {
@@ -273,30 +553,60 @@ namespace iced
 		NODISCARD FORCE_INLINE ICED_STR op2_kind_simple_str ( ) const noexcept { return op_kind_simple_str ( 2 ); }
 		NODISCARD FORCE_INLINE ICED_STR op3_kind_simple_str ( ) const noexcept { return op_kind_simple_str ( 3 ); }
 
-		NODISCARD FORCE_INLINE Register op_reg ( std::size_t index ) const noexcept { return icedInstr.regs [ index ]; }
+		NODISCARD FORCE_INLINE Register op_reg ( std::size_t index ) const noexcept { return instr ( ).regs [ index ]; }
 		NODISCARD FORCE_INLINE Register op0_reg ( ) const noexcept { return op_reg ( 0 ); }
 		NODISCARD FORCE_INLINE Register op1_reg ( ) const noexcept { return op_reg ( 1 ); }
 		NODISCARD FORCE_INLINE Register op2_reg ( ) const noexcept { return op_reg ( 2 ); }
 		NODISCARD FORCE_INLINE Register op3_reg ( ) const noexcept { return op_reg ( 3 ); }
 
-		NODISCARD FORCE_INLINE std::uint64_t immediate ( ) const noexcept { return icedInstr.immediate; }
-		NODISCARD FORCE_INLINE std::uint64_t immediate2 ( ) const noexcept { return icedInstr.immediate2; }
-		NODISCARD FORCE_INLINE std::uint64_t displacement ( ) const noexcept { return icedInstr.mem_disp; }
-		NODISCARD FORCE_INLINE Register mem_index ( ) const noexcept { return icedInstr.mem_index; }
-		NODISCARD FORCE_INLINE Register mem_base ( ) const noexcept { return icedInstr.mem_base; }
-		NODISCARD FORCE_INLINE uint32_t mem_scale ( ) const noexcept { return icedInstr.mem_scale; }
-		NODISCARD FORCE_INLINE Register segment_prefix ( ) const noexcept { return icedInstr.segment_prefix; }
-
-		NODISCARD FORCE_INLINE __iced_internal::IcedInstruction& get_internal ( ) noexcept { return icedInstr; }
-		NODISCARD FORCE_INLINE std::uint8_t op_count ( ) const noexcept { return icedInstr.operand_count_visible; }
-		NODISCARD FORCE_INLINE std::uint8_t length ( ) const noexcept { return icedInstr.length; }
-		NODISCARD FORCE_INLINE bool rep_prefix ( ) const noexcept { return icedInstr.attributes.rep; }
-		NODISCARD FORCE_INLINE bool repne_prefix ( ) const noexcept { return icedInstr.attributes.repne; }
-		NODISCARD FORCE_INLINE bool lock_prefix ( ) const noexcept { return icedInstr.attributes.lock; }
-		NODISCARD FORCE_INLINE bool is_broadcast ( ) const noexcept { return icedInstr.is_broadcast; }
-		NODISCARD FORCE_INLINE Mnemonic mnemonic ( ) const noexcept { return static_cast< Mnemonic >( icedInstr.mnemonic ); }
-		NODISCARD FORCE_INLINE bool valid ( ) const noexcept { return icedInstr.mnemonic != Mnemonic::INVALID; }
-		NODISCARD FORCE_INLINE std::uint8_t stack_growth ( ) const noexcept { return icedInstr.stack_growth; }
+		NODISCARD FORCE_INLINE std::uint64_t immediate ( ) const noexcept { return instr ( ).immediate; }
+		NODISCARD FORCE_INLINE std::uint64_t immediate2 ( ) const noexcept { return instr ( ).immediate2; }
+		NODISCARD FORCE_INLINE std::uint64_t displacement ( ) const noexcept { return instr ( ).mem_disp; }
+		NODISCARD FORCE_INLINE Register mem_index ( ) const noexcept { return instr ( ).mem_index; }
+		NODISCARD FORCE_INLINE Register mem_base ( ) const noexcept { return instr ( ).mem_base; }
+		NODISCARD FORCE_INLINE uint32_t mem_scale ( ) const noexcept { return instr ( ).mem_scale; }
+		NODISCARD FORCE_INLINE Register segment_prefix ( ) const noexcept { return instr ( ).segment_prefix; }
+
+		NODISCARD FORCE_INLINE std::uint8_t op_count ( ) const noexcept { return instr ( ).operand_count_visible; }
+		NODISCARD FORCE_INLINE std::uint8_t length ( ) const noexcept { return instr ( ).length; }
+		NODISCARD FORCE_INLINE bool rep_prefix ( ) const noexcept { return instr ( ).attributes.rep; }
+		NODISCARD FORCE_INLINE bool repne_prefix ( ) const noexcept { return instr ( ).attributes.repne; }
+		NODISCARD FORCE_INLINE bool lock_prefix ( ) const noexcept { return instr ( ).attributes.lock; }
+		NODISCARD FORCE_INLINE bool is_broadcast ( ) const noexcept { return instr ( ).is_broadcast; }
+		/// Opmask register k1-k7, Register::None when unmasked
+		NODISCARD FORCE_INLINE Register op_mask ( ) const noexcept { return instr ( ).op_mask; }
+		NODISCARD FORCE_INLINE bool zeroing_masking ( ) const noexcept { return instr ( ).vector.zeroing; }
+		NODISCARD FORCE_INLINE bool merging_masking ( ) const noexcept { return op_mask ( ) != Register::None && !zeroing_masking ( ); }
+		/// Embedded rounding ({rn-sae} etc.), RoundingControl::None without it
+		NODISCARD FORCE_INLINE RoundingControl rounding_control ( ) const noexcept { return instr ( ).rounding; }
+		NODISCARD FORCE_INLINE bool suppress_all_exceptions ( ) const noexcept { return instr ( ).vector.sae; }
+		/// Gather/scatter memory operand: mem_index ( ) is the xmm/ymm/zmm index, mem_scale ( ) its scale
+		NODISCARD FORCE_INLINE bool is_vsib ( ) const noexcept { return instr ( ).vector.vsib; }
+		/// iced's exact encoding; Code::INVALID with the Zydis backend
+		NODISCARD FORCE_INLINE Code code ( ) const noexcept { return instr ( ).code; }
+		NODISCARD FORCE_INLINE CpuidGroup cpuid_groups ( ) const noexcept { return instr ( ).cpuid_groups; }
+		/// Whether any CPUID feature of the instruction falls in one of `groups`
+		NODISCARD FORCE_INLINE bool uses ( CpuidGroup groups ) const noexcept {
+			return ( static_cast< std::uint8_t >( instr ( ).cpuid_groups ) & static_cast< std::uint8_t >( groups ) ) != 0;
+		}
+		NODISCARD FORCE_INLINE Mnemonic mnemonic ( ) const noexcept { return static_cast< Mnemonic >( instr ( ).mnemonic ); }
+		NODISCARD FORCE_INLINE bool valid ( ) const noexcept { return instr ( ).mnemonic != Mnemonic::INVALID; }
+		NODISCARD FORCE_INLINE std::uint8_t stack_growth ( ) const noexcept { return instr ( ).stack_growth; }
+		/// <summary>
+		///  Signed change of RSP by the instruction itself (iced's stack_pointer_increment):
+		///  negative for push and call, positive for pop and ret. For ret/retf imm16 the record only
+		///  keeps the low byte of the magnitude; the return address part is recovered from it, so
+		///  every operand size (retw, retfd, ...) gets the full 16-bit immediate added back.
+		/// </summary>
+		NODISCARD std::int32_t stack_delta ( ) const noexcept {
+			std::int32_t magnitude = instr ( ).stack_growth;
+			const auto mnemonic = instr ( ).mnemonic;
+			if ( ( mnemonic == Mnemonic::Ret || mnemonic == Mnemonic::Retf ) && op_kind_simple ( 0 ) == OpKindSimple::Immediate ) {
+				const auto immediate = static_cast< std::int32_t >( instr ( ).immediate & 0xFFFF );
+				magnitude = ( ( magnitude - immediate ) & 0xFF ) + immediate;
+			}
+			return instr ( ).attributes.stack_positive ? magnitude : -magnitude;
+		}
 		NODISCARD FORCE_INLINE bool lea ( ) const noexcept { return match_mnemonic ( Mnemonic::Lea ); }
 		NODISCARD FORCE_INLINE bool mov ( ) const noexcept { return match_mnemonic ( Mnemonic::Mov ); }
 		NODISCARD FORCE_INLINE bool bp ( ) const noexcept { return match_mnemonic ( Mnemonic::Int3 ); }
@@ -304,8 +614,9 @@ namespace iced
 		NODISCARD FORCE_INLINE bool call ( ) const noexcept { return match_mnemonic ( Mnemonic::Call ); }
 		NODISCARD FORCE_INLINE bool jmp ( ) const noexcept { return match_mnemonic ( Mnemonic::Jmp ); }
 		NODISCARD FORCE_INLINE bool jcc ( ) const noexcept {
-			const auto& mnemonic = icedInstr.mnemonic;
-			return mnemonic >= Mnemonic::Ja && mnemonic <= Mnemonic::Js;
+			const auto& mnemonic = instr ( ).mnemonic;
+			// Jmp and Jmpe sort between Ja and Js
+			return mnemonic >= Mnemonic::Ja && mnemonic <= Mnemonic::Js && mnemonic != Mnemonic::Jmp && mnemonic != Mnemonic::Jmpe;
 		}
 		NODISCARD FORCE_INLINE bool jump ( ) const noexcept { return jmp ( ) || jcc ( ); }
 		NODISCARD FORCE_INLINE bool branching ( ) const noexcept { return call ( ) || jump ( ); }
@@ -322,7 +633,7 @@ namespace iced
 			return op_kind_simple ( 0 ) == OpKindSimple::Register && op0_reg ( ) == reg;
 		}
 		NODISCARD bool ret ( ) const noexcept {
-			switch ( icedInstr.mnemonic ) {
+			switch ( instr ( ).mnemonic ) {
 				case Mnemonic::Ret:
 				case Mnemonic::Iret:
 				case Mnemonic::Uiret:
@@ -333,28 +644,43 @@ namespace iced
 
 			return false;
 		}
+		/// Whether control never falls through to the next instruction, i.e. it ends a basic block
+		NODISCARD bool ends_block ( ) const noexcept {
+			switch ( flow_control ( ) ) {
+				case FlowControl::ConditionalBranch:
+				case FlowControl::UnconditionalBranch:
+				case FlowControl::IndirectBranch:
+				case FlowControl::Return:
+				case FlowControl::Exception:
+					return true;
+				case FlowControl::Interrupt:
+					return bp ( );
+				default:
+					return false;
+			}
+		}
 
 		NODISCARD FORCE_INLINE std::uint64_t compute_memory_address ( ) const noexcept {
-			if ( icedInstr.mem_base == Register::RIP ) {
-				return ip + length ( ) + icedInstr.mem_disp;
+			if ( instr ( ).mem_base == Register::RIP ) {
+				return address ( ) + length ( ) + instr ( ).mem_disp;
 			}
 
-			if ( icedInstr.mem_base == Register::None || icedInstr.mem_index == Register::None ) { // Displacement holds absolute address
-				return icedInstr.mem_disp;
+			if ( instr ( ).mem_base == Register::None || instr ( ).mem_index == Register::None ) { // Displacement holds absolute address
+				return instr ( ).mem_disp;
 			}
 
-			return icedInstr.immediate;
+			return instr ( ).immediate;
 		}
 		NODISCARD FORCE_INLINE std::uint64_t resolve_memory ( ) const noexcept { return compute_memory_address ( ); }
 		NODISCARD std::uint64_t branch_target ( ) const noexcept {
 			switch ( op_kind_simple ( 0 ) ) {
 				case OpKindSimple::Immediate:
-					return icedInstr.immediate2 ? icedInstr.immediate2 : icedInstr.immediate;
+					return instr ( ).immediate2 ? instr ( ).immediate2 : instr ( ).immediate;
 				case OpKindSimple::Memory:
 					return resolve_memory ( );
 				case OpKindSimple::NearBranch:
 				case OpKindSimple::FarBranch:
-					return ip + length ( ) + icedInstr.mem_disp;
+					return address ( ) + length ( ) + instr ( ).mem_disp;
 				default:
 					return 0ULL;
 			}
@@ -362,6 +688,23 @@ namespace iced
 			UNREACHABLE ( );
 		}
 
+	protected:
+		NODISCARD FORCE_INLINE const auto& instr ( ) const noexcept { return static_cast< const Derived& >( *this ).record ( ); }
+		NODISCARD FORCE_INLINE std::uint64_t address ( ) const noexcept { return static_cast< const Derived& >( *this ).ip; }
+		NODISCARD FORCE_INLINE bool match_mnemonic ( Mnemonic mnemonic ) const noexcept { return instr ( ).mnemonic == mnemonic; }
+	};
+
+	class Instruction : public InstructionAccessors<Instruction> {
+	public:
+		Instruction ( ) = default;
+		Instruction ( const __iced_internal::IcedInstruction& instruction, std::uint64_t ip_ ) : ip ( ip_ ), icedInstr ( instruction ) { }
+		Instruction ( const __iced_internal::IcedInstructionRecord& record, std::uint64_t ip_ ) : ip ( ip_ ), icedInstr ( ) {
+			std::memcpy ( &icedInstr, &record, offsetof ( __iced_internal::IcedInstruction, text ) );
+		}
+
+		NODISCARD FORCE_INLINE const __iced_internal::IcedInstruction& record ( ) const noexcept { return icedInstr; }
+		NODISCARD FORCE_INLINE __iced_internal::IcedInstruction& get_internal ( ) noexcept { return icedInstr; }
+
 		NODISCARD FORCE_INLINE ICED_STR to_string ( ) const noexcept {
 			if ( !valid ( ) ) {
 				return "Invalid instruction";
@@ -371,10 +714,39 @@ namespace iced
 		}
 		std::uint64_t ip;
 	private:
-		NODISCARD FORCE_INLINE bool match_mnemonic ( Mnemonic mnemonic ) const noexcept { return icedInstr.mnemonic == mnemonic; }
 		__iced_internal::IcedInstruction icedInstr;
 	};
 
+	static_assert( std::is_trivially_copyable<Instruction>::value, "Instruction must stay trivially copyable" );
+
+	/// <summary>
+	///  Instruction without the formatted text: the 48-byte record plus its address.
+	///  Trivially copyable with a fixed layout, so vectors grow with memcpy and arrays of
+	///  it can live in arenas or mapped files as-is. Same accessors as Instruction.
+	/// </summary>
+	class CompactInstruction : public InstructionAccessors<CompactInstruction> {
+	public:
+		CompactInstruction ( ) = default;
+		CompactInstruction ( const __iced_internal::IcedInstructionRecord& record, std::uint64_t ip_ ) noexcept : ip ( ip_ ), record_ ( record ) { }
+		explicit CompactInstruction ( const Instruction& instruction ) noexcept : ip ( instruction.ip ) {
+			std::memcpy ( &record_, &instruction.record ( ), sizeof ( record_ ) );
+		}
+
+		NODISCARD FORCE_INLINE const __iced_internal::IcedInstructionRecord& record ( ) const noexcept { return record_; }
+		NODISCARD FORCE_INLINE __iced_internal::IcedInstructionRecord& get_internal ( ) noexcept { return record_; }
+
+		/// Expands back into a full Instruction (without text)
+		NODISCARD FORCE_INLINE Instruction to_instruction ( ) const noexcept { return Instruction ( record_, ip ); }
+
+		std::uint64_t ip;
+	private:
+		__iced_internal::IcedInstructionRecord record_;
+	};
+
+	static_assert( std::is_trivially_copyable<CompactInstruction>::value, "CompactInstruction must stay trivially copyable" );
+	static_assert( std::is_trivially_destructible<CompactInstruction>::value, "CompactInstruction must stay trivially destructible" );
+	static_assert( sizeof ( CompactInstruction ) == 56, "invalid size" );
+
 	class DecoderBase {
 	public:
 		DecoderBase ( ) = delete;
@@ -424,6 +796,72 @@ namespace iced
 		NODISCARD FORCE_INLINE std::uint16_t last_successful_length ( ) const noexcept { return lastSuccessfulLength_; }
 		NODISCARD FORCE_INLINE std::size_t remaining_size ( ) const noexcept { return size_ - offset_; }
 
+		/// Longest possible x86 instruction
+		static constexpr std::size_t maxInstructionLength = 15;
+
+		/// <summary>
+		///  True while a whole maximum-length instruction fits in the remaining bytes. Loops can
+		///  then call decode_unchecked ( ), which hands the backend a constant window without
+		///  clamping, and only fall back to decode ( ) for the last few bytes.
+		/// </summary>
+		NODISCARD FORCE_INLINE bool can_decode_fast ( ) const noexcept { return size_ - offset_ >= maxInstructionLength; }
+
+		/// <summary>
+		///  Gather decode: decodes the instruction at each of `count` addresses with a single
+		///  backend call. Addresses outside the buffer yield an invalid record of length 0.
+		///  The decoder position is not changed.
+		/// </summary>
+		/// <returns>Number of addresses inside the buffer</returns>
+		std::size_t gather ( const std::uint64_t* ips, std::size_t count, __iced_internal::IcedInstructionRecord* out ) const noexcept {
+			if ( !count ) {
+				return 0;
+			}
+
+			const auto decoded = disas_gather ( out, data_, size_, baseAddr_, ips, count );
+			if ( decoded < 0 ) {
+				std::memset ( out, 0, count * sizeof ( *out ) );
+				return 0;
+			}
+			return static_cast< std::size_t >( decoded );
+		}
+
+		/// Same as above, into full instructions (without text)
+		std::size_t gather ( const std::uint64_t* ips, std::size_t count, Instruction* out ) const noexcept {
+			return gather_batched ( ips, count, out );
+		}
+
+		std::size_t gather ( const std::uint64_t* ips, std::size_t count, CompactInstruction* out ) const noexcept {
+			return gather_batched ( ips, count, out );
+		}
+
+		std::size_t gather ( const std::vector<std::uint64_t>& ips, std::vector<Instruction>& out ) const {
+			out.resize ( ips.size ( ) );
+			return gather ( ips.data ( ), ips.size ( ), out.data ( ) );
+		}
+
+		/// <summary>
+		///  Sweeps the whole buffer inside the backend and collects the address of every instruction
+		///  that uses one of `groups`, e.g. CpuidGroup::Avx512 | CpuidGroup::Amx. Records never cross
+		///  the FFI boundary; the decoder position is not changed.
+		/// </summary>
+		std::vector<std::uint64_t> find_cpuid ( CpuidGroup groups ) const {
+			constexpr std::size_t batchSize = 4096;
+
+			std::vector<std::uint64_t> ips;
+			std::size_t next = 0;
+			while ( next < size_ ) {
+				const auto first = ips.size ( );
+				ips.resize ( first + batchSize );
+				const auto found = disas_find_cpuid ( ips.data ( ) + first, batchSize, data_, size_, baseAddr_, next,
+													  static_cast< std::uint8_t >( groups ), &next );
+				ips.resize ( first + ( found < 0 ? 0 : static_cast< std::size_t >( found ) ) );
+				if ( found < 0 ) {
+					break;
+				}
+			}
+			return ips;
+		}
+
 		bool set_ip ( std::uint64_t ip ) noexcept {
 			if ( ip < baseAddr_ || ip >= baseAddr_ + size_ ) {
 				return false;
@@ -466,6 +904,50 @@ namespace iced
 		}
 
 	protected:
+		/// Steady state: constant-size window, no clamping
+		template<typename Disas>
+		FORCE_INLINE Instruction& decode_fast ( Disas disasm ) noexcept {
+			assert ( can_decode_fast ( ) && "decode_unchecked requires 15 remaining bytes" );
+
+			__iced_internal::IcedInstruction icedInstruction {};
+			disasm ( &icedInstruction, data_ + offset_, maxInstructionLength );
+			update_state ( icedInstruction );
+			return currentInstruction_;
+		}
+
+		/// Last bytes of the buffer: the backend sees exactly what is left and never reads past it
+		template<typename Disas>
+		Instruction& decode_tail ( Disas disasm ) noexcept {
+			__iced_internal::IcedInstruction icedInstruction {};
+			disasm ( &icedInstruction, data_ + offset_, remaining_size ( ) );
+			update_state ( icedInstruction );
+			return currentInstruction_;
+		}
+
+		template<typename Disas>
+		NODISCARD Instruction peek_with ( Disas disasm ) const noexcept {
+			__iced_internal::IcedInstruction icedInstruction {};
+			disasm ( &icedInstruction, data_ + offset_, std::min ( maxInstructionLength, remaining_size ( ) ) );
+			return Instruction ( icedInstruction, ip ( ) );
+		}
+
+		/// Gathers through a small record buffer and converts into `Output` ( record, ip )
+		template<typename Output>
+		std::size_t gather_batched ( const std::uint64_t* ips, std::size_t count, Output* out ) const noexcept {
+			constexpr std::size_t batchSize = 256;
+			__iced_internal::IcedInstructionRecord records [ batchSize ];
+
+			std::size_t decoded = 0;
+			for ( std::size_t first = 0; first < count; first += batchSize ) {
+				const auto batch = std::min ( batchSize, count - first );
+				decoded += gather ( ips + first, batch, records );
+				for ( std::size_t index = 0; index < batch; ++index ) {
+					out [ first + index ] = Output ( records [ index ], ips [ first + index ] );
+				}
+			}
+			return decoded;
+		}
+
 		FORCE_INLINE void update_state ( const __iced_internal::IcedInstruction& icedInstruction ) noexcept {
 			const auto len = icedInstruction.length;
 			currentInstruction_ = Instruction { icedInstruction, ip_ };
@@ -499,54 +981,36 @@ namespace iced
 			disasmFunction_ ( debug ? disas2 : disas ) { }
 
 		NODISCARD Instruction& decode ( ) noexcept {
-			const auto* current_ptr = data_ + offset_;
-			const auto code_size = remaining_size ( );
-
-			__iced_internal::IcedInstruction icedInstruction {};
-
-			constexpr auto decode_size = 16ULL;
-			disasmFunction_ ( &icedInstruction, current_ptr, decode_size );
-
-			update_state ( icedInstruction );
-			return currentInstruction_;
+			return can_decode_fast ( ) ? decode_unchecked ( ) : decode_tail ( disasmFunction_ );
 		}
 
+		/// Fast path, requires can_decode_fast ( )
+		NODISCARD Instruction& decode_unchecked ( ) noexcept { return decode_fast ( disasmFunction_ ); }
+
 		void set_debug_mode ( bool debug ) noexcept {
 			disasmFunction_ = debug ? disas2 : disas;
 		}
 	};
 
-	class DebugDecoder : public DecoderBase {
+	template<typename Syntax = syntax::Fast>
+	class BasicDebugDecoder : public DecoderBase {
 	public:
-		explicit DebugDecoder ( const std::uint8_t* buffer = nullptr, std::size_t size = 15ULL,
-							 std::uint64_t baseAddress = 0ULL )
+		explicit BasicDebugDecoder ( const std::uint8_t* buffer = nullptr, std::size_t size = 15ULL,
+									 std::uint64_t baseAddress = 0ULL )
 			: DecoderBase ( buffer, size, baseAddress ) { }
 
 		NODISCARD Instruction& decode ( ) noexcept {
-			const auto* current_ptr = data_ + offset_;
-			const auto code_size = remaining_size ( );
-
-			__iced_internal::IcedInstruction icedInstruction {};
-			const auto decode_size = std::min ( static_cast< std::size_t >( 16 ), code_size );
-			disas2 ( &icedInstruction, current_ptr, decode_size );
-
-			update_state ( icedInstruction );
-			return currentInstruction_;
+			return can_decode_fast ( ) ? decode_unchecked ( ) : decode_tail ( Syntax::decode );
 		}
 
-		NODISCARD Instruction peek ( ) noexcept {
-			const auto* current_ptr = data_ + offset_;
-			const auto code_size = remaining_size ( );
+		/// Fast path, requires can_decode_fast ( )
+		NODISCARD Instruction& decode_unchecked ( ) noexcept { return decode_fast ( Syntax::decode ); }
 
-			__iced_internal::IcedInstruction icedInstruction {};
-			const auto decode_size = std::min ( static_cast< std::size_t >( 16 ), code_size );
-			disas2 ( &icedInstruction, current_ptr, decode_size );
-
-			//updateState ( icedInstruction );
-			return Instruction ( icedInstruction, ip ( ) );
-		}
+		NODISCARD Instruction peek ( ) noexcept { return peek_with ( Syntax::decode ); }
 	};
 
+	using DebugDecoder = BasicDebugDecoder<>;
+
 	class ReleaseDecoder : public DecoderBase {
 	public:
 		explicit ReleaseDecoder ( const std::uint8_t* buffer = nullptr, std::size_t size = 15ULL,
@@ -554,34 +1018,194 @@ namespace iced
 			: DecoderBase ( buffer, size, baseAddress ) { }
 
 		NODISCARD Instruction& decode ( ) noexcept {
-			const auto* current_ptr = data_ + offset_;
-			const auto code_size = remaining_size ( );
+			return can_decode_fast ( ) ? decode_unchecked ( ) : decode_tail ( disas );
+		}
 
-			__iced_internal::IcedInstruction icedInstruction {};
-			const auto decode_size = std::min ( static_cast< std::size_t >( 16 ), code_size );
-			disas ( &icedInstruction, current_ptr, decode_size );
+		/// Fast path, requires can_decode_fast ( )
+		NODISCARD Instruction& decode_unchecked ( ) noexcept { return decode_fast ( disas ); }
 
-			update_state ( icedInstruction );
-			return currentInstruction_;
+		NODISCARD Instruction peek ( ) noexcept { return peek_with ( disas ); }
+	};
+
+	/// Location of one formatted instruction inside a TextArena
+	struct TextSpan {
+		std::uint64_t offset;
+		std::uint32_t length;
+		std::uint32_t reserved;
+	};
+	static_assert( sizeof ( TextSpan ) == 16, "invalid size" );
+
+	/// <summary>
+	///  Caller-owned text buffer. Formatted instructions are appended back to back,
+	///  without terminators or padding, and addressed through TextSpans.
+	/// </summary>
+	class TextArena {
+	public:
+		TextArena ( ) = default;
+		explicit TextArena ( std::size_t capacity ) { reserve ( capacity ); }
+
+		TextArena ( const TextArena& ) = delete;
+		TextArena& operator=( const TextArena& ) = delete;
+		TextArena ( TextArena&& ) noexcept = default;
+		TextArena& operator=( TextArena&& ) noexcept = default;
+
+		NODISCARD FORCE_INLINE std::string_view view ( const TextSpan& span ) const noexcept {
+			return std::string_view ( data_.get ( ) + span.offset, span.length );
 		}
+		NODISCARD FORCE_INLINE const char* data ( ) const noexcept { return data_.get ( ); }
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return used_; }
+		NODISCARD FORCE_INLINE std::size_t capacity ( ) const noexcept { return capacity_; }
 
-		NODISCARD Instruction peek ( ) noexcept {
-			const auto* current_ptr = data_ + offset_;
-			const auto code_size = remaining_size ( );
+		/// Drops all text but keeps the allocation for the next batch
+		void clear ( ) noexcept { used_ = 0; }
 
-			__iced_internal::IcedInstruction icedInstruction {};
-			const auto decode_size = std::min ( static_cast< std::size_t >( 16 ), code_size );
-			disas ( &icedInstruction, current_ptr, decode_size );
+		void reserve ( std::size_t capacity ) {
+			if ( capacity <= capacity_ ) {
+				return;
+			}
 
-			//updateState ( icedInstruction );
-			return Instruction ( icedInstruction, ip ( ) );
+			auto grown = std::make_unique<char [ ]> ( capacity );
+			if ( used_ ) {
+				std::memcpy ( grown.get ( ), data_.get ( ), used_ );
+			}
+			data_ = std::move ( grown );
+			capacity_ = capacity;
 		}
+
+	private:
+		template<typename Syntax>
+		friend class BasicBatchFormatter;
+
+		std::unique_ptr<char [ ]> data_;
+		std::size_t capacity_ = 0;
+		std::size_t used_ = 0;
 	};
 
-	template<bool Debug = true>
+	/// <summary>
+	///  Formats many instructions of one code buffer in a single call, writing
+	///  untruncated text into a TextArena instead of a fixed array per instruction.
+	/// </summary>
+	template<typename Syntax = syntax::Fast>
+	class BasicBatchFormatter {
+	public:
+		BasicBatchFormatter ( ) = delete;
+		BasicBatchFormatter ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress )
+			: data_ ( buffer ), baseAddr_ ( baseAddress ), size_ ( size ), resolver_ ( nullptr ), resolverContext_ ( nullptr ) { }
+
+		/// <summary>
+		///  Names branch targets, RIP-relative operands and addresses through `resolver`,
+		///  e.g. `call kernel32!CreateFileW` or `[g_config+0x10]`. Pass nullptr to disable.
+		/// </summary>
+		/// <param name="context">passed back to every resolver call, e.g. a SymbolTable</param>
+		void set_symbol_resolver ( __iced_internal::IcedSymbolCallback resolver, const void* context ) noexcept {
+			resolver_ = resolver;
+			resolverContext_ = const_cast< void* >( context );
+		}
+
+		/// <summary>
+		///  Formats into a fixed caller buffer, stopping at the first instruction that does not fit
+		/// </summary>
+		/// <param name="used">bytes of arena already in use, advanced past the appended text</param>
+		/// <returns>Number of instructions formatted</returns>
+		std::size_t format ( const Instruction* instructions, std::size_t count, char* arena, std::size_t capacity,
+							 std::size_t& used, TextSpan* spans ) const noexcept {
+			if ( !count || !size_ ) {
+				return 0;
+			}
+
+			const auto result = format_chunk ( spans, arena, capacity, used, reinterpret_cast< const std::uint8_t* >( &instructions->ip ),
+											   sizeof ( Instruction ), count );
+			return result < 0 ? 0 : static_cast< std::size_t >( result );
+		}
+
+		/// Formats `count` instructions, growing the arena as needed; spans[i] describes instructions[i]
+		std::size_t format ( const Instruction* instructions, std::size_t count, TextArena& arena, TextSpan* spans ) const {
+			return count ? format_strided ( reinterpret_cast< const std::uint8_t* >( &instructions->ip ), sizeof ( Instruction ), count, arena, spans ) : 0;
+		}
+
+		std::size_t format ( const std::vector<Instruction>& instructions, TextArena& arena, std::vector<TextSpan>& spans ) const {
+			const auto first = spans.size ( );
+			spans.resize ( first + instructions.size ( ) );
+			return format ( instructions.data ( ), instructions.size ( ), arena, spans.data ( ) + first );
+		}
+
+		std::size_t format ( const CompactInstruction* instructions, std::size_t count, TextArena& arena, TextSpan* spans ) const {
+			return count ? format_strided ( reinterpret_cast< const std::uint8_t* >( &instructions->ip ), sizeof ( CompactInstruction ), count, arena, spans ) : 0;
+		}
+
+		/// Formats the instructions starting at each address in `ips`
+		std::size_t format ( const std::uint64_t* ips, std::size_t count, TextArena& arena, TextSpan* spans ) const {
+			return format_strided ( reinterpret_cast< const std::uint8_t* >( ips ), sizeof ( std::uint64_t ), count, arena, spans );
+		}
+
+		/// <summary>
+		///  Linear sweep over the whole buffer, appending one span and one address per instruction
+		/// </summary>
+		/// <returns>Number of instructions formatted</returns>
+		std::size_t format_listing ( TextArena& arena, std::vector<TextSpan>& spans, std::vector<std::uint64_t>& ips ) const {
+			const auto first = ips.size ( );
+			ReleaseDecoder decoder ( data_, size_, baseAddr_ );
+			while ( decoder.can_decode ( ) ) {
+				ips.push_back ( decoder.ip ( ) );
+				( void )decoder.decode ( );
+			}
+
+			const auto count = ips.size ( ) - first;
+			spans.resize ( first + count );
+			return format ( ips.data ( ) + first, count, arena, spans.data ( ) + first );
+		}
+
+	private:
+		static constexpr std::size_t averageTextLength = 32;
+		static constexpr std::size_t maxTextLength = 256;
+
+		FORCE_INLINE std::ptrdiff_t format_chunk ( TextSpan* spans, char* arena, std::size_t capacity, std::size_t& used,
+												   const std::uint8_t* ips, std::size_t stride, std::size_t count ) const noexcept {
+			if ( resolver_ ) {
+				return Syntax::format_symbols ( spans, arena, capacity, &used, data_, size_, baseAddr_, ips, stride, count,
+												resolver_, resolverContext_ );
+			}
+
+			return Syntax::format ( spans, arena, capacity, &used, data_, size_, baseAddr_, ips, stride, count );
+		}
+
+		std::size_t format_strided ( const std::uint8_t* ips, std::size_t stride, std::size_t count, TextArena& arena, TextSpan* spans ) const {
+			if ( !count || !size_ ) {
+				return 0;
+			}
+
+			arena.reserve ( arena.used_ + count * averageTextLength );
+
+			std::size_t done = 0;
+			while ( done < count ) {
+				const auto result = format_chunk ( spans + done, arena.data_.get ( ), arena.capacity_, arena.used_,
+												   ips + done * stride, stride, count - done );
+				if ( result < 0 ) {
+					break;
+				}
+
+				done += static_cast< std::size_t >( result );
+				if ( done < count ) {
+					arena.reserve ( std::max ( arena.capacity_ * 2, arena.used_ + maxTextLength ) );
+				}
+			}
+
+			return done;
+		}
+
+		const std::uint8_t* data_;
+		std::uint64_t baseAddr_;
+		std::size_t size_;
+		__iced_internal::IcedSymbolCallback resolver_;
+		void* resolverContext_;
+	};
+
+	using BatchFormatter = BasicBatchFormatter<>;
+
+	template<bool Debug = true, typename Syntax = syntax::Fast>
 	NODISCARD auto make_decoder ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress = 0ULL ) {
 		if constexpr ( Debug ) {
-			return DebugDecoder ( buffer, size, baseAddress );
+			return BasicDebugDecoder<Syntax> ( buffer, size, baseAddress );
 		}
 		else {
 			return ReleaseDecoder ( buffer, size, baseAddress );
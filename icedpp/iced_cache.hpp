@@ -0,0 +1,254 @@
+#pragma once
+#ifndef __ICED_CACHE_DEF
+#define __ICED_CACHE_DEF
+
+#include "iced.hpp"
+#include "iced_hash.hpp"
+#include "iced_io.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace iced
+{
+	/// <summary>
+	///  Instruction view over a record stored elsewhere, e.g. inside a mapped DecodedCache.
+	///  Offers the same accessors as Instruction without copying the record.
+	/// </summary>
+	class CachedInstruction : public InstructionAccessors<CachedInstruction> {
+	public:
+		CachedInstruction ( const __iced_internal::IcedInstructionRecord& record, std::uint64_t ip_ ) : ip ( ip_ ), record_ ( &record ) { }
+
+		NODISCARD FORCE_INLINE const __iced_internal::IcedInstructionRecord& record ( ) const noexcept { return *record_; }
+		std::uint64_t ip;
+	private:
+		const __iced_internal::IcedInstructionRecord* record_;
+	};
+
+	/// On-disk layout: header, `count` records, then `count` 32-bit offsets from baseAddress
+	struct DecodedCacheHeader {
+		std::uint64_t magic;
+		std::uint32_t version;
+		std::uint32_t recordSize;
+		std::uint64_t contentHash;
+		std::uint64_t baseAddress;
+		std::uint64_t codeSize;
+		std::uint64_t count;
+		std::uint64_t recordsOffset;
+		std::uint64_t offsetsOffset;
+	};
+	static_assert( sizeof ( DecodedCacheHeader ) == 64, "invalid size" );
+
+	/// <summary>
+	///  Persistent linear sweep of a code buffer. write ( ) decodes once and stores the
+	///  records; open ( ) maps them back so later runs only pay for the pages they touch.
+	/// </summary>
+	class DecodedCache {
+	public:
+		static constexpr std::uint64_t fileMagic = 0x4843414344454349ULL; // "ICEDCACH"
+		static constexpr std::uint32_t fileVersion = 3;
+
+		DecodedCache ( ) = default;
+
+		/// <summary>
+		///  Decodes `code` from start to end and writes the sweep to `path`
+		/// </summary>
+		/// <returns>
+		///  false if the file could not be written, the code exceeds 4GB or the backend failed to decode
+		///  at some offset, in which case no partial sweep is left behind
+		/// </returns>
+		static bool write ( const char* path, const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress ) {
+			if ( !code || !size || size > 0xFFFFFFFFULL ) {
+				return false;
+			}
+
+			const auto temporary = std::string ( path ) + ".tmp";
+			auto* file = std::fopen ( temporary.c_str ( ), "wb" );
+			if ( !file ) {
+				return false;
+			}
+			std::setvbuf ( file, nullptr, _IOFBF, 1 << 20 );
+
+			DecodedCacheHeader header {};
+			header.magic = fileMagic;
+			header.version = fileVersion;
+			header.recordSize = sizeof ( __iced_internal::IcedInstructionRecord );
+			header.contentHash = hash::bytes ( code, size );
+			header.baseAddress = baseAddress;
+			header.codeSize = size;
+			header.recordsOffset = sizeof ( DecodedCacheHeader );
+
+			bool ok = std::fwrite ( &header, sizeof ( header ), 1, file ) == 1;
+
+			std::vector<std::uint32_t> offsets;
+			offsets.reserve ( size / 4 );
+
+			constexpr std::size_t chunkSize = 4096;
+			std::vector<__iced_internal::IcedInstructionRecord> chunk ( chunkSize );
+			std::size_t pending = 0;
+			std::size_t offset = 0;
+			while ( ok && offset < size ) {
+				auto& record = chunk [ pending ];
+				record = {};
+				disas ( &record, code + offset, std::min ( DecoderBase::maxInstructionLength, size - offset ) );
+				if ( !record.length ) {
+					// A backend error, not invalid bytes (those still have a length); the sweep would be incomplete
+					ok = false;
+					break;
+				}
+
+				offsets.push_back ( static_cast< std::uint32_t >( offset ) );
+				offset += record.length;
+				if ( ++pending == chunkSize ) {
+					ok = std::fwrite ( chunk.data ( ), sizeof ( record ), pending, file ) == pending;
+					pending = 0;
+				}
+			}
+
+			if ( ok && pending ) {
+				ok = std::fwrite ( chunk.data ( ), sizeof ( chunk [ 0 ] ), pending, file ) == pending;
+			}
+
+			header.count = offsets.size ( );
+			header.offsetsOffset = header.recordsOffset + header.count * header.recordSize;
+			if ( ok && !offsets.empty ( ) ) {
+				ok = std::fwrite ( offsets.data ( ), sizeof ( std::uint32_t ), offsets.size ( ), file ) == offsets.size ( );
+			}
+
+			// The header goes in last so a truncated file never validates
+			ok = ok && std::fseek ( file, 0, SEEK_SET ) == 0 && std::fwrite ( &header, sizeof ( header ), 1, file ) == 1;
+			ok = std::fclose ( file ) == 0 && ok;
+			if ( !ok ) {
+				std::remove ( temporary.c_str ( ) );
+				return false;
+			}
+
+			std::remove ( path );
+			return std::rename ( temporary.c_str ( ), path ) == 0;
+		}
+
+		/// <summary>
+		///  Maps a cache file and validates its layout
+		/// </summary>
+		bool open ( const char* path ) {
+			close ( );
+			if ( !file_.open ( path ) || file_.size ( ) < sizeof ( DecodedCacheHeader ) ) {
+				file_.close ( );
+				return false;
+			}
+
+			const auto* header = reinterpret_cast< const DecodedCacheHeader* >( file_.data ( ) );
+			if ( header->magic != fileMagic || header->version != fileVersion ||
+				 header->recordSize != sizeof ( __iced_internal::IcedInstructionRecord ) || !valid_layout ( *header, file_.size ( ) ) ) {
+				file_.close ( );
+				return false;
+			}
+
+			header_ = header;
+			records_ = reinterpret_cast< const __iced_internal::IcedInstructionRecord* >( file_.data ( ) + header->recordsOffset );
+			offsets_ = reinterpret_cast< const std::uint32_t* >( file_.data ( ) + header->offsetsOffset );
+			return true;
+		}
+
+		/// Same as open ( path ), but also rejects caches written for other content
+		bool open ( const char* path, std::uint64_t contentHash ) {
+			if ( !open ( path ) ) {
+				return false;
+			}
+
+			if ( header_->contentHash != contentHash ) {
+				close ( );
+				return false;
+			}
+			return true;
+		}
+
+		/// <summary>
+		///  Opens `directory`/<content hash>.icache, building it first if it is missing or stale
+		/// </summary>
+		bool load_or_build ( const std::string& directory, const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress ) {
+			const auto contentHash = hash::bytes ( code, size );
+			const auto path = path_for ( directory, contentHash );
+			if ( open ( path.c_str ( ), contentHash ) && header_->codeSize == size && header_->baseAddress == baseAddress ) {
+				return true;
+			}
+
+			return write ( path.c_str ( ), code, size, baseAddress ) && open ( path.c_str ( ), contentHash );
+		}
+
+		NODISCARD static std::string path_for ( const std::string& directory, std::uint64_t contentHash ) {
+			char name [ 32 ];
+			std::snprintf ( name, sizeof ( name ), "%016llx.icache", static_cast< unsigned long long >( contentHash ) );
+			if ( directory.empty ( ) ) {
+				return name;
+			}
+
+			const auto last = directory.back ( );
+			return directory + ( last == '/' || last == '\\' ? "" : "/" ) + name;
+		}
+
+		void close ( ) noexcept {
+			file_.close ( );
+			header_ = nullptr;
+			records_ = nullptr;
+			offsets_ = nullptr;
+		}
+
+		NODISCARD FORCE_INLINE bool is_open ( ) const noexcept { return header_ != nullptr; }
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return header_ ? static_cast< std::size_t >( header_->count ) : 0; }
+		NODISCARD FORCE_INLINE std::uint64_t base_address ( ) const noexcept { return header_->baseAddress; }
+		NODISCARD FORCE_INLINE std::uint64_t code_size ( ) const noexcept { return header_->codeSize; }
+		NODISCARD FORCE_INLINE std::uint64_t content_hash ( ) const noexcept { return header_->contentHash; }
+		NODISCARD FORCE_INLINE const __iced_internal::IcedInstructionRecord* records ( ) const noexcept { return records_; }
+		NODISCARD FORCE_INLINE const std::uint32_t* offsets ( ) const noexcept { return offsets_; }
+
+		NODISCARD FORCE_INLINE std::uint64_t ip ( std::size_t index ) const noexcept { return header_->baseAddress + offsets_ [ index ]; }
+		NODISCARD FORCE_INLINE CachedInstruction operator[]( std::size_t index ) const noexcept {
+			return CachedInstruction ( records_ [ index ], ip ( index ) );
+		}
+
+		/// <summary>
+		///  Binary search over the IP index
+		/// </summary>
+		/// <returns>Index of the instruction starting at `ip`, or size() if none does</returns>
+		NODISCARD std::size_t find ( std::uint64_t ip ) const noexcept {
+			const auto count = size ( );
+			if ( !count || ip < header_->baseAddress || ip - header_->baseAddress > 0xFFFFFFFFULL ) {
+				return count;
+			}
+
+			const auto offset = static_cast< std::uint32_t >( ip - header_->baseAddress );
+			const auto* it = std::lower_bound ( offsets_, offsets_ + count, offset );
+			if ( it == offsets_ + count || *it != offset ) {
+				return count;
+			}
+
+			return static_cast< std::size_t >( it - offsets_ );
+		}
+
+	private:
+		/// <summary>
+		///  Whether the records and offsets the header describes lie inside the file, in order and
+		///  aligned. The fields come from the file, so every bound is checked without overflowing.
+		/// </summary>
+		NODISCARD static bool valid_layout ( const DecodedCacheHeader& header, std::uint64_t fileSize ) noexcept {
+			constexpr std::uint64_t recordSize = sizeof ( __iced_internal::IcedInstructionRecord );
+			if ( header.recordsOffset < sizeof ( DecodedCacheHeader ) || header.recordsOffset > fileSize ||
+				 header.recordsOffset % alignof( __iced_internal::IcedInstructionRecord ) ||
+				 header.count > ( fileSize - header.recordsOffset ) / recordSize ) {
+				return false;
+			}
+
+			const auto recordsEnd = header.recordsOffset + header.count * recordSize;
+			return header.offsetsOffset >= recordsEnd && header.offsetsOffset <= fileSize &&
+				!( header.offsetsOffset % alignof( std::uint32_t ) ) &&
+				header.count <= ( fileSize - header.offsetsOffset ) / sizeof ( std::uint32_t );
+		}
+
+		MappedFile file_;
+		const DecodedCacheHeader* header_ = nullptr;
+		const __iced_internal::IcedInstructionRecord* records_ = nullptr;
+		const std::uint32_t* offsets_ = nullptr;
+	};
+};
+#endif
@@ -0,0 +1,401 @@
+#pragma once
+#ifndef __ICED_CFG_DEF
+#define __ICED_CFG_DEF
+
+#include "iced.hpp"
+#include "iced_image.hpp"
+
+#include <climits>
+#include <unordered_set>
+
+namespace iced
+{
+	/// Straight-line run of instructions [begin, end) with a single entry
+	struct BasicBlock {
+		std::uint64_t begin;
+		std::uint64_t end;
+		std::uint32_t firstInstruction; // index into ControlFlowGraph::instructions ( )
+		std::uint32_t instructionCount;
+		std::uint32_t firstSuccessor;   // index into the successor table, see successors ( )
+		std::uint32_t successorCount;
+	};
+
+	/// <summary>
+	///  Control flow graph of one function, recovered by recursive descent from its entry:
+	///  direct jumps and conditional branches are followed, calls fall through, and returns,
+	///  indirect jumps, int3 and invalid bytes end a path. Instructions are kept sorted by
+	///  address in one array and blocks index into it, so overlapping instruction streams
+	///  (jumps into the middle of an instruction) simply become separate blocks.
+	/// </summary>
+	class ControlFlowGraph {
+	public:
+		ControlFlowGraph ( ) = default;
+		ControlFlowGraph ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, std::uint64_t entry,
+						   const Function& bounds = { 0, ~0ULL } ) {
+			build ( code, size, baseAddress, entry, bounds );
+		}
+
+		/// <summary>
+		///  Recovers the function at `entry`. Branch targets outside `bounds` (tail calls into
+		///  other functions, e.g. a FunctionTable entry) or outside the buffer are not followed.
+		/// </summary>
+		void build ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, std::uint64_t entry,
+					 const Function& bounds = { 0, ~0ULL } ) {
+			clear ( );
+			entry_ = entry;
+			if ( !code || !size ) {
+				return;
+			}
+
+			const auto inside = [ & ] ( std::uint64_t ip ) {
+				return ip >= baseAddress && ip - baseAddress < size && ip >= bounds.begin && ip < bounds.end;
+			};
+
+			std::vector<std::uint64_t> leaders;
+			std::vector<std::uint64_t> pending;
+			std::unordered_set<std::uint64_t> visited;
+			const auto enqueue = [ & ] ( std::uint64_t ip ) {
+				if ( inside ( ip ) ) {
+					leaders.push_back ( ip );
+					pending.push_back ( ip );
+				}
+			};
+
+			ReleaseDecoder decoder ( code, size, baseAddress );
+			enqueue ( entry );
+			while ( !pending.empty ( ) ) {
+				auto ip = pending.back ( );
+				pending.pop_back ( );
+
+				while ( inside ( ip ) ) {
+					// Reached from a second path: whatever block holds it has to start here
+					if ( !visited.insert ( ip ).second ) {
+						leaders.push_back ( ip );
+						break;
+					}
+
+					decoder.set_ip ( ip );
+					const CompactInstruction instruction ( decoder.decode ( ) );
+					instructions_.push_back ( instruction );
+
+					const auto flow = branch_flow ( instruction );
+					if ( flow == FlowControl::ConditionalBranch || flow == FlowControl::UnconditionalBranch ) {
+						enqueue ( instruction.branch_target ( ) );
+					}
+					if ( instruction.ends_block ( ) ) {
+						if ( flow == FlowControl::ConditionalBranch ) {
+							enqueue ( instruction.ip + instruction.length ( ) );
+						}
+						break;
+					}
+					ip += instruction.length ( );
+				}
+			}
+
+			std::sort ( instructions_.begin ( ), instructions_.end ( ), [ ] ( const CompactInstruction& lhs, const CompactInstruction& rhs ) {
+				return lhs.ip < rhs.ip;
+			} );
+			std::sort ( leaders.begin ( ), leaders.end ( ) );
+			leaders.erase ( std::unique ( leaders.begin ( ), leaders.end ( ) ), leaders.end ( ) );
+
+			split_blocks ( leaders );
+			link_blocks ( );
+		}
+
+		void clear ( ) noexcept {
+			entry_ = 0;
+			instructions_.clear ( );
+			blocks_.clear ( );
+			successors_.clear ( );
+		}
+
+		NODISCARD FORCE_INLINE std::uint64_t entry ( ) const noexcept { return entry_; }
+		NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return blocks_.empty ( ); }
+		NODISCARD FORCE_INLINE const std::vector<CompactInstruction>& instructions ( ) const noexcept { return instructions_; }
+		NODISCARD FORCE_INLINE const std::vector<BasicBlock>& blocks ( ) const noexcept { return blocks_; }
+		NODISCARD FORCE_INLINE const CompactInstruction& instruction ( std::size_t index ) const noexcept { return instructions_ [ index ]; }
+		NODISCARD FORCE_INLINE const BasicBlock& block ( std::size_t index ) const noexcept { return blocks_ [ index ]; }
+
+		/// Block indices control can pass to from `block`
+		NODISCARD FORCE_INLINE const std::uint32_t* successors ( const BasicBlock& block ) const noexcept {
+			return successors_.data ( ) + block.firstSuccessor;
+		}
+
+		/// <returns>Index of the block starting at `ip`, or npos</returns>
+		NODISCARD std::size_t block_at ( std::uint64_t ip ) const noexcept {
+			const auto it = std::lower_bound ( blocks_.begin ( ), blocks_.end ( ), ip, [ ] ( const BasicBlock& lhs, std::uint64_t value ) {
+				return lhs.begin < value;
+			} );
+			return it != blocks_.end ( ) && it->begin == ip ? static_cast< std::size_t >( it - blocks_.begin ( ) ) : npos;
+		}
+
+		/// <returns>Index of the instruction at `ip`, or npos</returns>
+		NODISCARD std::size_t instruction_at ( std::uint64_t ip ) const noexcept {
+			const auto it = std::lower_bound ( instructions_.begin ( ), instructions_.end ( ), ip, [ ] ( const CompactInstruction& lhs, std::uint64_t value ) {
+				return lhs.ip < value;
+			} );
+			return it != instructions_.end ( ) && it->ip == ip ? static_cast< std::size_t >( it - instructions_.begin ( ) ) : npos;
+		}
+
+		static constexpr std::size_t npos = ~std::size_t { 0 };
+
+	private:
+		/// flow_control ( ), but a jmp is always an unconditional or indirect branch, never conditional
+		NODISCARD static FlowControl branch_flow ( const CompactInstruction& instruction ) noexcept {
+			if ( instruction.jmp ( ) ) {
+				const auto kind = instruction.op0_kind ( );
+				return kind == OpKindSimple::Register || kind == OpKindSimple::Memory ? FlowControl::IndirectBranch : FlowControl::UnconditionalBranch;
+			}
+			return instruction.flow_control ( );
+		}
+
+		/// A block starts at every leader and wherever the sorted instructions stop being contiguous
+		void split_blocks ( const std::vector<std::uint64_t>& leaders ) {
+			auto leader = leaders.begin ( );
+			for ( std::size_t index = 0; index < instructions_.size ( ); ++index ) {
+				const auto& instruction = instructions_ [ index ];
+				while ( leader != leaders.end ( ) && *leader < instruction.ip ) {
+					++leader;
+				}
+
+				const auto starts = blocks_.empty ( ) || ( leader != leaders.end ( ) && *leader == instruction.ip ) ||
+					blocks_.back ( ).end != instruction.ip || instructions_ [ index - 1 ].ends_block ( );
+				if ( starts ) {
+					blocks_.push_back ( { instruction.ip, instruction.ip, static_cast< std::uint32_t >( index ), 0, 0, 0 } );
+				}
+
+				auto& block = blocks_.back ( );
+				block.end = instruction.ip + instruction.length ( );
+				++block.instructionCount;
+			}
+		}
+
+		void link_blocks ( ) {
+			for ( auto& block : blocks_ ) {
+				block.firstSuccessor = static_cast< std::uint32_t >( successors_.size ( ) );
+
+				const auto& last = instructions_ [ block.firstInstruction + block.instructionCount - 1 ];
+				const auto flow = branch_flow ( last );
+				const auto link = [ & ] ( std::uint64_t ip ) {
+					const auto target = block_at ( ip );
+					if ( target != npos ) {
+						successors_.push_back ( static_cast< std::uint32_t >( target ) );
+					}
+				};
+
+				if ( flow == FlowControl::ConditionalBranch || flow == FlowControl::UnconditionalBranch ) {
+					link ( last.branch_target ( ) );
+				}
+				if ( !last.ends_block ( ) || flow == FlowControl::ConditionalBranch ) {
+					link ( block.end );
+				}
+				block.successorCount = static_cast< std::uint32_t >( successors_.size ( ) ) - block.firstSuccessor;
+			}
+		}
+
+		std::uint64_t entry_ = 0;
+		std::vector<CompactInstruction> instructions_;
+		std::vector<BasicBlock> blocks_;
+		std::vector<std::uint32_t> successors_;
+	};
+
+	/// Path on which the stack pointer does not line up
+	struct StackImbalance {
+		enum class Kind : std::uint8_t {
+			Join,   // predecessors of the block at `ip` arrive with different RSP deltas
+			Return, // the ret at `ip` executes with RSP not back at its entry value
+		};
+
+		std::uint64_t ip;
+		std::int32_t expected;
+		std::int32_t actual;
+		Kind kind;
+	};
+
+	/// Memory operand of one instruction resolved to a fixed slot of the frame
+	struct StackSlot {
+		std::uint32_t instruction; // index into ControlFlowGraph::instructions ( )
+		std::int32_t offset;       // from RSP at the function entry: 0 is the return address, locals are negative
+	};
+
+	/// <summary>
+	///  RSP deltas at every instruction of a ControlFlowGraph, computed in one pass over its
+	///  blocks: each block is walked once, with the state of the first predecessor that
+	///  reaches it, and later predecessors are only compared against that state. Tracks
+	///  push/pop/ret (stack_delta), add/sub/lea on RSP, and an RBP frame pointer set from
+	///  RSP, so mov rsp, rbp and leave stay exact. Any other write to RSP (and rsp, -16,
+	///  mov rsp, rax, enter) makes it unknown for the rest of the path.
+	/// </summary>
+	class StackTracker {
+	public:
+		/// Delta of instructions that are unreachable or follow an untracked write to RSP
+		static constexpr std::int32_t unknown = INT32_MIN;
+
+		StackTracker ( ) = default;
+		explicit StackTracker ( const ControlFlowGraph& cfg ) { analyze ( cfg ); }
+
+		void analyze ( const ControlFlowGraph& cfg ) {
+			const auto& blocks = cfg.blocks ( );
+			deltas_.assign ( cfg.instructions ( ).size ( ), unknown );
+			imbalances_.clear ( );
+			slots_.clear ( );
+
+			const auto entry = cfg.block_at ( cfg.entry ( ) );
+			if ( entry == ControlFlowGraph::npos ) {
+				return;
+			}
+
+			std::vector<State> states ( blocks.size ( ) );
+			std::vector<std::uint8_t> reached ( blocks.size ( ), 0 );
+			std::vector<std::uint32_t> pending { static_cast< std::uint32_t >( entry ) };
+			states [ entry ] = { 0, unknown };
+			reached [ entry ] = 1;
+
+			while ( !pending.empty ( ) ) {
+				const auto& block = blocks [ pending.back ( ) ];
+				auto state = states [ pending.back ( ) ];
+				pending.pop_back ( );
+
+				for ( auto index = block.firstInstruction; index < block.firstInstruction + block.instructionCount; ++index ) {
+					const auto& instruction = cfg.instruction ( index );
+					deltas_ [ index ] = state.rsp;
+					resolve_slot ( instruction, index, state );
+					if ( instruction.ret ( ) && state.rsp != unknown && state.rsp != 0 ) {
+						imbalances_.push_back ( { instruction.ip, 0, state.rsp, StackImbalance::Kind::Return } );
+					}
+					step ( instruction, state );
+				}
+
+				const auto* successors = cfg.successors ( block );
+				for ( std::uint32_t index = 0; index < block.successorCount; ++index ) {
+					const auto successor = successors [ index ];
+					if ( !reached [ successor ] ) {
+						reached [ successor ] = 1;
+						states [ successor ] = state;
+						pending.push_back ( successor );
+					}
+					else if ( states [ successor ].rsp != state.rsp && states [ successor ].rsp != unknown && state.rsp != unknown ) {
+						imbalances_.push_back ( { blocks [ successor ].begin, states [ successor ].rsp, state.rsp, StackImbalance::Kind::Join } );
+					}
+				}
+			}
+
+			std::sort ( slots_.begin ( ), slots_.end ( ), [ ] ( const StackSlot& lhs, const StackSlot& rhs ) {
+				return lhs.instruction < rhs.instruction;
+			} );
+		}
+
+		/// RSP before instruction `index` executes, relative to RSP at the function entry
+		NODISCARD FORCE_INLINE std::int32_t delta ( std::size_t index ) const noexcept { return deltas_ [ index ]; }
+		NODISCARD FORCE_INLINE const std::vector<std::int32_t>& deltas ( ) const noexcept { return deltas_; }
+		NODISCARD FORCE_INLINE const std::vector<StackImbalance>& imbalances ( ) const noexcept { return imbalances_; }
+		NODISCARD FORCE_INLINE bool balanced ( ) const noexcept { return imbalances_.empty ( ); }
+		/// [rsp+X] and [rbp+X] operands with a known frame offset, sorted by instruction
+		NODISCARD FORCE_INLINE const std::vector<StackSlot>& slots ( ) const noexcept { return slots_; }
+
+	private:
+		struct State {
+			std::int32_t rsp;
+			std::int32_t rbp; // frame pointer, if it was derived from RSP
+		};
+
+		NODISCARD static std::int32_t add ( std::int32_t value, std::int64_t offset ) noexcept {
+			return value == unknown ? unknown : static_cast< std::int32_t >( value + offset );
+		}
+
+		/// Whether the first operand is a destination; the others only read it
+		NODISCARD static bool writes_op0 ( const CompactInstruction& instruction ) noexcept {
+			switch ( instruction.mnemonic ( ) ) {
+				case Mnemonic::Push:
+				case Mnemonic::Cmp:
+				case Mnemonic::Test:
+				case Mnemonic::Bt:
+					return false;
+				default:
+					return instruction.op_kind_simple ( 0 ) == OpKindSimple::Register;
+			}
+		}
+
+		void resolve_slot ( const CompactInstruction& instruction, std::uint32_t index, const State& state ) {
+			bool memory = false;
+			for ( std::size_t operand = 0; operand < std::min<std::size_t> ( instruction.op_count ( ), 4 ); ++operand ) {
+				memory |= instruction.op_kind_simple ( operand ) == OpKindSimple::Memory;
+			}
+			if ( !memory || instruction.mem_index ( ) != Register::None ) {
+				return;
+			}
+
+			const auto base = instruction.mem_base ( );
+			auto frame = base == Register::RSP ? state.rsp : base == Register::RBP ? state.rbp : unknown;
+			// pop [rsp+X] addresses the slot after RSP was incremented
+			if ( base == Register::RSP && instruction.mnemonic ( ) == Mnemonic::Pop ) {
+				frame = add ( frame, instruction.stack_delta ( ) );
+			}
+			if ( frame != unknown ) {
+				slots_.push_back ( { index, add ( frame, static_cast< std::int64_t >( instruction.displacement ( ) ) ) } );
+			}
+		}
+
+		static void step ( const CompactInstruction& instruction, State& state ) noexcept {
+			const auto mnemonic = instruction.mnemonic ( );
+			// A call pushes the return address and the callee's ret pops it
+			if ( instruction.call ( ) ) {
+				return;
+			}
+			if ( mnemonic == Mnemonic::Leave ) {
+				state.rsp = add ( state.rbp, 8 );
+				state.rbp = unknown;
+				return;
+			}
+			if ( mnemonic == Mnemonic::Enter ) {
+				// imm16 is not kept in the record, only the pushed frame pointer is known
+				state.rbp = add ( state.rsp, -8 );
+				state.rsp = unknown;
+				return;
+			}
+
+			state.rsp = add ( state.rsp, instruction.stack_delta ( ) );
+			if ( !writes_op0 ( instruction ) ) {
+				return;
+			}
+
+			const auto destination = instruction.op0_reg ( );
+			const auto full = full_register ( destination );
+			if ( full != Register::RSP && full != Register::RBP ) {
+				return;
+			}
+			// esp, ebp, bp, ...: a partial value is as good as unknown
+			if ( destination != full ) {
+				( full == Register::RSP ? state.rsp : state.rbp ) = unknown;
+				return;
+			}
+
+			// New value of RSP or RBP, from RSP or RBP plus a constant
+			const auto immediate = static_cast< std::int64_t >( instruction.immediate ( ) );
+			const auto source = instruction.op_kind_simple ( 1 ) == OpKindSimple::Register ? instruction.op1_reg ( ) : instruction.mem_base ( );
+			const auto sourceValue = source == Register::RSP ? state.rsp : source == Register::RBP ? state.rbp : unknown;
+			auto& value = destination == Register::RSP ? state.rsp : state.rbp;
+			const auto immediateSource = instruction.op_kind_simple ( 1 ) == OpKindSimple::Immediate;
+			if ( mnemonic == Mnemonic::Add && immediateSource ) {
+				value = add ( value, immediate );
+			}
+			else if ( mnemonic == Mnemonic::Sub && immediateSource ) {
+				value = add ( value, -immediate );
+			}
+			else if ( mnemonic == Mnemonic::Mov && instruction.op_kind_simple ( 1 ) == OpKindSimple::Register ) {
+				value = sourceValue;
+			}
+			else if ( mnemonic == Mnemonic::Lea && instruction.mem_index ( ) == Register::None ) {
+				value = add ( sourceValue, static_cast< std::int64_t >( instruction.displacement ( ) ) );
+			}
+			else {
+				value = unknown;
+			}
+		}
+
+		std::vector<std::int32_t> deltas_;
+		std::vector<StackImbalance> imbalances_;
+		std::vector<StackSlot> slots_;
+	};
+};
+#endif
@@ -0,0 +1,297 @@
+#pragma once
+#ifndef __ICED_DESCENT_DEF
+#define __ICED_DESCENT_DEF
+
+#include "iced.hpp"
+#include "iced_parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace iced
+{
+	/// <summary>
+	///  One bit per byte of a code range, set with a single atomic fetch_or. Claiming an address
+	///  tells the caller whether it was the first one to get there.
+	/// </summary>
+	class AtomicBitmap {
+	public:
+		AtomicBitmap ( ) = default;
+		explicit AtomicBitmap ( std::size_t bits ) { reset ( bits ); }
+
+		void reset ( std::size_t bits ) {
+			bits_ = bits;
+			ranks_.clear ( );
+			words_.reset ( new std::atomic<std::uint64_t> [ ( bits + 63 ) / 64 ] );
+			for ( std::size_t word = 0; word < ( bits + 63 ) / 64; ++word ) {
+				words_ [ word ].store ( 0, std::memory_order_relaxed );
+			}
+		}
+
+		/// <returns>True if the bit was clear and this call set it</returns>
+		NODISCARD FORCE_INLINE bool claim ( std::size_t bit ) noexcept {
+			const auto mask = 1ULL << ( bit % 64 );
+			auto& word = words_ [ bit / 64 ];
+			// A plain load first keeps lines of already visited code shared instead of bouncing them
+			return !( word.load ( std::memory_order_relaxed ) & mask ) && !( word.fetch_or ( mask, std::memory_order_relaxed ) & mask );
+		}
+
+		FORCE_INLINE void clear ( std::size_t bit ) noexcept {
+			words_ [ bit / 64 ].fetch_and ( ~( 1ULL << ( bit % 64 ) ), std::memory_order_relaxed );
+		}
+
+		NODISCARD FORCE_INLINE bool test ( std::size_t bit ) const noexcept {
+			return words_ [ bit / 64 ].load ( std::memory_order_relaxed ) >> ( bit % 64 ) & 1;
+		}
+
+		/// Counts the set bits before every word; call once no more bits change, then use rank ( )
+		void build_ranks ( ) {
+			const auto words = ( bits_ + 63 ) / 64;
+			ranks_.resize ( words );
+			std::uint64_t total = 0;
+			for ( std::size_t word = 0; word < words; ++word ) {
+				ranks_ [ word ] = total;
+				total += popcount ( words_ [ word ].load ( std::memory_order_relaxed ) );
+			}
+		}
+
+		/// Number of set bits below `bit`
+		NODISCARD FORCE_INLINE std::uint64_t rank ( std::size_t bit ) const noexcept {
+			const auto below = words_ [ bit / 64 ].load ( std::memory_order_relaxed ) & ( ( 1ULL << ( bit % 64 ) ) - 1 );
+			return ranks_ [ bit / 64 ] + popcount ( below );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return bits_; }
+
+	private:
+		NODISCARD FORCE_INLINE static std::uint64_t popcount ( std::uint64_t value ) noexcept {
+#if defined(_MSC_VER)
+			return __popcnt64 ( value );
+#else
+			return static_cast< std::uint64_t >( __builtin_popcountll ( value ) );
+#endif
+		}
+
+		std::unique_ptr<std::atomic<std::uint64_t> [ ]> words_;
+		std::vector<std::uint64_t> ranks_;
+		std::size_t bits_ = 0;
+	};
+
+	/// <summary>
+	///  Recursive descent over a whole buffer from many entry points on all cores. Every worker
+	///  has its own decoder and task deque: it pops from the back of its own and steals from the
+	///  front of the others when it runs dry. Instruction starts are claimed in a shared
+	///  AtomicBitmap, so each one is decoded once no matter how many paths reach it.
+	///  Direct branch and call targets are followed, calls fall through, and returns, indirect
+	///  jumps, int3 and invalid bytes end a path, as in ControlFlowGraph.
+	/// </summary>
+	class RecursiveDescent {
+	public:
+		RecursiveDescent ( ) = default;
+
+		/// <summary>
+		///  Decodes everything reachable from `entries`; entries outside the buffer are ignored
+		/// </summary>
+		void build ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, const std::vector<std::uint64_t>& entries,
+					 std::size_t threads = 0 ) {
+			clear ( );
+			baseAddr_ = baseAddress;
+			if ( !code || !size ) {
+				return;
+			}
+
+			visited_.reset ( size );
+			const auto inside = [ & ] ( std::uint64_t ip ) { return ip >= baseAddress && ip - baseAddress < size; };
+
+			const auto count = worker_count ( threads );
+			std::unique_ptr<Worker [ ]> workers ( new Worker [ count ] );
+			std::atomic<std::size_t> outstanding { 0 };
+
+			for ( std::size_t index = 0; index < entries.size ( ); ++index ) {
+				if ( inside ( entries [ index ] ) ) {
+					workers [ index % count ].tasks.push_back ( entries [ index ] );
+					workers [ index % count ].functions.push_back ( entries [ index ] );
+					++outstanding;
+				}
+			}
+
+			parallel_for ( count, count, [ & ] ( std::size_t self ) {
+				auto& worker = workers [ self ];
+				ReleaseDecoder decoder ( code, size, baseAddress );
+
+				const auto push = [ & ] ( std::uint64_t ip ) {
+					if ( inside ( ip ) && !visited_.test ( static_cast< std::size_t >( ip - baseAddress ) ) ) {
+						outstanding.fetch_add ( 1, std::memory_order_relaxed );
+						std::lock_guard<std::mutex> guard ( worker.lock );
+						worker.tasks.push_back ( ip );
+					}
+				};
+
+				// Idle rounds since the last task: yield for the first few, then sleep with exponential backoff
+				std::size_t idle = 0;
+				for ( ;; ) {
+					std::uint64_t ip;
+					if ( !worker.pop ( ip ) && !steal ( workers.get ( ), count, self, ip ) ) {
+						if ( !outstanding.load ( std::memory_order_acquire ) ) {
+							break;
+						}
+						if ( idle < idleYields ) {
+							std::this_thread::yield ( );
+						}
+						else {
+							const auto shift = std::min<std::size_t> ( idle - idleYields, idleMaxShift );
+							std::this_thread::sleep_for ( std::chrono::microseconds ( std::size_t { 1 } << shift ) );
+						}
+						++idle;
+						continue;
+					}
+					idle = 0;
+
+					while ( inside ( ip ) && visited_.claim ( static_cast< std::size_t >( ip - baseAddress ) ) ) {
+						decoder.set_ip ( ip );
+						const CompactInstruction instruction ( decoder.decode ( ) );
+						if ( !instruction.length ( ) ) {
+							visited_.clear ( static_cast< std::size_t >( ip - baseAddress ) );
+							break;
+						}
+						worker.append ( instruction );
+
+						const auto flow = instruction.flow_control ( );
+						if ( flow == FlowControl::ConditionalBranch || flow == FlowControl::UnconditionalBranch || flow == FlowControl::Call ) {
+							if ( instruction.op_kind_simple ( 0 ) == OpKindSimple::NearBranch ) {
+								const auto target = instruction.branch_target ( );
+								if ( flow == FlowControl::Call && inside ( target ) ) {
+									worker.functions.push_back ( target );
+								}
+								push ( target );
+							}
+						}
+						if ( instruction.ends_block ( ) && flow != FlowControl::ConditionalBranch ) {
+							break;
+						}
+						ip += instruction.length ( );
+					}
+					outstanding.fetch_sub ( 1, std::memory_order_acq_rel );
+				}
+			} );
+
+			// The set bits are exactly the decoded starts, so an instruction's rank is its sorted index
+			visited_.build_ranks ( );
+			std::size_t total = 0;
+			for ( std::size_t index = 0; index < count; ++index ) {
+				total += workers [ index ].instructionCount;
+				functions_.insert ( functions_.end ( ), workers [ index ].functions.begin ( ), workers [ index ].functions.end ( ) );
+			}
+
+			instructions_.resize ( total );
+			parallel_for ( count, count, [ & ] ( std::size_t index ) {
+				for ( const auto& chunk : workers [ index ].chunks ) {
+					for ( const auto& instruction : chunk ) {
+						instructions_ [ visited_.rank ( static_cast< std::size_t >( instruction.ip - baseAddress ) ) ] = instruction;
+					}
+				}
+			} );
+
+			std::sort ( functions_.begin ( ), functions_.end ( ) );
+			functions_.erase ( std::unique ( functions_.begin ( ), functions_.end ( ) ), functions_.end ( ) );
+		}
+
+		void clear ( ) noexcept {
+			instructions_.clear ( );
+			functions_.clear ( );
+			visited_ = AtomicBitmap ( );
+		}
+
+		/// Every decoded instruction, sorted by address
+		NODISCARD FORCE_INLINE const std::vector<CompactInstruction>& instructions ( ) const noexcept { return instructions_; }
+		/// Entries and direct call targets, sorted
+		NODISCARD FORCE_INLINE const std::vector<std::uint64_t>& functions ( ) const noexcept { return functions_; }
+
+		/// Whether an instruction was decoded starting at `ip`
+		NODISCARD bool is_instruction ( std::uint64_t ip ) const noexcept {
+			return ip >= baseAddr_ && ip - baseAddr_ < visited_.size ( ) && visited_.test ( static_cast< std::size_t >( ip - baseAddr_ ) );
+		}
+
+		/// <returns>Index of the instruction at `ip`, or npos</returns>
+		NODISCARD std::size_t find ( std::uint64_t ip ) const noexcept {
+			if ( !is_instruction ( ip ) ) {
+				return npos;
+			}
+			const auto it = std::lower_bound ( instructions_.begin ( ), instructions_.end ( ), ip, [ ] ( const CompactInstruction& lhs, std::uint64_t value ) {
+				return lhs.ip < value;
+			} );
+			return it != instructions_.end ( ) && it->ip == ip ? static_cast< std::size_t >( it - instructions_.begin ( ) ) : npos;
+		}
+
+		static constexpr std::size_t npos = ~std::size_t { 0 };
+
+	private:
+		/// Idle workers yield this many times before sleeping, then sleep 1 us doubling up to 1 ms
+		static constexpr std::size_t idleYields = 16;
+		static constexpr std::size_t idleMaxShift = 10;
+
+		struct alignas( 64 ) Worker {
+			static constexpr std::size_t chunkSize = 4096;
+
+			std::mutex lock;
+			std::deque<std::uint64_t> tasks;
+			std::vector<std::vector<CompactInstruction>> chunks; // fixed-size, so growing never copies records
+			std::size_t instructionCount = 0;
+			std::vector<std::uint64_t> functions;
+
+			FORCE_INLINE void append ( const CompactInstruction& instruction ) {
+				if ( chunks.empty ( ) || chunks.back ( ).size ( ) == chunkSize ) {
+					chunks.emplace_back ( );
+					chunks.back ( ).reserve ( chunkSize );
+				}
+				chunks.back ( ).push_back ( instruction );
+				++instructionCount;
+			}
+
+			/// Owner side: newest task first, so a path's targets are decoded while still in cache
+			bool pop ( std::uint64_t& ip ) {
+				std::lock_guard<std::mutex> guard ( lock );
+				if ( tasks.empty ( ) ) {
+					return false;
+				}
+				ip = tasks.back ( );
+				tasks.pop_back ( );
+				return true;
+			}
+
+			/// Thief side: oldest task, usually the root of the largest unexplored region
+			bool steal ( std::uint64_t& ip ) {
+				std::lock_guard<std::mutex> guard ( lock );
+				if ( tasks.empty ( ) ) {
+					return false;
+				}
+				ip = tasks.front ( );
+				tasks.pop_front ( );
+				return true;
+			}
+		};
+
+		static bool steal ( Worker* workers, std::size_t count, std::size_t self, std::uint64_t& ip ) {
+			for ( std::size_t offset = 1; offset < count; ++offset ) {
+				if ( workers [ ( self + offset ) % count ].steal ( ip ) ) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		std::uint64_t baseAddr_ = 0;
+		AtomicBitmap visited_;
+		std::vector<CompactInstruction> instructions_;
+		std::vector<std::uint64_t> functions_;
+	};
+};
+#endif
@@ -0,0 +1,331 @@
+#pragma once
+#ifndef __ICED_EXPORT_DEF
+#define __ICED_EXPORT_DEF
+
+#include "iced.hpp"
+#include "iced_io.hpp"
+#include "iced_parallel.hpp"
+
+#include <charconv>
+
+namespace iced
+{
+	enum class ExportFormat : std::uint8_t {
+		Binary,    // ExportHeader followed by one CompactInstruction per instruction
+		JsonLines, // one JSON object per line
+		Csv,       // header row, then one row per instruction
+	};
+
+	/// Leading bytes of a binary export
+	struct ExportHeader {
+		char magic [ 8 ];
+		std::uint16_t version;
+		std::uint16_t recordSize;
+		std::uint32_t reserved;
+	};
+
+	static_assert( sizeof ( ExportHeader ) == 16, "invalid size" );
+
+	inline constexpr char exportMagic [ 8 ] = { 'I', 'C', 'E', 'D', 'E', 'X', 'P', '\0' };
+	inline constexpr std::uint16_t exportVersion = 3;
+
+	/// <summary>
+	///  Serializes the linear sweep of one code buffer as binary records, JSON Lines or CSV.
+	///  Text is appended to reused strings and written through a BufferedWriter, so nothing
+	///  is allocated per instruction. Text columns hold the mnemonic, operands (register
+	///  names or mem/imm/near/far), flow control, memory operand, immediate, the resolved
+	///  branch or RIP-relative target and, optionally, the formatted instruction.
+	/// </summary>
+	template<typename Syntax = syntax::Fast>
+	class BasicExporter {
+	public:
+		BasicExporter ( ) = delete;
+		BasicExporter ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress, ExportFormat format, bool withText = true )
+			: data_ ( buffer ), size_ ( size ), baseAddr_ ( baseAddress ), format_ ( format ), withText_ ( withText ) { }
+
+		NODISCARD FORCE_INLINE ExportFormat format ( ) const noexcept { return format_; }
+
+		/// Binary header or CSV column names; JSON Lines has no header
+		void write_header ( BufferedWriter& writer ) const {
+			if ( format_ == ExportFormat::Binary ) {
+				ExportHeader header { };
+				std::memcpy ( header.magic, exportMagic, sizeof ( header.magic ) );
+				header.version = exportVersion;
+				header.recordSize = sizeof ( CompactInstruction );
+				writer.write ( reinterpret_cast< const char* >( &header ), sizeof ( header ) );
+			}
+			else if ( format_ == ExportFormat::Csv ) {
+				writer.write ( withText_ ? "ip,length,bytes,mnemonic,op0,op1,op2,op3,flow,mem_base,mem_index,mem_scale,disp,imm,target,text\n"
+								: "ip,length,bytes,mnemonic,op0,op1,op2,op3,flow,mem_base,mem_index,mem_scale,disp,imm,target\n" );
+			}
+		}
+
+		/// <summary>
+		///  Appends the rows of `count` instructions decoded from this buffer to `out`
+		/// </summary>
+		void serialize ( const CompactInstruction* instructions, std::size_t count, std::string& out ) const {
+			if ( format_ == ExportFormat::Binary ) {
+				out.append ( reinterpret_cast< const char* >( instructions ), count * sizeof ( CompactInstruction ) );
+				return;
+			}
+
+			thread_local TextArena arena;
+			thread_local std::vector<TextSpan> spans;
+			if ( withText_ && count ) {
+				arena.clear ( );
+				spans.resize ( count );
+				BasicBatchFormatter<Syntax> ( data_, size_, baseAddr_ ).format ( instructions, count, arena, spans.data ( ) );
+			}
+
+			for ( std::size_t index = 0; index < count; ++index ) {
+				const auto text = withText_ ? arena.view ( spans [ index ] ) : std::string_view ( );
+				if ( format_ == ExportFormat::JsonLines ) {
+					append_json ( instructions [ index ], text, out );
+				}
+				else {
+					append_csv ( instructions [ index ], text, out );
+				}
+			}
+		}
+
+		/// <summary>
+		///  Sweeps the buffer on this thread and writes the header and every instruction
+		/// </summary>
+		/// <returns>Number of instructions written</returns>
+		std::size_t write ( BufferedWriter& writer ) const {
+			std::vector<CompactInstruction> batch;
+			std::string text;
+			batch.reserve ( batchSize );
+
+			write_header ( writer );
+			std::size_t written = 0;
+			ReleaseDecoder decoder ( data_, size_, baseAddr_ );
+			while ( decoder.can_decode ( ) ) {
+				batch.clear ( );
+				while ( batch.size ( ) < batchSize && decoder.can_decode ( ) ) {
+					batch.emplace_back ( decoder.decode ( ) );
+				}
+
+				text.clear ( );
+				serialize ( batch.data ( ), batch.size ( ), text );
+				writer.write ( text );
+				written += batch.size ( );
+			}
+			return written;
+		}
+
+		/// <summary>
+		///  Same output as write ( ). The buffer is swept in slabs with parallel_sweep, each slab's
+		///  batches are serialized on `threads` threads (0 = all hardware threads) and written in order.
+		/// </summary>
+		/// <returns>Number of instructions written</returns>
+		std::size_t write_parallel ( BufferedWriter& writer, std::size_t threads = 0 ) const {
+			struct Sink {
+				std::vector<CompactInstruction> instructions;
+
+				void operator()( const Instruction& instruction ) { instructions.emplace_back ( instruction ); }
+
+				void discard_before ( std::uint64_t ip ) {
+					const auto end = std::lower_bound ( instructions.begin ( ), instructions.end ( ), ip, [ ] ( const CompactInstruction& lhs, std::uint64_t value ) {
+						return lhs.ip < value;
+					} );
+					instructions.erase ( instructions.begin ( ), end );
+				}
+			};
+
+			struct Batch {
+				const CompactInstruction* instructions;
+				std::size_t count;
+			};
+
+			threads = worker_count ( threads );
+			write_header ( writer );
+
+			std::size_t written = 0;
+			std::vector<Sink> sinks ( threads );
+			std::vector<Batch> batches;
+			for ( std::size_t offset = 0; offset < size_; ) {
+				// Sweep a little past the slab so the instructions starting inside it are decoded in full;
+				// the next slab continues where the last of them ends
+				const auto slabEnd = std::min ( size_, offset + slabSize );
+				const auto sweepEnd = std::min ( size_, slabEnd + DecoderBase::maxInstructionLength );
+				for ( auto& sink : sinks ) {
+					sink.instructions.clear ( );
+				}
+				parallel_sweep ( data_ + offset, sweepEnd - offset, baseAddr_ + offset, sinks );
+
+				batches.clear ( );
+				auto next = offset;
+				for ( auto& sink : sinks ) {
+					auto& instructions = sink.instructions;
+					while ( !instructions.empty ( ) && instructions.back ( ).ip - baseAddr_ >= slabEnd ) {
+						instructions.pop_back ( );
+					}
+					if ( !instructions.empty ( ) ) {
+						next = static_cast< std::size_t >( instructions.back ( ).ip - baseAddr_ ) + instructions.back ( ).length ( );
+					}
+
+					for ( std::size_t first = 0; first < instructions.size ( ); first += batchSize ) {
+						batches.push_back ( { instructions.data ( ) + first, std::min ( batchSize, instructions.size ( ) - first ) } );
+					}
+					written += instructions.size ( );
+				}
+
+				parallel_ordered ( batches.size ( ), threads, [ & ] ( std::size_t index, std::string& text ) {
+					serialize ( batches [ index ].instructions, batches [ index ].count, text );
+				}, [ & ] ( std::string_view text ) {
+					writer.write ( text );
+				} );
+
+				if ( next <= offset ) {
+					break;
+				}
+				offset = next;
+			}
+			return written;
+		}
+
+	private:
+		static constexpr std::size_t batchSize = 4096;
+		static constexpr std::size_t slabSize = 1 << 23;
+
+		static constexpr const char* flowNames [ ] = {
+			"next", "branch", "indirect_branch", "conditional_branch", "return",
+			"call", "indirect_call", "interrupt", "xbegin_xabort_xend", "exception",
+		};
+
+		template<typename T>
+		static FORCE_INLINE void append_number ( std::string& out, T value ) {
+			char digits [ 24 ];
+			out.append ( digits, static_cast< std::size_t >( std::to_chars ( digits, digits + sizeof ( digits ), value ).ptr - digits ) );
+		}
+
+		FORCE_INLINE void append_bytes ( std::string& out, const CompactInstruction& instruction ) const {
+			constexpr char hex [ ] = "0123456789abcdef";
+			const auto offset = static_cast< std::size_t >( instruction.ip - baseAddr_ );
+			const auto length = std::min<std::size_t> ( instruction.length ( ), size_ - offset );
+			for ( std::size_t index = 0; index < length; ++index ) {
+				out += hex [ data_ [ offset + index ] >> 4 ];
+				out += hex [ data_ [ offset + index ] & 0xF ];
+			}
+		}
+
+		static FORCE_INLINE std::string_view operand_name ( const CompactInstruction& instruction, std::size_t index ) noexcept {
+			switch ( instruction.op_kind_simple ( index ) ) {
+				case OpKindSimple::Register:
+					return register_name ( instruction.op_reg ( index ) );
+				case OpKindSimple::Memory:
+					return "mem";
+				case OpKindSimple::Immediate:
+					return "imm";
+				case OpKindSimple::NearBranch:
+					return "near";
+				case OpKindSimple::FarBranch:
+					return "far";
+				default:
+					return { };
+			}
+		}
+
+		static FORCE_INLINE std::uint64_t target ( const CompactInstruction& instruction ) noexcept {
+			const auto kind = instruction.op_kind_simple ( 0 );
+			if ( kind == OpKindSimple::NearBranch || kind == OpKindSimple::FarBranch ) {
+				return instruction.branch_target ( );
+			}
+			return instruction.mem_base ( ) == Register::RIP ? instruction.compute_memory_address ( ) : 0;
+		}
+
+		void append_json ( const CompactInstruction& instruction, std::string_view text, std::string& out ) const {
+			out += "{\"ip\":";
+			append_number ( out, instruction.ip );
+			out += ",\"length\":";
+			append_number ( out, instruction.length ( ) );
+			out += ",\"bytes\":\"";
+			append_bytes ( out, instruction );
+			out += "\",\"mnemonic\":\"";
+			out += mnemonic_name ( instruction.mnemonic ( ) );
+			out += "\",\"operands\":[";
+			for ( std::size_t index = 0; index < instruction.op_count ( ) && index < 4; ++index ) {
+				out += index ? ",\"" : "\"";
+				out += operand_name ( instruction, index );
+				out += '"';
+			}
+			out += "],\"flow\":\"";
+			out += flowNames [ static_cast< std::size_t >( instruction.flow_control ( ) ) ];
+			out += "\",\"mem_base\":\"";
+			out += register_name ( instruction.mem_base ( ) );
+			out += "\",\"mem_index\":\"";
+			out += register_name ( instruction.mem_index ( ) );
+			out += "\",\"mem_scale\":";
+			append_number ( out, instruction.mem_scale ( ) );
+			out += ",\"disp\":";
+			append_number ( out, static_cast< std::int64_t >( instruction.displacement ( ) ) );
+			out += ",\"imm\":";
+			append_number ( out, instruction.immediate ( ) );
+			out += ",\"target\":";
+			append_number ( out, target ( instruction ) );
+			if ( withText_ ) {
+				out += ",\"text\":\"";
+				for ( const auto character : text ) {
+					if ( character == '"' || character == '\\' ) {
+						out += '\\';
+					}
+					out += character;
+				}
+				out += '"';
+			}
+			out += "}\n";
+		}
+
+		void append_csv ( const CompactInstruction& instruction, std::string_view text, std::string& out ) const {
+			append_number ( out, instruction.ip );
+			out += ',';
+			append_number ( out, instruction.length ( ) );
+			out += ',';
+			append_bytes ( out, instruction );
+			out += ',';
+			out += mnemonic_name ( instruction.mnemonic ( ) );
+			for ( std::size_t index = 0; index < 4; ++index ) {
+				out += ',';
+				if ( index < instruction.op_count ( ) ) {
+					out += operand_name ( instruction, index );
+				}
+			}
+			out += ',';
+			out += flowNames [ static_cast< std::size_t >( instruction.flow_control ( ) ) ];
+			out += ',';
+			out += register_name ( instruction.mem_base ( ) );
+			out += ',';
+			out += register_name ( instruction.mem_index ( ) );
+			out += ',';
+			append_number ( out, instruction.mem_scale ( ) );
+			out += ',';
+			append_number ( out, static_cast< std::int64_t >( instruction.displacement ( ) ) );
+			out += ',';
+			append_number ( out, instruction.immediate ( ) );
+			out += ',';
+			append_number ( out, target ( instruction ) );
+			if ( withText_ ) {
+				// Operand lists contain commas, so the text is always quoted
+				out += ",\"";
+				for ( const auto character : text ) {
+					if ( character == '"' ) {
+						out += '"';
+					}
+					out += character;
+				}
+				out += '"';
+			}
+			out += '\n';
+		}
+
+		const std::uint8_t* data_;
+		std::size_t size_;
+		std::uint64_t baseAddr_;
+		ExportFormat format_;
+		bool withText_;
+	};
+
+	using Exporter = BasicExporter<>;
+};
+#endif
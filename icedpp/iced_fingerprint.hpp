@@ -0,0 +1,336 @@
+#pragma once
+#ifndef __ICED_FINGERPRINT_DEF
+#define __ICED_FINGERPRINT_DEF
+
+#include "iced.hpp"
+#include "iced_cfg.hpp"
+#include "iced_hash.hpp"
+#include "iced_parallel.hpp"
+
+#include <array>
+#include <unordered_map>
+
+namespace iced
+{
+	/// <summary>
+	///  How much of an instruction a fingerprint ignores; every level includes the ones before it.
+	///  Branch targets and RIP-relative displacements are always left out. Exact and Immediates
+	///  still hash absolute displacements (Exact also absolute immediates), so only Displacements
+	///  and Registers give hashes that do not depend on where the code was loaded.
+	/// </summary>
+	enum class Normalization : std::uint8_t {
+		Exact,         // encoding, registers, immediates and displacements
+		Immediates,    // immediates masked; the encoding is replaced by the mnemonic since imm8/imm32 forms differ
+		Displacements, // memory displacements and absolute addresses masked as well
+		Registers,     // registers renamed in order of first use within the block (RSP, RIP and segments kept)
+	};
+
+	/// Fingerprint of one basic block of a linear sweep
+	struct BlockHash {
+		std::uint64_t begin;
+		std::uint64_t end;
+		std::uint64_t hash;
+		std::uint32_t instructionCount;
+	};
+
+	/// Pair of indices whose hashes matched in match_unique ( )
+	struct HashMatch {
+		std::size_t lhs;
+		std::size_t rhs;
+	};
+
+	namespace hash
+	{
+		/// Numbers registers by first use; reset at every block so block hashes do not depend on their neighbours
+		class RegisterRenaming {
+		public:
+			void reset ( ) noexcept {
+				ordinals_.fill ( 0 );
+				next_ = 0;
+			}
+
+			NODISCARD std::uint64_t token ( Register reg ) noexcept {
+				switch ( register_class ( reg ) ) {
+					case RegisterClass::Gpr8:
+					case RegisterClass::Gpr16:
+					case RegisterClass::Gpr32:
+					case RegisterClass::Gpr64:
+					case RegisterClass::Xmm:
+					case RegisterClass::Ymm:
+					case RegisterClass::Zmm:
+					case RegisterClass::K:
+					case RegisterClass::Mm:
+					case RegisterClass::Tmm:
+						break;
+					default:
+						return static_cast< std::uint64_t >( reg );
+				}
+
+				const auto full = full_register ( reg );
+				if ( full == Register::RSP ) {
+					return static_cast< std::uint64_t >( reg );
+				}
+
+				auto& ordinal = ordinals_ [ static_cast< std::uint8_t >( full ) ];
+				if ( !ordinal ) {
+					ordinal = next_ < 0xFF ? ++next_ : next_;
+				}
+				// High bit keeps renamed tokens apart from real register values
+				return 0x10000ULL | static_cast< std::uint64_t >( register_class ( reg ) ) << 8 | ordinal;
+			}
+
+		private:
+			std::array<std::uint8_t, 256> ordinals_ { };
+			std::uint8_t next_ = 0;
+		};
+
+		/// Hash of one instruction at the given normalization level, ignoring branch targets and RIP-relative displacements
+		template<typename Derived>
+		NODISCARD std::uint64_t instruction ( const InstructionAccessors<Derived>& instruction, Normalization level, RegisterRenaming& renaming ) noexcept {
+			const auto reg = [ & ] ( Register value ) {
+				return level >= Normalization::Registers ? renaming.token ( value ) : static_cast< std::uint64_t >( value );
+			};
+
+			const auto encoding = level == Normalization::Exact ? static_cast< std::uint64_t >( instruction.code ( ) ) << 32 : 0;
+			const auto prefixes = static_cast< std::uint64_t >( instruction.rep_prefix ( ) ) | instruction.repne_prefix ( ) << 1 |
+				instruction.lock_prefix ( ) << 2 | instruction.is_broadcast ( ) << 3 | instruction.zeroing_masking ( ) << 4 |
+				instruction.suppress_all_exceptions ( ) << 5;
+			auto result = combine ( seed, encoding | static_cast< std::uint64_t >( instruction.mnemonic ( ) ) << 8 | instruction.op_count ( ) );
+			result = combine ( result, prefixes | static_cast< std::uint64_t >( instruction.rounding_control ( ) ) << 8 |
+							   reg ( instruction.op_mask ( ) ) << 16 );
+
+			for ( std::size_t index = 0; index < instruction.op_count ( ) && index < 4; ++index ) {
+				const auto kind = instruction.op_kind ( index );
+				result = combine ( result, static_cast< std::uint64_t >( kind ) | instruction.op_size ( index ) << 8 );
+
+				switch ( instruction.op_kind_simple ( index ) ) {
+					case OpKindSimple::Register:
+						result = combine ( result, reg ( instruction.op_reg ( index ) ) );
+						break;
+					case OpKindSimple::Memory: {
+						const auto base = instruction.mem_base ( );
+						result = combine ( result, reg ( base ) | reg ( instruction.mem_index ( ) ) << 20 |
+										   static_cast< std::uint64_t >( instruction.mem_scale ( ) ) << 40 |
+										   static_cast< std::uint64_t >( instruction.segment_prefix ( ) ) << 48 );
+						if ( base != Register::RIP && level < Normalization::Displacements ) {
+							result = combine ( result, instruction.displacement ( ) );
+						}
+						break;
+					}
+					case OpKindSimple::Immediate:
+						if ( level < Normalization::Immediates ) {
+							result = combine ( result, kind == OpKind::Immediate8_2nd ? instruction.immediate2 ( ) : instruction.immediate ( ) );
+						}
+						break;
+					default: // branch targets
+						break;
+				}
+			}
+			return result;
+		}
+
+		/// Hash of a straight-line run of instructions; registers are renamed within the run
+		template<typename T>
+		NODISCARD std::uint64_t block ( const T* first, std::size_t count, Normalization level, RegisterRenaming& renaming ) noexcept {
+			renaming.reset ( );
+			auto result = seed;
+			for ( std::size_t index = 0; index < count; ++index ) {
+				result = combine ( result, instruction ( first [ index ], level, renaming ) );
+			}
+			return combine ( result, count );
+		}
+	};
+
+	/// <summary>
+	///  Hash of every block of `cfg`, in the order of cfg.blocks ( ). Large graphs are split
+	///  into groups of blocks hashed on up to `threads` threads.
+	/// </summary>
+	NODISCARD inline std::vector<std::uint64_t> hash_blocks ( const ControlFlowGraph& cfg, Normalization level, std::size_t threads = 0 ) {
+		constexpr std::size_t blocksPerTask = 256;
+
+		const auto& blocks = cfg.blocks ( );
+		std::vector<std::uint64_t> hashes ( blocks.size ( ) );
+		parallel_for ( ( blocks.size ( ) + blocksPerTask - 1 ) / blocksPerTask, threads, [ & ] ( std::size_t task ) {
+			hash::RegisterRenaming renaming;
+			const auto last = std::min ( blocks.size ( ), ( task + 1 ) * blocksPerTask );
+			for ( auto index = task * blocksPerTask; index < last; ++index ) {
+				const auto& block = blocks [ index ];
+				hashes [ index ] = hash::block ( &cfg.instruction ( block.firstInstruction ), block.instructionCount, level, renaming );
+			}
+		} );
+		return hashes;
+	}
+
+	/// <summary>
+	///  Hash of a whole function from its block hashes and their out-degree. The blocks are
+	///  combined in sorted order, so reordering the layout of a function does not change it.
+	/// </summary>
+	NODISCARD inline std::uint64_t hash_function ( const ControlFlowGraph& cfg, const std::vector<std::uint64_t>& blockHashes ) {
+		std::vector<std::uint64_t> keys ( blockHashes.size ( ) );
+		for ( std::size_t index = 0; index < keys.size ( ); ++index ) {
+			keys [ index ] = hash::combine ( blockHashes [ index ], cfg.block ( index ).successorCount );
+		}
+		std::sort ( keys.begin ( ), keys.end ( ) );
+
+		auto result = hash::seed;
+		for ( const auto key : keys ) {
+			result = hash::combine ( result, key );
+		}
+		return hash::combine ( result, keys.size ( ) );
+	}
+
+	NODISCARD inline std::uint64_t hash_function ( const ControlFlowGraph& cfg, Normalization level ) {
+		return hash_function ( cfg, hash_blocks ( cfg, level, 1 ) );
+	}
+
+	/// Sink for parallel_sweep that closes a block after every instruction ending one
+	struct BlockHasher {
+		BlockHasher ( ) = default;
+		explicit BlockHasher ( Normalization normalization ) noexcept : level ( normalization ) { }
+
+		Normalization level = Normalization::Exact;
+		std::vector<BlockHash> blocks;
+		BlockHash open { };
+		hash::RegisterRenaming renaming;
+
+		void operator()( const Instruction& instruction ) {
+			// Chunks are fed again after stitching; only contiguous runs form a block
+			if ( open.instructionCount && open.end != instruction.ip ) {
+				open.instructionCount = 0;
+			}
+			if ( !open.instructionCount ) {
+				open = { instruction.ip, instruction.ip, hash::seed, 0 };
+				renaming.reset ( );
+			}
+
+			open.hash = hash::combine ( open.hash, hash::instruction ( instruction, level, renaming ) );
+			open.end = instruction.ip + instruction.length ( );
+			++open.instructionCount;
+			if ( instruction.ends_block ( ) ) {
+				close ( );
+			}
+		}
+
+		void close ( ) {
+			if ( open.instructionCount ) {
+				open.hash = hash::combine ( open.hash, open.instructionCount );
+				blocks.push_back ( open );
+				open.instructionCount = 0;
+			}
+		}
+
+		void discard_before ( std::uint64_t ip ) {
+			const auto end = std::lower_bound ( blocks.begin ( ), blocks.end ( ), ip, [ ] ( const BlockHash& lhs, std::uint64_t value ) {
+				return lhs.begin < value;
+			} );
+			blocks.erase ( blocks.begin ( ), end );
+		}
+	};
+
+	/// <summary>
+	///  Block hashes of a linear sweep of the whole buffer, on up to `threads` threads. Blocks end
+	///  after branches, returns and traps, as in a ControlFlowGraph, but calls and branch targets do
+	///  not split them. The result is the same as a sequential sweep for any thread count: a
+	///  chunk's block is only kept if it starts where the previous block ended, the few that
+	///  straddle chunk boundaries are decoded again.
+	/// </summary>
+	NODISCARD inline std::vector<BlockHash> hash_sweep ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress,
+														 Normalization level, std::size_t threads = 0 ) {
+		std::vector<BlockHasher> hashers ( worker_count ( threads ), BlockHasher ( level ) );
+		parallel_sweep ( code, size, baseAddress, hashers );
+
+		std::vector<BlockHash> blocks;
+		BlockHasher gap ( level );
+		ReleaseDecoder decoder ( code, size, baseAddress );
+		const auto end = baseAddress + size;
+		auto cursor = baseAddress;
+
+		// Decodes whole blocks from the cursor until it reaches `until`; the buffer end closes the last one
+		const auto fill = [ & ] ( std::uint64_t until ) {
+			if ( cursor < end ) {
+				decoder.set_ip ( cursor );
+			}
+			while ( cursor < until ) {
+				const auto& instruction = decoder.decode ( );
+				if ( !instruction.length ( ) || !decoder.can_decode ( ) ) {
+					if ( instruction.length ( ) ) {
+						gap ( instruction );
+					}
+					gap.close ( );
+					cursor = end;
+				}
+				else {
+					gap ( instruction );
+				}
+
+				if ( !gap.blocks.empty ( ) ) {
+					blocks.push_back ( gap.blocks.back ( ) );
+					gap.blocks.clear ( );
+					cursor = std::max ( cursor, blocks.back ( ).end );
+				}
+			}
+		};
+
+		for ( const auto& hasher : hashers ) {
+			for ( const auto& block : hasher.blocks ) {
+				if ( block.begin > cursor ) {
+					fill ( block.begin );
+				}
+				if ( block.begin == cursor ) {
+					blocks.push_back ( block );
+					cursor = block.end;
+				}
+			}
+		}
+		fill ( end );
+		return blocks;
+	}
+
+	/// <summary>
+	///  Hash join of two hash lists, e.g. the blocks or functions of two builds: pairs the indices
+	///  of hashes that occur exactly once on each side, sorted by `lhs`. Repeated hashes (padding,
+	///  thunks, common epilogues) are ambiguous and left for a finer pass.
+	/// </summary>
+	template<typename T, typename Key>
+	NODISCARD std::vector<HashMatch> match_unique ( const std::vector<T>& lhs, const std::vector<T>& rhs, Key key ) {
+		constexpr auto repeated = ~std::size_t { 0 };
+
+		const auto index = [ & ] ( const std::vector<T>& values ) {
+			std::unordered_map<std::uint64_t, std::size_t> table;
+			table.reserve ( values.size ( ) );
+			for ( std::size_t position = 0; position < values.size ( ); ++position ) {
+				const auto [ it, inserted ] = table.try_emplace ( key ( values [ position ] ), position );
+				if ( !inserted ) {
+					it->second = repeated;
+				}
+			}
+			return table;
+		};
+
+		const auto left = index ( lhs );
+		const auto right = index ( rhs );
+
+		std::vector<HashMatch> matches;
+		for ( const auto& [ hash, position ] : right ) {
+			if ( position == repeated ) {
+				continue;
+			}
+			const auto it = left.find ( hash );
+			if ( it != left.end ( ) && it->second != repeated ) {
+				matches.push_back ( { it->second, position } );
+			}
+		}
+
+		std::sort ( matches.begin ( ), matches.end ( ), [ ] ( const HashMatch& first, const HashMatch& second ) { return first.lhs < second.lhs; } );
+		return matches;
+	}
+
+	NODISCARD inline std::vector<HashMatch> match_unique ( const std::vector<BlockHash>& lhs, const std::vector<BlockHash>& rhs ) {
+		return match_unique ( lhs, rhs, [ ] ( const BlockHash& block ) { return block.hash; } );
+	}
+
+	NODISCARD inline std::vector<HashMatch> match_unique ( const std::vector<std::uint64_t>& lhs, const std::vector<std::uint64_t>& rhs ) {
+		return match_unique ( lhs, rhs, [ ] ( std::uint64_t value ) { return value; } );
+	}
+};
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef __ICED_HASH_DEF
+#define __ICED_HASH_DEF
+
+#include "iced.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace iced
+{
+	/// <summary>
+	///  Fast non-cryptographic 64-bit hashing (multiply-fold, wyhash style).
+	///  Good enough for content keys and deduplication, not for adversarial input.
+	/// </summary>
+	namespace hash
+	{
+		constexpr std::uint64_t seed = 0xA0761D6478BD642FULL;
+		constexpr std::uint64_t prime1 = 0xE7037ED1A0B428DBULL;
+		constexpr std::uint64_t prime2 = 0x8EBC6AF09C88C6E3ULL;
+
+		/// 64x64 -> 128-bit multiply, folded: low half xor high half
+		NODISCARD FORCE_INLINE std::uint64_t mix ( std::uint64_t lhs, std::uint64_t rhs ) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+			std::uint64_t high;
+			const auto low = _umul128 ( lhs, rhs, &high );
+			return low ^ high;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+			return ( lhs * rhs ) ^ __umulh ( lhs, rhs );
+#elif defined(__SIZEOF_INT128__)
+			__extension__ using uint128 = unsigned __int128;
+			const auto product = static_cast< uint128 >( lhs ) * rhs;
+			return static_cast< std::uint64_t >( product ) ^ static_cast< std::uint64_t >( product >> 64 );
+#else
+			// Schoolbook multiply on 32-bit halves, for targets without a wide multiply
+			const std::uint64_t lhsLow = lhs & 0xFFFFFFFF, lhsHigh = lhs >> 32;
+			const std::uint64_t rhsLow = rhs & 0xFFFFFFFF, rhsHigh = rhs >> 32;
+			const auto lowLow = lhsLow * rhsLow;
+			const auto highLow = lhsHigh * rhsLow;
+			const auto lowHigh = lhsLow * rhsHigh;
+			const auto cross = ( lowLow >> 32 ) + ( highLow & 0xFFFFFFFF ) + lowHigh;
+			const auto high = lhsHigh * rhsHigh + ( highLow >> 32 ) + ( cross >> 32 );
+			return ( lhs * rhs ) ^ high;
+#endif
+		}
+
+		NODISCARD FORCE_INLINE std::uint64_t read64 ( const std::uint8_t* data ) noexcept {
+			std::uint64_t value;
+			std::memcpy ( &value, data, sizeof ( value ) );
+			return value;
+		}
+
+		/// Combines an already-hashed value into a running hash
+		NODISCARD FORCE_INLINE std::uint64_t combine ( std::uint64_t hash, std::uint64_t value ) noexcept {
+			return mix ( hash ^ prime1, value ^ prime2 );
+		}
+
+		NODISCARD inline std::uint64_t bytes ( const void* buffer, std::size_t size, std::uint64_t hash = seed ) noexcept {
+			const auto* data = static_cast< const std::uint8_t* >( buffer );
+			hash ^= mix ( size ^ prime1, seed );
+
+			while ( size >= 16 ) {
+				hash = mix ( read64 ( data ) ^ prime1, read64 ( data + 8 ) ^ hash );
+				data += 16;
+				size -= 16;
+			}
+
+			std::uint64_t low = 0, high = 0;
+			if ( size >= 8 ) {
+				low = read64 ( data );
+				std::memcpy ( &high, data + 8, size - 8 );
+			}
+			else {
+				std::memcpy ( &low, data, size );
+			}
+
+			return mix ( mix ( low ^ prime1, high ^ hash ), seed ^ prime2 );
+		}
+	};
+};
+#endif
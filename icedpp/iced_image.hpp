@@ -0,0 +1,584 @@
+#pragma once
+#ifndef __ICED_IMAGE_DEF
+#define __ICED_IMAGE_DEF
+
+#include "iced.hpp"
+#include "iced_parallel.hpp"
+
+namespace iced
+{
+	struct ImageSection {
+		char name [ 16 ];
+		std::uint64_t address;
+		std::uint64_t size;
+		std::uint64_t fileOffset;
+		std::uint64_t fileSize;
+		bool executable;
+	};
+
+	/// <summary>
+	///  Section table of a PE32+ or ELF64 file as stored on disk (not loaded/relocated).
+	///  Does not own the bytes; pair it with a MappedFile to keep them alive.
+	/// </summary>
+	class ImageView {
+	public:
+		enum class Format : std::uint8_t {
+			Unknown,
+			Pe,
+			Elf,
+		};
+
+		ImageView ( ) = default;
+		ImageView ( const std::uint8_t* data, std::size_t size ) { parse ( data, size ); }
+
+		/// <returns>false if the file is neither a well-formed PE32+ nor a little-endian ELF64</returns>
+		bool parse ( const std::uint8_t* data, std::size_t size ) {
+			data_ = data;
+			size_ = size;
+			format_ = Format::Unknown;
+			imageBase_ = 0;
+			exceptionDirectory_ = exceptionDirectorySize_ = 0;
+			sections_.clear ( );
+
+			if ( parse_pe ( ) ) {
+				format_ = Format::Pe;
+				return true;
+			}
+
+			sections_.clear ( );
+			if ( parse_elf ( ) ) {
+				format_ = Format::Elf;
+				return true;
+			}
+
+			sections_.clear ( );
+			return false;
+		}
+
+		NODISCARD FORCE_INLINE Format format ( ) const noexcept { return format_; }
+		NODISCARD FORCE_INLINE const std::uint8_t* data ( ) const noexcept { return data_; }
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return size_; }
+		NODISCARD FORCE_INLINE std::uint64_t image_base ( ) const noexcept { return imageBase_; }
+		NODISCARD FORCE_INLINE const std::vector<ImageSection>& sections ( ) const noexcept { return sections_; }
+
+		/// RVA and size of the PE exception directory (.pdata), 0 when absent
+		NODISCARD FORCE_INLINE std::uint32_t exception_directory ( ) const noexcept { return exceptionDirectory_; }
+		NODISCARD FORCE_INLINE std::uint32_t exception_directory_size ( ) const noexcept { return exceptionDirectorySize_; }
+
+		NODISCARD const ImageSection* find_section ( const char* name ) const noexcept {
+			for ( const auto& section : sections_ ) {
+				if ( std::strncmp ( section.name, name, sizeof ( section.name ) ) == 0 ) {
+					return &section;
+				}
+			}
+			return nullptr;
+		}
+
+		NODISCARD const ImageSection* section_at ( std::uint64_t address ) const noexcept {
+			for ( const auto& section : sections_ ) {
+				if ( address >= section.address && address - section.address < section.size ) {
+					return &section;
+				}
+			}
+			return nullptr;
+		}
+
+		/// <summary>
+		///  Translates a virtual address to file bytes
+		/// </summary>
+		/// <returns>Pointer to the bytes and how many follow inside the section's file data, or nullptr</returns>
+		NODISCARD const std::uint8_t* bytes_at ( std::uint64_t address, std::size_t& available ) const noexcept {
+			available = 0;
+			const auto* section = section_at ( address );
+			if ( !section ) {
+				return nullptr;
+			}
+
+			const auto delta = address - section->address;
+			if ( delta >= section->fileSize ) {
+				return nullptr;
+			}
+
+			available = static_cast< std::size_t >( section->fileSize - delta );
+			return data_ + section->fileOffset + delta;
+		}
+
+		/// Bounds-checked little-endian read from the file
+		template<typename T>
+		NODISCARD bool read ( std::uint64_t offset, T& value ) const noexcept {
+			if ( offset > size_ || size_ - offset < sizeof ( T ) ) {
+				return false;
+			}
+
+			std::memcpy ( &value, data_ + offset, sizeof ( T ) );
+			return true;
+		}
+
+	private:
+		bool parse_pe ( ) {
+			constexpr std::uint16_t machineAmd64 = 0x8664;
+			constexpr std::uint16_t optionalMagic64 = 0x20B;
+			constexpr std::uint32_t exceptionDirectoryIndex = 3;
+			constexpr std::uint32_t sectionExecute = 0x20000000;
+
+			std::uint16_t dosMagic = 0;
+			std::uint32_t peOffset = 0, peMagic = 0;
+			if ( !read ( 0, dosMagic ) || dosMagic != 0x5A4D || !read ( 0x3C, peOffset ) || !read ( peOffset, peMagic ) || peMagic != 0x4550 ) {
+				return false;
+			}
+
+			std::uint16_t machine = 0, sectionCount = 0, optionalSize = 0, optionalMagic = 0;
+			const std::uint64_t fileHeader = peOffset + 4ULL;
+			const auto optionalHeader = fileHeader + 20;
+			if ( !read ( fileHeader, machine ) || machine != machineAmd64 || !read ( fileHeader + 2, sectionCount ) ||
+				 !read ( fileHeader + 16, optionalSize ) || !read ( optionalHeader, optionalMagic ) || optionalMagic != optionalMagic64 ) {
+				return false;
+			}
+
+			std::uint32_t directoryCount = 0;
+			if ( !read ( optionalHeader + 24, imageBase_ ) || !read ( optionalHeader + 108, directoryCount ) ) {
+				return false;
+			}
+
+			if ( directoryCount > exceptionDirectoryIndex ) {
+				const auto directory = optionalHeader + 112 + exceptionDirectoryIndex * 8;
+				if ( !read ( directory, exceptionDirectory_ ) || !read ( directory + 4, exceptionDirectorySize_ ) ) {
+					return false;
+				}
+			}
+
+			const auto sectionTable = optionalHeader + optionalSize;
+			sections_.reserve ( sectionCount );
+			for ( std::uint32_t index = 0; index < sectionCount; ++index ) {
+				const auto header = sectionTable + index * 40ULL;
+
+				std::uint32_t virtualSize = 0, virtualAddress = 0, rawSize = 0, rawOffset = 0, characteristics = 0;
+				if ( !read ( header + 8, virtualSize ) || !read ( header + 12, virtualAddress ) || !read ( header + 16, rawSize ) ||
+					 !read ( header + 20, rawOffset ) || !read ( header + 36, characteristics ) ) {
+					return false;
+				}
+
+				ImageSection section {};
+				std::memcpy ( section.name, data_ + header, 8 );
+				section.address = imageBase_ + virtualAddress;
+				section.size = virtualSize ? virtualSize : rawSize;
+				section.fileOffset = rawOffset;
+				section.fileSize = std::min<std::uint64_t> ( rawSize, section.size );
+				if ( rawOffset > size_ || size_ - rawOffset < section.fileSize ) {
+					section.fileSize = rawOffset > size_ ? 0 : size_ - rawOffset;
+				}
+				section.executable = ( characteristics & sectionExecute ) != 0;
+				sections_.push_back ( section );
+			}
+
+			return true;
+		}
+
+		bool parse_elf ( ) {
+			constexpr std::uint32_t sectionNoBits = 8;
+			constexpr std::uint64_t sectionExecute = 0x4;
+
+			std::uint32_t magic = 0;
+			std::uint8_t fileClass = 0, encoding = 0;
+			if ( !read ( 0, magic ) || magic != 0x464C457F || !read ( 4, fileClass ) || fileClass != 2 || !read ( 5, encoding ) || encoding != 1 ) {
+				return false;
+			}
+
+			std::uint64_t headerOffset = 0;
+			std::uint16_t headerSize = 0, headerCount = 0, namesIndex = 0;
+			if ( !read ( 0x28, headerOffset ) || !read ( 0x3A, headerSize ) || !read ( 0x3C, headerCount ) || !read ( 0x3E, namesIndex ) ||
+				 headerSize < 64 || namesIndex >= headerCount ) {
+				return false;
+			}
+
+			std::uint64_t namesOffset = 0, namesSize = 0;
+			const auto namesHeader = headerOffset + namesIndex * static_cast< std::uint64_t >( headerSize );
+			if ( !read ( namesHeader + 24, namesOffset ) || !read ( namesHeader + 32, namesSize ) || namesOffset > size_ || size_ - namesOffset < namesSize ) {
+				return false;
+			}
+
+			sections_.reserve ( headerCount );
+			for ( std::uint32_t index = 0; index < headerCount; ++index ) {
+				const auto header = headerOffset + index * static_cast< std::uint64_t >( headerSize );
+
+				std::uint32_t nameOffset = 0, type = 0;
+				std::uint64_t flags = 0, address = 0, offset = 0, sectionSize = 0;
+				if ( !read ( header, nameOffset ) || !read ( header + 4, type ) || !read ( header + 8, flags ) || !read ( header + 16, address ) ||
+					 !read ( header + 24, offset ) || !read ( header + 32, sectionSize ) ) {
+					return false;
+				}
+
+				ImageSection section {};
+				if ( nameOffset < namesSize ) {
+					const auto* name = reinterpret_cast< const char* >( data_ + namesOffset + nameOffset );
+					const auto length = std::min<std::size_t> ( sizeof ( section.name ) - 1, static_cast< std::size_t >( namesSize - nameOffset ) );
+					std::strncpy ( section.name, name, length );
+				}
+				section.address = address;
+				section.size = sectionSize;
+				section.fileOffset = offset;
+				section.fileSize = type == sectionNoBits || offset > size_ ? 0 : std::min<std::uint64_t> ( sectionSize, size_ - offset );
+				section.executable = ( flags & sectionExecute ) != 0;
+				sections_.push_back ( section );
+			}
+
+			return true;
+		}
+
+		const std::uint8_t* data_ = nullptr;
+		std::size_t size_ = 0;
+		Format format_ = Format::Unknown;
+		std::uint64_t imageBase_ = 0;
+		std::uint32_t exceptionDirectory_ = 0;
+		std::uint32_t exceptionDirectorySize_ = 0;
+		std::vector<ImageSection> sections_;
+	};
+
+	/// Half-open address range [begin, end) of one function
+	struct Function {
+		std::uint64_t begin;
+		std::uint64_t end;
+	};
+
+	/// <summary>
+	///  Sorted function ranges taken from unwind metadata: .pdata RUNTIME_FUNCTIONs for x64 PE
+	///  and .eh_frame FDEs for ELF. Exact boundaries, no prologue heuristics.
+	/// </summary>
+	class FunctionTable {
+	public:
+		FunctionTable ( ) = default;
+		explicit FunctionTable ( const ImageView& image ) { load ( image ); }
+
+		/// <returns>false if the image carries no usable unwind metadata</returns>
+		bool load ( const ImageView& image ) {
+			functions_.clear ( );
+			switch ( image.format ( ) ) {
+				case ImageView::Format::Pe:
+					load_pdata ( image );
+					break;
+				case ImageView::Format::Elf:
+					load_eh_frame ( image );
+					break;
+				default:
+					break;
+			}
+
+			std::sort ( functions_.begin ( ), functions_.end ( ), [ ] ( const Function& lhs, const Function& rhs ) {
+				return lhs.begin < rhs.begin || ( lhs.begin == rhs.begin && lhs.end > rhs.end );
+			} );
+			functions_.erase ( std::unique ( functions_.begin ( ), functions_.end ( ), [ ] ( const Function& lhs, const Function& rhs ) {
+				return lhs.begin == rhs.begin;
+			} ), functions_.end ( ) );
+			return !functions_.empty ( );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return functions_.size ( ); }
+		NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return functions_.empty ( ); }
+		NODISCARD FORCE_INLINE const Function& operator[]( std::size_t index ) const noexcept { return functions_ [ index ]; }
+		NODISCARD FORCE_INLINE std::vector<Function>::const_iterator begin ( ) const noexcept { return functions_.begin ( ); }
+		NODISCARD FORCE_INLINE std::vector<Function>::const_iterator end ( ) const noexcept { return functions_.end ( ); }
+
+		/// <returns>The function containing `address`, or nullptr</returns>
+		NODISCARD const Function* find ( std::uint64_t address ) const noexcept {
+			const auto it = std::upper_bound ( functions_.begin ( ), functions_.end ( ), address, [ ] ( std::uint64_t value, const Function& rhs ) {
+				return value < rhs.begin;
+			} );
+			if ( it == functions_.begin ( ) ) {
+				return nullptr;
+			}
+
+			const auto& function = *( it - 1 );
+			return address < function.end ? &function : nullptr;
+		}
+
+	private:
+		void load_pdata ( const ImageView& image ) {
+			const auto rva = image.exception_directory ( );
+			std::size_t available = 0;
+			const auto* entries = image.bytes_at ( image.image_base ( ) + rva, available );
+			if ( !rva || !entries ) {
+				return;
+			}
+
+			// RUNTIME_FUNCTION { BeginAddress, EndAddress, UnwindInfoAddress }, all RVAs
+			const auto count = std::min<std::size_t> ( image.exception_directory_size ( ), available ) / 12;
+			functions_.reserve ( count );
+			for ( std::size_t index = 0; index < count; ++index ) {
+				std::uint32_t begin = 0, end = 0;
+				std::memcpy ( &begin, entries + index * 12, sizeof ( begin ) );
+				std::memcpy ( &end, entries + index * 12 + 4, sizeof ( end ) );
+				if ( begin < end ) {
+					functions_.push_back ( { image.image_base ( ) + begin, image.image_base ( ) + end } );
+				}
+			}
+		}
+
+		/// Sequential reader over one .eh_frame record
+		struct FrameReader {
+			const std::uint8_t* data;
+			std::size_t size;
+			std::size_t offset;
+			std::uint64_t address; // virtual address of data [ 0 ]
+
+			template<typename T>
+			bool fixed ( T& value ) noexcept {
+				if ( size - offset < sizeof ( T ) ) {
+					return false;
+				}
+				std::memcpy ( &value, data + offset, sizeof ( T ) );
+				offset += sizeof ( T );
+				return true;
+			}
+
+			/// Reads a T and sign- or zero-extends it to 64 bits
+			template<typename T>
+			bool fixed_as ( std::uint64_t& value ) noexcept {
+				T raw;
+				if ( !fixed ( raw ) ) {
+					return false;
+				}
+				value = static_cast< std::uint64_t >( static_cast< std::int64_t >( raw ) );
+				return true;
+			}
+
+			bool uleb ( std::uint64_t& value ) noexcept {
+				value = 0;
+				for ( std::uint32_t shift = 0; offset < size; shift += 7 ) {
+					const auto byte = data [ offset++ ];
+					if ( shift < 64 ) {
+						value |= static_cast< std::uint64_t >( byte & 0x7F ) << shift;
+					}
+					if ( !( byte & 0x80 ) ) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool sleb ( std::int64_t& value ) noexcept {
+				std::uint64_t result = 0;
+				std::uint32_t shift = 0;
+				while ( offset < size ) {
+					const auto byte = data [ offset++ ];
+					if ( shift < 64 ) {
+						result |= static_cast< std::uint64_t >( byte & 0x7F ) << shift;
+					}
+					shift += 7;
+					if ( !( byte & 0x80 ) ) {
+						if ( shift < 64 && ( byte & 0x40 ) ) {
+							result |= ~0ULL << shift;
+						}
+						value = static_cast< std::int64_t >( result );
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/// Reads a DW_EH_PE encoded pointer; indirect and data/text-relative forms are not resolved
+			bool pointer ( std::uint8_t encoding, std::uint64_t& value ) noexcept {
+				if ( encoding == 0xFF ) {
+					return false;
+				}
+
+				const auto start = address + offset;
+				bool ok = false;
+				switch ( encoding & 0x0F ) {
+					case 0x00:
+					case 0x04:
+					case 0x0C:
+						ok = fixed_as<std::uint64_t> ( value );
+						break;
+					case 0x01:
+						ok = uleb ( value );
+						break;
+					case 0x02:
+						ok = fixed_as<std::uint16_t> ( value );
+						break;
+					case 0x03:
+						ok = fixed_as<std::uint32_t> ( value );
+						break;
+					case 0x09: {
+						std::int64_t raw = 0;
+						ok = sleb ( raw );
+						value = static_cast< std::uint64_t >( raw );
+						break;
+					}
+					case 0x0A:
+						ok = fixed_as<std::int16_t> ( value );
+						break;
+					case 0x0B:
+						ok = fixed_as<std::int32_t> ( value );
+						break;
+					default:
+						break;
+				}
+
+				if ( !ok ) {
+					return false;
+				}
+
+				if ( ( encoding & 0x70 ) == 0x10 ) {
+					value += start;
+				}
+				return true;
+			}
+		};
+
+		/// <returns>The FDE pointer encoding of the CIE at `offset`, or 0xFF if it cannot be used</returns>
+		static std::uint8_t cie_encoding ( const std::uint8_t* data, std::size_t size, std::size_t offset, std::uint64_t address ) noexcept {
+			std::uint32_t length = 0, id = 0;
+			if ( offset > size || size - offset < 8 ) {
+				return 0xFF;
+			}
+			std::memcpy ( &length, data + offset, sizeof ( length ) );
+			if ( length == 0xFFFFFFFF || length < 4 || size - offset - 4 < length ) {
+				return 0xFF;
+			}
+			std::memcpy ( &id, data + offset + 4, sizeof ( id ) );
+			if ( id != 0 ) {
+				return 0xFF;
+			}
+
+			FrameReader reader { data, offset + 4 + length, offset + 8, address };
+			std::uint8_t version = 0;
+			if ( !reader.fixed ( version ) ) {
+				return 0xFF;
+			}
+
+			const auto* augmentation = reinterpret_cast< const char* >( data + reader.offset );
+			const auto augmentationLength = static_cast< std::size_t >( std::find ( augmentation, augmentation + ( reader.size - reader.offset ), '\0' ) - augmentation );
+			reader.offset += augmentationLength + 1;
+			if ( reader.offset > reader.size ) {
+				return 0xFF;
+			}
+
+			std::uint64_t codeAlignment = 0, returnRegister = 0;
+			std::int64_t dataAlignment = 0;
+			if ( !reader.uleb ( codeAlignment ) || !reader.sleb ( dataAlignment ) ) {
+				return 0xFF;
+			}
+			if ( version == 1 ) {
+				std::uint8_t raw = 0;
+				if ( !reader.fixed ( raw ) ) {
+					return 0xFF;
+				}
+			}
+			else if ( !reader.uleb ( returnRegister ) ) {
+				return 0xFF;
+			}
+
+			std::uint8_t encoding = 0; // DW_EH_PE_absptr unless 'R' says otherwise
+			if ( !augmentationLength || augmentation [ 0 ] != 'z' ) {
+				return augmentationLength ? 0xFF : encoding;
+			}
+
+			std::uint64_t dataLength = 0;
+			if ( !reader.uleb ( dataLength ) ) {
+				return 0xFF;
+			}
+
+			for ( std::size_t index = 1; index < augmentationLength; ++index ) {
+				switch ( augmentation [ index ] ) {
+					case 'R':
+						if ( !reader.fixed ( encoding ) ) {
+							return 0xFF;
+						}
+						break;
+					case 'P': {
+						std::uint8_t personalityEncoding = 0;
+						std::uint64_t personality = 0;
+						if ( !reader.fixed ( personalityEncoding ) || !reader.pointer ( personalityEncoding & 0x7F, personality ) ) {
+							return 0xFF;
+						}
+						break;
+					}
+					case 'L': {
+						std::uint8_t lsdaEncoding = 0;
+						if ( !reader.fixed ( lsdaEncoding ) ) {
+							return 0xFF;
+						}
+						break;
+					}
+					case 'S':
+					case 'B':
+						break;
+					default:
+						return encoding; // Remaining augmentation data is not needed for the pointer encoding
+				}
+			}
+
+			return encoding;
+		}
+
+		void load_eh_frame ( const ImageView& image ) {
+			const auto* section = image.find_section ( ".eh_frame" );
+			if ( !section || !section->fileSize ) {
+				return;
+			}
+
+			const auto* data = image.data ( ) + section->fileOffset;
+			const auto size = static_cast< std::size_t >( section->fileSize );
+
+			std::size_t cachedCie = ~static_cast< std::size_t >( 0 );
+			std::uint8_t cachedEncoding = 0xFF;
+
+			for ( std::size_t offset = 0; size - offset >= 4; ) {
+				std::uint32_t length = 0;
+				std::memcpy ( &length, data + offset, sizeof ( length ) );
+				if ( length == 0 ) {
+					break;
+				}
+
+				// 64-bit DWARF records are not emitted for .eh_frame by common toolchains
+				if ( length == 0xFFFFFFFF || length < 4 || size - offset - 4 < length ) {
+					break;
+				}
+
+				const auto end = offset + 4 + length;
+				std::uint32_t id = 0;
+				std::memcpy ( &id, data + offset + 4, sizeof ( id ) );
+				if ( id != 0 && id <= offset + 4 ) {
+					const auto cie = offset + 4 - id;
+					if ( cie != cachedCie ) {
+						cachedCie = cie;
+						cachedEncoding = cie_encoding ( data, size, cie, section->address );
+					}
+
+					FrameReader reader { data, end, offset + 8, section->address };
+					std::uint64_t begin = 0, range = 0;
+					if ( cachedEncoding != 0xFF && reader.pointer ( cachedEncoding, begin ) && reader.pointer ( cachedEncoding & 0x0F, range ) && range ) {
+						functions_.push_back ( { begin, begin + range } );
+					}
+				}
+
+				offset = end;
+			}
+		}
+
+		std::vector<Function> functions_;
+	};
+
+	/// <summary>
+	///  Decodes every function on its own task, `threads` at a time (0 = all hardware threads).
+	///  callback ( index, function, decoder ) runs on a worker thread with a decoder positioned
+	///  at the function start and limited to its bytes; functions outside the file are skipped.
+	/// </summary>
+	template<typename DecoderType = ReleaseDecoder, typename Callback>
+	void decode_functions ( const ImageView& image, const FunctionTable& functions, Callback&& callback, std::size_t threads = 0 ) {
+		parallel_for ( functions.size ( ), threads, [ & ] ( std::size_t index ) {
+			const auto& function = functions [ index ];
+
+			std::size_t available = 0;
+			const auto* bytes = image.bytes_at ( function.begin, available );
+			if ( !bytes ) {
+				return;
+			}
+
+			const auto size = std::min<std::uint64_t> ( available, function.end - function.begin );
+			DecoderType decoder ( bytes, static_cast< std::size_t >( size ), function.begin );
+			callback ( index, function, decoder );
+		} );
+	}
+};
+#endif
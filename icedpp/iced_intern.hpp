@@ -0,0 +1,299 @@
+#pragma once
+#ifndef __ICED_INTERN_DEF
+#define __ICED_INTERN_DEF
+
+#include "iced.hpp"
+#include "iced_cache.hpp"
+#include "iced_hash.hpp"
+#include "iced_parallel.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace iced
+{
+	/// Up to 15 instruction bytes and their count packed into 16 bytes
+	struct InternKey {
+		std::uint64_t low;
+		std::uint64_t high; // bytes 8..14, length in the top byte
+
+		InternKey ( ) noexcept : low ( 0 ), high ( 0 ) { }
+		InternKey ( const std::uint8_t* bytes, std::size_t length ) noexcept : low ( 0 ), high ( 0 ) {
+			std::memcpy ( &low, bytes, std::min<std::size_t> ( length, 8 ) );
+			if ( length > 8 ) {
+				std::memcpy ( &high, bytes + 8, length - 8 );
+			}
+			high |= static_cast< std::uint64_t >( length ) << 56;
+		}
+
+		NODISCARD FORCE_INLINE std::uint64_t hash ( ) const noexcept { return hash::mix ( low ^ hash::prime1, high ^ hash::prime2 ); }
+		NODISCARD FORCE_INLINE bool operator==( const InternKey& other ) const noexcept { return low == other.low && high == other.high; }
+	};
+
+	/// <summary>
+	///  Concurrent store of unique instruction encodings. Each distinct byte sequence keeps one
+	///  canonical record and a dense 32-bit id, so a listing only needs (ip, id) per instruction.
+	///  Records hold branch and RIP-relative displacements rather than targets, which makes one
+	///  record valid at every address its bytes occur at; ip_relative ( id ) tells which ones
+	///  need the ip to resolve. Lookups lock one of `shardCount` shards; records live in
+	///  fixed segments, so ids and record references stay valid while the table grows.
+	/// </summary>
+	class InternTable {
+		using Record = __iced_internal::IcedInstructionRecord;
+
+		struct KeyHash {
+			NODISCARD FORCE_INLINE std::size_t operator()( const InternKey& key ) const noexcept { return static_cast< std::size_t >( key.hash ( ) ); }
+		};
+
+		struct alignas( 64 ) Shard {
+			std::mutex lock;
+			std::unordered_map<InternKey, std::uint32_t, KeyHash> ids;
+		};
+
+	public:
+		static constexpr std::size_t shardCount = 64;
+		static constexpr std::size_t segmentSize = 1 << 14;
+		static constexpr std::size_t maxSegments = 16384;
+		static constexpr std::uint32_t invalid = ~std::uint32_t { 0 };
+
+		InternTable ( ) : shards_ ( new Shard [ shardCount ] ), segments_ ( new std::atomic<Record*> [ maxSegments ] ) {
+			for ( std::size_t segment = 0; segment < maxSegments; ++segment ) {
+				segments_ [ segment ].store ( nullptr, std::memory_order_relaxed );
+			}
+		}
+
+		InternTable ( const InternTable& ) = delete;
+		InternTable& operator=( const InternTable& ) = delete;
+
+		~InternTable ( ) {
+			for ( std::size_t segment = 0; segment < maxSegments; ++segment ) {
+				delete [ ] segments_ [ segment ].load ( std::memory_order_relaxed );
+			}
+		}
+
+		/// <summary>
+		///  Id of the encoding `bytes` [0, record.length), storing `record` if it is new
+		/// </summary>
+		/// <returns>invalid once 2^28 unique encodings are stored</returns>
+		NODISCARD std::uint32_t intern ( const std::uint8_t* bytes, const Record& record ) {
+			const InternKey key ( bytes, record.length );
+			return intern ( key, key.hash ( ), record );
+		}
+
+		NODISCARD std::uint32_t intern ( const std::uint8_t* bytes, const Instruction& instruction ) {
+			Record record;
+			std::memcpy ( &record, &instruction.record ( ), sizeof ( record ) );
+			return intern ( bytes, record );
+		}
+
+		/// Same as intern ( bytes, record ) with the key and its hash already computed
+		NODISCARD std::uint32_t intern ( const InternKey& key, std::uint64_t hash, const Record& record ) {
+			auto& shard = shards_ [ hash >> 58 ];
+			std::lock_guard<std::mutex> guard ( shard.lock );
+			const auto it = shard.ids.find ( key );
+			if ( it != shard.ids.end ( ) ) {
+				return it->second;
+			}
+
+			const auto id = next_.fetch_add ( 1, std::memory_order_relaxed );
+			if ( id >= segmentSize * maxSegments ) {
+				next_.fetch_sub ( 1, std::memory_order_relaxed );
+				return invalid;
+			}
+
+			segment ( id / segmentSize ) [ id % segmentSize ] = record;
+			shard.ids.emplace ( key, static_cast< std::uint32_t >( id ) );
+			return static_cast< std::uint32_t >( id );
+		}
+
+		NODISCARD FORCE_INLINE const Record& record ( std::uint32_t id ) const noexcept {
+			return segments_ [ id / segmentSize ].load ( std::memory_order_acquire ) [ id % segmentSize ];
+		}
+
+		NODISCARD FORCE_INLINE CachedInstruction instruction ( std::uint32_t id, std::uint64_t ip ) const noexcept {
+			return CachedInstruction ( record ( id ), ip );
+		}
+
+		/// Whether the record is relative to its address: RIP-relative memory or a near branch
+		NODISCARD bool ip_relative ( std::uint32_t id ) const noexcept {
+			const auto& entry = record ( id );
+			if ( entry.mem_base == Register::RIP ) {
+				return true;
+			}
+			for ( std::size_t index = 0; index < entry.operand_count_visible && index < 4; ++index ) {
+				if ( opkind_map_to_simple ( entry.types [ index ] ) == OpKindSimple::NearBranch ) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// Number of unique encodings
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return next_.load ( std::memory_order_acquire ); }
+
+		/// Approximate bytes held by records and lookup tables
+		NODISCARD std::size_t memory_usage ( ) const noexcept {
+			const auto count = size ( );
+			const auto segments = ( count + segmentSize - 1 ) / segmentSize;
+			return segments * segmentSize * sizeof ( Record ) + count * ( sizeof ( InternKey ) + 2 * sizeof ( void* ) + sizeof ( std::uint64_t ) ) +
+				maxSegments * sizeof ( void* ) + shardCount * sizeof ( Shard );
+		}
+
+	private:
+		/// Allocates a segment on first use; a thread losing the race frees its copy
+		Record* segment ( std::size_t index ) {
+			auto* current = segments_ [ index ].load ( std::memory_order_acquire );
+			if ( current ) {
+				return current;
+			}
+
+			auto* created = new Record [ segmentSize ];
+			if ( !segments_ [ index ].compare_exchange_strong ( current, created, std::memory_order_acq_rel ) ) {
+				delete [ ] created;
+				return current;
+			}
+			return created;
+		}
+
+		std::unique_ptr<Shard [ ]> shards_;
+		std::unique_ptr<std::atomic<Record*> [ ]> segments_;
+		std::atomic<std::size_t> next_ { 0 };
+	};
+
+	/// <summary>
+	///  Direct-mapped per-thread cache in front of an InternTable. Repeated encodings, the
+	///  common case in handler-heavy code, are resolved without touching the shared shards.
+	/// </summary>
+	class InternCache {
+	public:
+		static constexpr std::size_t slotCount = 1024;
+
+		explicit InternCache ( InternTable& table ) noexcept : table_ ( &table ) {
+			for ( auto& slot : slots_ ) {
+				slot = { InternKey ( ), InternTable::invalid };
+			}
+		}
+
+		NODISCARD std::uint32_t intern ( const std::uint8_t* bytes, const __iced_internal::IcedInstructionRecord& record ) {
+			return resolve ( bytes, record );
+		}
+
+		NODISCARD std::uint32_t intern ( const std::uint8_t* bytes, const Instruction& instruction ) {
+			return resolve ( bytes, instruction.record ( ) );
+		}
+
+	private:
+		struct Slot {
+			InternKey key;
+			std::uint32_t id;
+		};
+
+		/// `source` is a record or a full IcedInstruction, whose first bytes are the record; it is only copied on a miss
+		template<typename Source>
+		NODISCARD std::uint32_t resolve ( const std::uint8_t* bytes, const Source& source ) {
+			const InternKey key ( bytes, source.length );
+			const auto hash = key.hash ( );
+			auto& slot = slots_ [ hash % slotCount ];
+			if ( slot.id != InternTable::invalid && slot.key == key ) {
+				return slot.id;
+			}
+
+			__iced_internal::IcedInstructionRecord record;
+			std::memcpy ( &record, &source, sizeof ( record ) );
+			slot = { key, table_->intern ( key, hash, record ) };
+			return slot.id;
+		}
+
+		InternTable* table_;
+		std::array<Slot, slotCount> slots_;
+	};
+
+	/// <summary>
+	///  Linear sweep stored as 32-bit offsets and intern ids: 8 bytes per instruction instead of
+	///  a 48-byte record and its address. Instructions are views into the shared InternTable,
+	///  which has to outlive the listing.
+	/// </summary>
+	class InternedListing {
+	public:
+		InternedListing ( ) = default;
+
+		/// <summary>
+		///  Sweeps `code` on up to `threads` threads, interning into `table`
+		/// </summary>
+		/// <returns>false if the code exceeds 4GB or the table is full</returns>
+		bool build ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, InternTable& table, std::size_t threads = 0 ) {
+			clear ( );
+			table_ = &table;
+			baseAddr_ = baseAddress;
+			if ( !code || !size || size > 0xFFFFFFFFULL ) {
+				return !size;
+			}
+
+			std::vector<Collector> collectors ( worker_count ( threads ), Collector ( table, code, baseAddress ) );
+			parallel_sweep ( code, size, baseAddress, collectors );
+
+			std::size_t total = 0;
+			for ( const auto& collector : collectors ) {
+				total += collector.offsets.size ( );
+			}
+			offsets_.reserve ( total );
+			ids_.reserve ( total );
+			for ( const auto& collector : collectors ) {
+				offsets_.insert ( offsets_.end ( ), collector.offsets.begin ( ), collector.offsets.end ( ) );
+				ids_.insert ( ids_.end ( ), collector.ids.begin ( ), collector.ids.end ( ) );
+			}
+			return std::find ( ids_.begin ( ), ids_.end ( ), InternTable::invalid ) == ids_.end ( );
+		}
+
+		void clear ( ) noexcept {
+			offsets_.clear ( );
+			ids_.clear ( );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return ids_.size ( ); }
+		NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return ids_.empty ( ); }
+		NODISCARD FORCE_INLINE std::uint64_t ip ( std::size_t index ) const noexcept { return baseAddr_ + offsets_ [ index ]; }
+		NODISCARD FORCE_INLINE std::uint32_t id ( std::size_t index ) const noexcept { return ids_ [ index ]; }
+		NODISCARD FORCE_INLINE const InternTable& table ( ) const noexcept { return *table_; }
+		NODISCARD FORCE_INLINE CachedInstruction operator[]( std::size_t index ) const noexcept {
+			return table_->instruction ( ids_ [ index ], ip ( index ) );
+		}
+
+		/// Bytes held by the listing itself, excluding the shared table
+		NODISCARD FORCE_INLINE std::size_t memory_usage ( ) const noexcept {
+			return offsets_.capacity ( ) * sizeof ( std::uint32_t ) + ids_.capacity ( ) * sizeof ( std::uint32_t );
+		}
+
+	private:
+		struct Collector {
+			Collector ( InternTable& table, const std::uint8_t* code_, std::uint64_t baseAddress ) noexcept
+				: cache ( table ), code ( code_ ), baseAddr ( baseAddress ) { }
+
+			InternCache cache;
+			const std::uint8_t* code;
+			std::uint64_t baseAddr;
+			std::vector<std::uint32_t> offsets;
+			std::vector<std::uint32_t> ids;
+
+			void operator()( const Instruction& instruction ) {
+				const auto offset = static_cast< std::uint32_t >( instruction.ip - baseAddr );
+				offsets.push_back ( offset );
+				ids.push_back ( cache.intern ( code + offset, instruction ) );
+			}
+
+			void discard_before ( std::uint64_t ip ) {
+				const auto end = std::lower_bound ( offsets.begin ( ), offsets.end ( ), static_cast< std::uint32_t >( ip - baseAddr ) );
+				ids.erase ( ids.begin ( ), ids.begin ( ) + ( end - offsets.begin ( ) ) );
+				offsets.erase ( offsets.begin ( ), end );
+			}
+		};
+
+		const InternTable* table_ = nullptr;
+		std::uint64_t baseAddr_ = 0;
+		std::vector<std::uint32_t> offsets_;
+		std::vector<std::uint32_t> ids_;
+	};
+};
+#endif
@@ -1,6 +1,7 @@
 #ifndef __ICEDINT_DEF
 #define __ICEDINT_DEF
 #include <cstdint>
+#include <cstddef>
 
 enum class Mnemonic : uint16_t {
   INVALID = 0,
@@ -2216,13 +2217,78 @@ enum class FlowControl {
   Exception = 9,
 };
 
+enum class RegisterClass : uint8_t {
+  None,
+  Gpr8,
+  Gpr16,
+  Gpr32,
+  Gpr64,
+  Ip,
+  Segment,
+  Xmm,
+  Ymm,
+  Zmm,
+  K,
+  Bnd,
+  Cr,
+  Dr,
+  St,
+  Mm,
+  Tr,
+  Tmm,
+};
+
 struct IcedAttribute {
   uint8_t rep : 1;
   uint8_t repne : 1; 
   uint8_t lock : 1;
+  uint8_t stack_positive : 1; // stack_growth is an increment of RSP (pop, ret), not a decrement
+  uint8_t reserved : 4;
+};
+
+/// Same values as iced's RoundingControl
+enum class RoundingControl : uint8_t {
+  None,
+  RoundToNearest,
+  RoundDown,
+  RoundUp,
+  RoundTowardZero,
+};
+
+/// EVEX and VSIB details; the opmask register and rounding control are separate fields
+struct IcedVectorAttribute {
+  uint8_t zeroing : 1;
+  uint8_t sae : 1;
+  uint8_t vsib : 1;
   uint8_t reserved : 5;
 };
 
+/// <summary>
+///  iced's Code: the exact encoding (opcode, operand forms and prefixes), a finer split than
+///  Mnemonic. Values follow the iced-x86 version the Rust library is built with; only
+///  INVALID is named here, use it as a dense index (below codeTableSize) for dispatch tables.
+/// </summary>
+enum class Code : uint16_t {
+  INVALID = 0,
+};
+
+/// Bitmask of the ISA extension groups an instruction's CPUID features fall in
+enum class CpuidGroup : uint8_t {
+  None = 0,
+  General = 0x01, // base x86-64 and the general purpose extensions (BMI, ADX, ...)
+  X87 = 0x02,
+  Mmx = 0x04,     // MMX and 3DNow!
+  Sse = 0x08,     // SSE through SSE4.2, AES, PCLMULQDQ, SHA, GFNI
+  Avx = 0x10,     // AVX, AVX2, FMA, F16C, XOP and the other VEX extensions
+  Avx512 = 0x20,
+  Amx = 0x40,
+  System = 0x80,  // virtualization and enclaves: VMX, SVM, SMX, SGX, TDX, SEV
+};
+
+constexpr CpuidGroup operator|( CpuidGroup lhs, CpuidGroup rhs ) noexcept {
+  return static_cast< CpuidGroup >( static_cast< uint8_t >( lhs ) | static_cast< uint8_t >( rhs ) );
+}
+
 namespace __iced_internal
 {
   struct IcedInstruction {
@@ -2243,6 +2309,11 @@ namespace __iced_internal
     };
     Register segment_prefix;
     bool is_broadcast;
+    Register op_mask;
+    RoundingControl rounding;
+    IcedVectorAttribute vector;
+    CpuidGroup cpuid_groups;
+    Code code;
     char text[64];
   };
 
@@ -2258,5 +2329,845 @@ namespace __iced_internal
   static_assert( offsetof ( IcedInstruction, operand_count_visible ) == 16, "invalid offset" );
   static_assert( offsetof ( IcedInstruction, immediate ) == 24, "invalid offset" );
   static_assert( offsetof ( IcedInstruction, immediate2 ) == 32, "invalid offset" );
+  static_assert( offsetof ( IcedInstruction, op_mask ) == 42, "invalid offset" );
+  static_assert( offsetof ( IcedInstruction, vector ) == 44, "invalid offset" );
+  static_assert( offsetof ( IcedInstruction, code ) == 46, "invalid offset" );
+  static_assert( offsetof ( IcedInstruction, text ) == 48, "invalid offset" );
+
+  /// IcedInstruction without the formatted text, as written by `disas`
+  struct IcedInstructionRecord {
+    Mnemonic mnemonic;
+    Register mem_base;
+    Register mem_index;
+    uint8_t mem_scale;
+    uint8_t stack_growth;
+    Register regs [ 4 ];
+    OpKind types [ 4 ];
+    IcedAttribute attributes;
+    uint8_t length;
+    uint8_t operand_count_visible;
+    uint64_t immediate;
+    union {
+      uint64_t mem_disp;
+      uint64_t immediate2;
+    };
+    Register segment_prefix;
+    bool is_broadcast;
+    Register op_mask;
+    RoundingControl rounding;
+    IcedVectorAttribute vector;
+    CpuidGroup cpuid_groups;
+    Code code;
+  };
+
+  static_assert( sizeof ( IcedInstructionRecord ) == 48, "invalid size" );
+  static_assert( offsetof ( IcedInstructionRecord, immediate ) == offsetof ( IcedInstruction, immediate ), "invalid offset" );
+  static_assert( offsetof ( IcedInstructionRecord, is_broadcast ) == offsetof ( IcedInstruction, is_broadcast ), "invalid offset" );
+  static_assert( offsetof ( IcedInstructionRecord, vector ) == offsetof ( IcedInstruction, vector ), "invalid offset" );
+  static_assert( offsetof ( IcedInstructionRecord, code ) == offsetof ( IcedInstruction, code ), "invalid offset" );
+
+  /// Register metadata, generated from iced's RegisterInfo (full_register, size, number, kind)
+  struct IcedRegisterInfo {
+    Register base;
+    Register full;
+    Register full32;
+    uint8_t number;
+    RegisterClass kind;
+    uint8_t reserved;
+    uint16_t size;
+  };
+
+  static_assert( sizeof ( IcedRegisterInfo ) == 8, "invalid size" );
+
+  inline constexpr IcedRegisterInfo registerInfo [ 256 ] = {
+    { Register::None, Register::None, Register::None, 0, RegisterClass::None, 0, 0 }, // None
+    { Register::AL, Register::RAX, Register::EAX, 0, RegisterClass::Gpr8, 0, 1 }, // AL
+    { Register::AL, Register::RCX, Register::ECX, 1, RegisterClass::Gpr8, 0, 1 }, // CL
+    { Register::AL, Register::RDX, Register::EDX, 2, RegisterClass::Gpr8, 0, 1 }, // DL
+    { Register::AL, Register::RBX, Register::EBX, 3, RegisterClass::Gpr8, 0, 1 }, // BL
+    { Register::AL, Register::RAX, Register::EAX, 4, RegisterClass::Gpr8, 0, 1 }, // AH
+    { Register::AL, Register::RCX, Register::ECX, 5, RegisterClass::Gpr8, 0, 1 }, // CH
+    { Register::AL, Register::RDX, Register::EDX, 6, RegisterClass::Gpr8, 0, 1 }, // DH
+    { Register::AL, Register::RBX, Register::EBX, 7, RegisterClass::Gpr8, 0, 1 }, // BH
+    { Register::AL, Register::RSP, Register::ESP, 8, RegisterClass::Gpr8, 0, 1 }, // SPL
+    { Register::AL, Register::RBP, Register::EBP, 9, RegisterClass::Gpr8, 0, 1 }, // BPL
+    { Register::AL, Register::RSI, Register::ESI, 10, RegisterClass::Gpr8, 0, 1 }, // SIL
+    { Register::AL, Register::RDI, Register::EDI, 11, RegisterClass::Gpr8, 0, 1 }, // DIL
+    { Register::AL, Register::R8, Register::R8D, 12, RegisterClass::Gpr8, 0, 1 }, // R8L
+    { Register::AL, Register::R9, Register::R9D, 13, RegisterClass::Gpr8, 0, 1 }, // R9L
+    { Register::AL, Register::R10, Register::R10D, 14, RegisterClass::Gpr8, 0, 1 }, // R10L
+    { Register::AL, Register::R11, Register::R11D, 15, RegisterClass::Gpr8, 0, 1 }, // R11L
+    { Register::AL, Register::R12, Register::R12D, 16, RegisterClass::Gpr8, 0, 1 }, // R12L
+    { Register::AL, Register::R13, Register::R13D, 17, RegisterClass::Gpr8, 0, 1 }, // R13L
+    { Register::AL, Register::R14, Register::R14D, 18, RegisterClass::Gpr8, 0, 1 }, // R14L
+    { Register::AL, Register::R15, Register::R15D, 19, RegisterClass::Gpr8, 0, 1 }, // R15L
+    { Register::AX, Register::RAX, Register::EAX, 0, RegisterClass::Gpr16, 0, 2 }, // AX
+    { Register::AX, Register::RCX, Register::ECX, 1, RegisterClass::Gpr16, 0, 2 }, // CX
+    { Register::AX, Register::RDX, Register::EDX, 2, RegisterClass::Gpr16, 0, 2 }, // DX
+    { Register::AX, Register::RBX, Register::EBX, 3, RegisterClass::Gpr16, 0, 2 }, // BX
+    { Register::AX, Register::RSP, Register::ESP, 4, RegisterClass::Gpr16, 0, 2 }, // SP
+    { Register::AX, Register::RBP, Register::EBP, 5, RegisterClass::Gpr16, 0, 2 }, // BP
+    { Register::AX, Register::RSI, Register::ESI, 6, RegisterClass::Gpr16, 0, 2 }, // SI
+    { Register::AX, Register::RDI, Register::EDI, 7, RegisterClass::Gpr16, 0, 2 }, // DI
+    { Register::AX, Register::R8, Register::R8D, 8, RegisterClass::Gpr16, 0, 2 }, // R8W
+    { Register::AX, Register::R9, Register::R9D, 9, RegisterClass::Gpr16, 0, 2 }, // R9W
+    { Register::AX, Register::R10, Register::R10D, 10, RegisterClass::Gpr16, 0, 2 }, // R10W
+    { Register::AX, Register::R11, Register::R11D, 11, RegisterClass::Gpr16, 0, 2 }, // R11W
+    { Register::AX, Register::R12, Register::R12D, 12, RegisterClass::Gpr16, 0, 2 }, // R12W
+    { Register::AX, Register::R13, Register::R13D, 13, RegisterClass::Gpr16, 0, 2 }, // R13W
+    { Register::AX, Register::R14, Register::R14D, 14, RegisterClass::Gpr16, 0, 2 }, // R14W
+    { Register::AX, Register::R15, Register::R15D, 15, RegisterClass::Gpr16, 0, 2 }, // R15W
+    { Register::EAX, Register::RAX, Register::EAX, 0, RegisterClass::Gpr32, 0, 4 }, // EAX
+    { Register::EAX, Register::RCX, Register::ECX, 1, RegisterClass::Gpr32, 0, 4 }, // ECX
+    { Register::EAX, Register::RDX, Register::EDX, 2, RegisterClass::Gpr32, 0, 4 }, // EDX
+    { Register::EAX, Register::RBX, Register::EBX, 3, RegisterClass::Gpr32, 0, 4 }, // EBX
+    { Register::EAX, Register::RSP, Register::ESP, 4, RegisterClass::Gpr32, 0, 4 }, // ESP
+    { Register::EAX, Register::RBP, Register::EBP, 5, RegisterClass::Gpr32, 0, 4 }, // EBP
+    { Register::EAX, Register::RSI, Register::ESI, 6, RegisterClass::Gpr32, 0, 4 }, // ESI
+    { Register::EAX, Register::RDI, Register::EDI, 7, RegisterClass::Gpr32, 0, 4 }, // EDI
+    { Register::EAX, Register::R8, Register::R8D, 8, RegisterClass::Gpr32, 0, 4 }, // R8D
+    { Register::EAX, Register::R9, Register::R9D, 9, RegisterClass::Gpr32, 0, 4 }, // R9D
+    { Register::EAX, Register::R10, Register::R10D, 10, RegisterClass::Gpr32, 0, 4 }, // R10D
+    { Register::EAX, Register::R11, Register::R11D, 11, RegisterClass::Gpr32, 0, 4 }, // R11D
+    { Register::EAX, Register::R12, Register::R12D, 12, RegisterClass::Gpr32, 0, 4 }, // R12D
+    { Register::EAX, Register::R13, Register::R13D, 13, RegisterClass::Gpr32, 0, 4 }, // R13D
+    { Register::EAX, Register::R14, Register::R14D, 14, RegisterClass::Gpr32, 0, 4 }, // R14D
+    { Register::EAX, Register::R15, Register::R15D, 15, RegisterClass::Gpr32, 0, 4 }, // R15D
+    { Register::RAX, Register::RAX, Register::EAX, 0, RegisterClass::Gpr64, 0, 8 }, // RAX
+    { Register::RAX, Register::RCX, Register::ECX, 1, RegisterClass::Gpr64, 0, 8 }, // RCX
+    { Register::RAX, Register::RDX, Register::EDX, 2, RegisterClass::Gpr64, 0, 8 }, // RDX
+    { Register::RAX, Register::RBX, Register::EBX, 3, RegisterClass::Gpr64, 0, 8 }, // RBX
+    { Register::RAX, Register::RSP, Register::ESP, 4, RegisterClass::Gpr64, 0, 8 }, // RSP
+    { Register::RAX, Register::RBP, Register::EBP, 5, RegisterClass::Gpr64, 0, 8 }, // RBP
+    { Register::RAX, Register::RSI, Register::ESI, 6, RegisterClass::Gpr64, 0, 8 }, // RSI
+    { Register::RAX, Register::RDI, Register::EDI, 7, RegisterClass::Gpr64, 0, 8 }, // RDI
+    { Register::RAX, Register::R8, Register::R8D, 8, RegisterClass::Gpr64, 0, 8 }, // R8
+    { Register::RAX, Register::R9, Register::R9D, 9, RegisterClass::Gpr64, 0, 8 }, // R9
+    { Register::RAX, Register::R10, Register::R10D, 10, RegisterClass::Gpr64, 0, 8 }, // R10
+    { Register::RAX, Register::R11, Register::R11D, 11, RegisterClass::Gpr64, 0, 8 }, // R11
+    { Register::RAX, Register::R12, Register::R12D, 12, RegisterClass::Gpr64, 0, 8 }, // R12
+    { Register::RAX, Register::R13, Register::R13D, 13, RegisterClass::Gpr64, 0, 8 }, // R13
+    { Register::RAX, Register::R14, Register::R14D, 14, RegisterClass::Gpr64, 0, 8 }, // R14
+    { Register::RAX, Register::R15, Register::R15D, 15, RegisterClass::Gpr64, 0, 8 }, // R15
+    { Register::EIP, Register::RIP, Register::EIP, 0, RegisterClass::Ip, 0, 4 }, // EIP
+    { Register::EIP, Register::RIP, Register::EIP, 1, RegisterClass::Ip, 0, 8 }, // RIP
+    { Register::ES, Register::ES, Register::ES, 0, RegisterClass::Segment, 0, 2 }, // ES
+    { Register::ES, Register::CS, Register::CS, 1, RegisterClass::Segment, 0, 2 }, // CS
+    { Register::ES, Register::SS, Register::SS, 2, RegisterClass::Segment, 0, 2 }, // SS
+    { Register::ES, Register::DS, Register::DS, 3, RegisterClass::Segment, 0, 2 }, // DS
+    { Register::ES, Register::FS, Register::FS, 4, RegisterClass::Segment, 0, 2 }, // FS
+    { Register::ES, Register::GS, Register::GS, 5, RegisterClass::Segment, 0, 2 }, // GS
+    { Register::XMM0, Register::ZMM0, Register::ZMM0, 0, RegisterClass::Xmm, 0, 16 }, // XMM0
+    { Register::XMM0, Register::ZMM1, Register::ZMM1, 1, RegisterClass::Xmm, 0, 16 }, // XMM1
+    { Register::XMM0, Register::ZMM2, Register::ZMM2, 2, RegisterClass::Xmm, 0, 16 }, // XMM2
+    { Register::XMM0, Register::ZMM3, Register::ZMM3, 3, RegisterClass::Xmm, 0, 16 }, // XMM3
+    { Register::XMM0, Register::ZMM4, Register::ZMM4, 4, RegisterClass::Xmm, 0, 16 }, // XMM4
+    { Register::XMM0, Register::ZMM5, Register::ZMM5, 5, RegisterClass::Xmm, 0, 16 }, // XMM5
+    { Register::XMM0, Register::ZMM6, Register::ZMM6, 6, RegisterClass::Xmm, 0, 16 }, // XMM6
+    { Register::XMM0, Register::ZMM7, Register::ZMM7, 7, RegisterClass::Xmm, 0, 16 }, // XMM7
+    { Register::XMM0, Register::ZMM8, Register::ZMM8, 8, RegisterClass::Xmm, 0, 16 }, // XMM8
+    { Register::XMM0, Register::ZMM9, Register::ZMM9, 9, RegisterClass::Xmm, 0, 16 }, // XMM9
+    { Register::XMM0, Register::ZMM10, Register::ZMM10, 10, RegisterClass::Xmm, 0, 16 }, // XMM10
+    { Register::XMM0, Register::ZMM11, Register::ZMM11, 11, RegisterClass::Xmm, 0, 16 }, // XMM11
+    { Register::XMM0, Register::ZMM12, Register::ZMM12, 12, RegisterClass::Xmm, 0, 16 }, // XMM12
+    { Register::XMM0, Register::ZMM13, Register::ZMM13, 13, RegisterClass::Xmm, 0, 16 }, // XMM13
+    { Register::XMM0, Register::ZMM14, Register::ZMM14, 14, RegisterClass::Xmm, 0, 16 }, // XMM14
+    { Register::XMM0, Register::ZMM15, Register::ZMM15, 15, RegisterClass::Xmm, 0, 16 }, // XMM15
+    { Register::XMM0, Register::ZMM16, Register::ZMM16, 16, RegisterClass::Xmm, 0, 16 }, // XMM16
+    { Register::XMM0, Register::ZMM17, Register::ZMM17, 17, RegisterClass::Xmm, 0, 16 }, // XMM17
+    { Register::XMM0, Register::ZMM18, Register::ZMM18, 18, RegisterClass::Xmm, 0, 16 }, // XMM18
+    { Register::XMM0, Register::ZMM19, Register::ZMM19, 19, RegisterClass::Xmm, 0, 16 }, // XMM19
+    { Register::XMM0, Register::ZMM20, Register::ZMM20, 20, RegisterClass::Xmm, 0, 16 }, // XMM20
+    { Register::XMM0, Register::ZMM21, Register::ZMM21, 21, RegisterClass::Xmm, 0, 16 }, // XMM21
+    { Register::XMM0, Register::ZMM22, Register::ZMM22, 22, RegisterClass::Xmm, 0, 16 }, // XMM22
+    { Register::XMM0, Register::ZMM23, Register::ZMM23, 23, RegisterClass::Xmm, 0, 16 }, // XMM23
+    { Register::XMM0, Register::ZMM24, Register::ZMM24, 24, RegisterClass::Xmm, 0, 16 }, // XMM24
+    { Register::XMM0, Register::ZMM25, Register::ZMM25, 25, RegisterClass::Xmm, 0, 16 }, // XMM25
+    { Register::XMM0, Register::ZMM26, Register::ZMM26, 26, RegisterClass::Xmm, 0, 16 }, // XMM26
+    { Register::XMM0, Register::ZMM27, Register::ZMM27, 27, RegisterClass::Xmm, 0, 16 }, // XMM27
+    { Register::XMM0, Register::ZMM28, Register::ZMM28, 28, RegisterClass::Xmm, 0, 16 }, // XMM28
+    { Register::XMM0, Register::ZMM29, Register::ZMM29, 29, RegisterClass::Xmm, 0, 16 }, // XMM29
+    { Register::XMM0, Register::ZMM30, Register::ZMM30, 30, RegisterClass::Xmm, 0, 16 }, // XMM30
+    { Register::XMM0, Register::ZMM31, Register::ZMM31, 31, RegisterClass::Xmm, 0, 16 }, // XMM31
+    { Register::YMM0, Register::ZMM0, Register::ZMM0, 0, RegisterClass::Ymm, 0, 32 }, // YMM0
+    { Register::YMM0, Register::ZMM1, Register::ZMM1, 1, RegisterClass::Ymm, 0, 32 }, // YMM1
+    { Register::YMM0, Register::ZMM2, Register::ZMM2, 2, RegisterClass::Ymm, 0, 32 }, // YMM2
+    { Register::YMM0, Register::ZMM3, Register::ZMM3, 3, RegisterClass::Ymm, 0, 32 }, // YMM3
+    { Register::YMM0, Register::ZMM4, Register::ZMM4, 4, RegisterClass::Ymm, 0, 32 }, // YMM4
+    { Register::YMM0, Register::ZMM5, Register::ZMM5, 5, RegisterClass::Ymm, 0, 32 }, // YMM5
+    { Register::YMM0, Register::ZMM6, Register::ZMM6, 6, RegisterClass::Ymm, 0, 32 }, // YMM6
+    { Register::YMM0, Register::ZMM7, Register::ZMM7, 7, RegisterClass::Ymm, 0, 32 }, // YMM7
+    { Register::YMM0, Register::ZMM8, Register::ZMM8, 8, RegisterClass::Ymm, 0, 32 }, // YMM8
+    { Register::YMM0, Register::ZMM9, Register::ZMM9, 9, RegisterClass::Ymm, 0, 32 }, // YMM9
+    { Register::YMM0, Register::ZMM10, Register::ZMM10, 10, RegisterClass::Ymm, 0, 32 }, // YMM10
+    { Register::YMM0, Register::ZMM11, Register::ZMM11, 11, RegisterClass::Ymm, 0, 32 }, // YMM11
+    { Register::YMM0, Register::ZMM12, Register::ZMM12, 12, RegisterClass::Ymm, 0, 32 }, // YMM12
+    { Register::YMM0, Register::ZMM13, Register::ZMM13, 13, RegisterClass::Ymm, 0, 32 }, // YMM13
+    { Register::YMM0, Register::ZMM14, Register::ZMM14, 14, RegisterClass::Ymm, 0, 32 }, // YMM14
+    { Register::YMM0, Register::ZMM15, Register::ZMM15, 15, RegisterClass::Ymm, 0, 32 }, // YMM15
+    { Register::YMM0, Register::ZMM16, Register::ZMM16, 16, RegisterClass::Ymm, 0, 32 }, // YMM16
+    { Register::YMM0, Register::ZMM17, Register::ZMM17, 17, RegisterClass::Ymm, 0, 32 }, // YMM17
+    { Register::YMM0, Register::ZMM18, Register::ZMM18, 18, RegisterClass::Ymm, 0, 32 }, // YMM18
+    { Register::YMM0, Register::ZMM19, Register::ZMM19, 19, RegisterClass::Ymm, 0, 32 }, // YMM19
+    { Register::YMM0, Register::ZMM20, Register::ZMM20, 20, RegisterClass::Ymm, 0, 32 }, // YMM20
+    { Register::YMM0, Register::ZMM21, Register::ZMM21, 21, RegisterClass::Ymm, 0, 32 }, // YMM21
+    { Register::YMM0, Register::ZMM22, Register::ZMM22, 22, RegisterClass::Ymm, 0, 32 }, // YMM22
+    { Register::YMM0, Register::ZMM23, Register::ZMM23, 23, RegisterClass::Ymm, 0, 32 }, // YMM23
+    { Register::YMM0, Register::ZMM24, Register::ZMM24, 24, RegisterClass::Ymm, 0, 32 }, // YMM24
+    { Register::YMM0, Register::ZMM25, Register::ZMM25, 25, RegisterClass::Ymm, 0, 32 }, // YMM25
+    { Register::YMM0, Register::ZMM26, Register::ZMM26, 26, RegisterClass::Ymm, 0, 32 }, // YMM26
+    { Register::YMM0, Register::ZMM27, Register::ZMM27, 27, RegisterClass::Ymm, 0, 32 }, // YMM27
+    { Register::YMM0, Register::ZMM28, Register::ZMM28, 28, RegisterClass::Ymm, 0, 32 }, // YMM28
+    { Register::YMM0, Register::ZMM29, Register::ZMM29, 29, RegisterClass::Ymm, 0, 32 }, // YMM29
+    { Register::YMM0, Register::ZMM30, Register::ZMM30, 30, RegisterClass::Ymm, 0, 32 }, // YMM30
+    { Register::YMM0, Register::ZMM31, Register::ZMM31, 31, RegisterClass::Ymm, 0, 32 }, // YMM31
+    { Register::ZMM0, Register::ZMM0, Register::ZMM0, 0, RegisterClass::Zmm, 0, 64 }, // ZMM0
+    { Register::ZMM0, Register::ZMM1, Register::ZMM1, 1, RegisterClass::Zmm, 0, 64 }, // ZMM1
+    { Register::ZMM0, Register::ZMM2, Register::ZMM2, 2, RegisterClass::Zmm, 0, 64 }, // ZMM2
+    { Register::ZMM0, Register::ZMM3, Register::ZMM3, 3, RegisterClass::Zmm, 0, 64 }, // ZMM3
+    { Register::ZMM0, Register::ZMM4, Register::ZMM4, 4, RegisterClass::Zmm, 0, 64 }, // ZMM4
+    { Register::ZMM0, Register::ZMM5, Register::ZMM5, 5, RegisterClass::Zmm, 0, 64 }, // ZMM5
+    { Register::ZMM0, Register::ZMM6, Register::ZMM6, 6, RegisterClass::Zmm, 0, 64 }, // ZMM6
+    { Register::ZMM0, Register::ZMM7, Register::ZMM7, 7, RegisterClass::Zmm, 0, 64 }, // ZMM7
+    { Register::ZMM0, Register::ZMM8, Register::ZMM8, 8, RegisterClass::Zmm, 0, 64 }, // ZMM8
+    { Register::ZMM0, Register::ZMM9, Register::ZMM9, 9, RegisterClass::Zmm, 0, 64 }, // ZMM9
+    { Register::ZMM0, Register::ZMM10, Register::ZMM10, 10, RegisterClass::Zmm, 0, 64 }, // ZMM10
+    { Register::ZMM0, Register::ZMM11, Register::ZMM11, 11, RegisterClass::Zmm, 0, 64 }, // ZMM11
+    { Register::ZMM0, Register::ZMM12, Register::ZMM12, 12, RegisterClass::Zmm, 0, 64 }, // ZMM12
+    { Register::ZMM0, Register::ZMM13, Register::ZMM13, 13, RegisterClass::Zmm, 0, 64 }, // ZMM13
+    { Register::ZMM0, Register::ZMM14, Register::ZMM14, 14, RegisterClass::Zmm, 0, 64 }, // ZMM14
+    { Register::ZMM0, Register::ZMM15, Register::ZMM15, 15, RegisterClass::Zmm, 0, 64 }, // ZMM15
+    { Register::ZMM0, Register::ZMM16, Register::ZMM16, 16, RegisterClass::Zmm, 0, 64 }, // ZMM16
+    { Register::ZMM0, Register::ZMM17, Register::ZMM17, 17, RegisterClass::Zmm, 0, 64 }, // ZMM17
+    { Register::ZMM0, Register::ZMM18, Register::ZMM18, 18, RegisterClass::Zmm, 0, 64 }, // ZMM18
+    { Register::ZMM0, Register::ZMM19, Register::ZMM19, 19, RegisterClass::Zmm, 0, 64 }, // ZMM19
+    { Register::ZMM0, Register::ZMM20, Register::ZMM20, 20, RegisterClass::Zmm, 0, 64 }, // ZMM20
+    { Register::ZMM0, Register::ZMM21, Register::ZMM21, 21, RegisterClass::Zmm, 0, 64 }, // ZMM21
+    { Register::ZMM0, Register::ZMM22, Register::ZMM22, 22, RegisterClass::Zmm, 0, 64 }, // ZMM22
+    { Register::ZMM0, Register::ZMM23, Register::ZMM23, 23, RegisterClass::Zmm, 0, 64 }, // ZMM23
+    { Register::ZMM0, Register::ZMM24, Register::ZMM24, 24, RegisterClass::Zmm, 0, 64 }, // ZMM24
+    { Register::ZMM0, Register::ZMM25, Register::ZMM25, 25, RegisterClass::Zmm, 0, 64 }, // ZMM25
+    { Register::ZMM0, Register::ZMM26, Register::ZMM26, 26, RegisterClass::Zmm, 0, 64 }, // ZMM26
+    { Register::ZMM0, Register::ZMM27, Register::ZMM27, 27, RegisterClass::Zmm, 0, 64 }, // ZMM27
+    { Register::ZMM0, Register::ZMM28, Register::ZMM28, 28, RegisterClass::Zmm, 0, 64 }, // ZMM28
+    { Register::ZMM0, Register::ZMM29, Register::ZMM29, 29, RegisterClass::Zmm, 0, 64 }, // ZMM29
+    { Register::ZMM0, Register::ZMM30, Register::ZMM30, 30, RegisterClass::Zmm, 0, 64 }, // ZMM30
+    { Register::ZMM0, Register::ZMM31, Register::ZMM31, 31, RegisterClass::Zmm, 0, 64 }, // ZMM31
+    { Register::K0, Register::K0, Register::K0, 0, RegisterClass::K, 0, 8 }, // K0
+    { Register::K0, Register::K1, Register::K1, 1, RegisterClass::K, 0, 8 }, // K1
+    { Register::K0, Register::K2, Register::K2, 2, RegisterClass::K, 0, 8 }, // K2
+    { Register::K0, Register::K3, Register::K3, 3, RegisterClass::K, 0, 8 }, // K3
+    { Register::K0, Register::K4, Register::K4, 4, RegisterClass::K, 0, 8 }, // K4
+    { Register::K0, Register::K5, Register::K5, 5, RegisterClass::K, 0, 8 }, // K5
+    { Register::K0, Register::K6, Register::K6, 6, RegisterClass::K, 0, 8 }, // K6
+    { Register::K0, Register::K7, Register::K7, 7, RegisterClass::K, 0, 8 }, // K7
+    { Register::BND0, Register::BND0, Register::BND0, 0, RegisterClass::Bnd, 0, 16 }, // BND0
+    { Register::BND0, Register::BND1, Register::BND1, 1, RegisterClass::Bnd, 0, 16 }, // BND1
+    { Register::BND0, Register::BND2, Register::BND2, 2, RegisterClass::Bnd, 0, 16 }, // BND2
+    { Register::BND0, Register::BND3, Register::BND3, 3, RegisterClass::Bnd, 0, 16 }, // BND3
+    { Register::CR0, Register::CR0, Register::CR0, 0, RegisterClass::Cr, 0, 8 }, // CR0
+    { Register::CR0, Register::CR1, Register::CR1, 1, RegisterClass::Cr, 0, 8 }, // CR1
+    { Register::CR0, Register::CR2, Register::CR2, 2, RegisterClass::Cr, 0, 8 }, // CR2
+    { Register::CR0, Register::CR3, Register::CR3, 3, RegisterClass::Cr, 0, 8 }, // CR3
+    { Register::CR0, Register::CR4, Register::CR4, 4, RegisterClass::Cr, 0, 8 }, // CR4
+    { Register::CR0, Register::CR5, Register::CR5, 5, RegisterClass::Cr, 0, 8 }, // CR5
+    { Register::CR0, Register::CR6, Register::CR6, 6, RegisterClass::Cr, 0, 8 }, // CR6
+    { Register::CR0, Register::CR7, Register::CR7, 7, RegisterClass::Cr, 0, 8 }, // CR7
+    { Register::CR0, Register::CR8, Register::CR8, 8, RegisterClass::Cr, 0, 8 }, // CR8
+    { Register::CR0, Register::CR9, Register::CR9, 9, RegisterClass::Cr, 0, 8 }, // CR9
+    { Register::CR0, Register::CR10, Register::CR10, 10, RegisterClass::Cr, 0, 8 }, // CR10
+    { Register::CR0, Register::CR11, Register::CR11, 11, RegisterClass::Cr, 0, 8 }, // CR11
+    { Register::CR0, Register::CR12, Register::CR12, 12, RegisterClass::Cr, 0, 8 }, // CR12
+    { Register::CR0, Register::CR13, Register::CR13, 13, RegisterClass::Cr, 0, 8 }, // CR13
+    { Register::CR0, Register::CR14, Register::CR14, 14, RegisterClass::Cr, 0, 8 }, // CR14
+    { Register::CR0, Register::CR15, Register::CR15, 15, RegisterClass::Cr, 0, 8 }, // CR15
+    { Register::DR0, Register::DR0, Register::DR0, 0, RegisterClass::Dr, 0, 8 }, // DR0
+    { Register::DR0, Register::DR1, Register::DR1, 1, RegisterClass::Dr, 0, 8 }, // DR1
+    { Register::DR0, Register::DR2, Register::DR2, 2, RegisterClass::Dr, 0, 8 }, // DR2
+    { Register::DR0, Register::DR3, Register::DR3, 3, RegisterClass::Dr, 0, 8 }, // DR3
+    { Register::DR0, Register::DR4, Register::DR4, 4, RegisterClass::Dr, 0, 8 }, // DR4
+    { Register::DR0, Register::DR5, Register::DR5, 5, RegisterClass::Dr, 0, 8 }, // DR5
+    { Register::DR0, Register::DR6, Register::DR6, 6, RegisterClass::Dr, 0, 8 }, // DR6
+    { Register::DR0, Register::DR7, Register::DR7, 7, RegisterClass::Dr, 0, 8 }, // DR7
+    { Register::DR0, Register::DR8, Register::DR8, 8, RegisterClass::Dr, 0, 8 }, // DR8
+    { Register::DR0, Register::DR9, Register::DR9, 9, RegisterClass::Dr, 0, 8 }, // DR9
+    { Register::DR0, Register::DR10, Register::DR10, 10, RegisterClass::Dr, 0, 8 }, // DR10
+    { Register::DR0, Register::DR11, Register::DR11, 11, RegisterClass::Dr, 0, 8 }, // DR11
+    { Register::DR0, Register::DR12, Register::DR12, 12, RegisterClass::Dr, 0, 8 }, // DR12
+    { Register::DR0, Register::DR13, Register::DR13, 13, RegisterClass::Dr, 0, 8 }, // DR13
+    { Register::DR0, Register::DR14, Register::DR14, 14, RegisterClass::Dr, 0, 8 }, // DR14
+    { Register::DR0, Register::DR15, Register::DR15, 15, RegisterClass::Dr, 0, 8 }, // DR15
+    { Register::ST0, Register::ST0, Register::ST0, 0, RegisterClass::St, 0, 10 }, // ST0
+    { Register::ST0, Register::ST1, Register::ST1, 1, RegisterClass::St, 0, 10 }, // ST1
+    { Register::ST0, Register::ST2, Register::ST2, 2, RegisterClass::St, 0, 10 }, // ST2
+    { Register::ST0, Register::ST3, Register::ST3, 3, RegisterClass::St, 0, 10 }, // ST3
+    { Register::ST0, Register::ST4, Register::ST4, 4, RegisterClass::St, 0, 10 }, // ST4
+    { Register::ST0, Register::ST5, Register::ST5, 5, RegisterClass::St, 0, 10 }, // ST5
+    { Register::ST0, Register::ST6, Register::ST6, 6, RegisterClass::St, 0, 10 }, // ST6
+    { Register::ST0, Register::ST7, Register::ST7, 7, RegisterClass::St, 0, 10 }, // ST7
+    { Register::MM0, Register::MM0, Register::MM0, 0, RegisterClass::Mm, 0, 8 }, // MM0
+    { Register::MM0, Register::MM1, Register::MM1, 1, RegisterClass::Mm, 0, 8 }, // MM1
+    { Register::MM0, Register::MM2, Register::MM2, 2, RegisterClass::Mm, 0, 8 }, // MM2
+    { Register::MM0, Register::MM3, Register::MM3, 3, RegisterClass::Mm, 0, 8 }, // MM3
+    { Register::MM0, Register::MM4, Register::MM4, 4, RegisterClass::Mm, 0, 8 }, // MM4
+    { Register::MM0, Register::MM5, Register::MM5, 5, RegisterClass::Mm, 0, 8 }, // MM5
+    { Register::MM0, Register::MM6, Register::MM6, 6, RegisterClass::Mm, 0, 8 }, // MM6
+    { Register::MM0, Register::MM7, Register::MM7, 7, RegisterClass::Mm, 0, 8 }, // MM7
+    { Register::TR0, Register::TR0, Register::TR0, 0, RegisterClass::Tr, 0, 4 }, // TR0
+    { Register::TR0, Register::TR1, Register::TR1, 1, RegisterClass::Tr, 0, 4 }, // TR1
+    { Register::TR0, Register::TR2, Register::TR2, 2, RegisterClass::Tr, 0, 4 }, // TR2
+    { Register::TR0, Register::TR3, Register::TR3, 3, RegisterClass::Tr, 0, 4 }, // TR3
+    { Register::TR0, Register::TR4, Register::TR4, 4, RegisterClass::Tr, 0, 4 }, // TR4
+    { Register::TR0, Register::TR5, Register::TR5, 5, RegisterClass::Tr, 0, 4 }, // TR5
+    { Register::TR0, Register::TR6, Register::TR6, 6, RegisterClass::Tr, 0, 4 }, // TR6
+    { Register::TR0, Register::TR7, Register::TR7, 7, RegisterClass::Tr, 0, 4 }, // TR7
+    { Register::TMM0, Register::TMM0, Register::TMM0, 0, RegisterClass::Tmm, 0, 1024 }, // TMM0
+    { Register::TMM0, Register::TMM1, Register::TMM1, 1, RegisterClass::Tmm, 0, 1024 }, // TMM1
+    { Register::TMM0, Register::TMM2, Register::TMM2, 2, RegisterClass::Tmm, 0, 1024 }, // TMM2
+    { Register::TMM0, Register::TMM3, Register::TMM3, 3, RegisterClass::Tmm, 0, 1024 }, // TMM3
+    { Register::TMM0, Register::TMM4, Register::TMM4, 4, RegisterClass::Tmm, 0, 1024 }, // TMM4
+    { Register::TMM0, Register::TMM5, Register::TMM5, 5, RegisterClass::Tmm, 0, 1024 }, // TMM5
+    { Register::TMM0, Register::TMM6, Register::TMM6, 6, RegisterClass::Tmm, 0, 1024 }, // TMM6
+    { Register::TMM0, Register::TMM7, Register::TMM7, 7, RegisterClass::Tmm, 0, 1024 }, // TMM7
+    { Register::None, Register::DontUse0, Register::DontUse0, 0, RegisterClass::None, 0, 0 }, // DontUse0
+    { Register::None, Register::DontUseFA, Register::DontUseFA, 0, RegisterClass::None, 0, 0 }, // DontUseFA
+    { Register::None, Register::DontUseFB, Register::DontUseFB, 0, RegisterClass::None, 0, 0 }, // DontUseFB
+    { Register::None, Register::DontUseFC, Register::DontUseFC, 0, RegisterClass::None, 0, 0 }, // DontUseFC
+    { Register::None, Register::DontUseFD, Register::DontUseFD, 0, RegisterClass::None, 0, 0 }, // DontUseFD
+    { Register::None, Register::DontUseFE, Register::DontUseFE, 0, RegisterClass::None, 0, 0 }, // DontUseFE
+    { Register::None, Register::DontUseFF, Register::DontUseFF, 0, RegisterClass::None, 0, 0 }, // DontUseFF
+  };
+
+  /// Lowercase Mnemonic names, indexed by value
+  inline constexpr const char* mnemonicNames [ 1894 ] = {
+    "invalid", "aaa", "aad", "aam", "aas", "adc", "adcx", "add",
+    "addpd", "addps", "addsd", "addss", "addsubpd", "addsubps", "adox", "aesdec",
+    "aesdeclast", "aesenc", "aesenclast", "aesimc", "aeskeygenassist", "and", "andn", "andnpd",
+    "andnps", "andpd", "andps", "arpl", "bextr", "blcfill", "blci", "blcic",
+    "blcmsk", "blcs", "blendpd", "blendps", "blendvpd", "blendvps", "blsfill", "blsi",
+    "blsic", "blsmsk", "blsr", "bndcl", "bndcn", "bndcu", "bndldx", "bndmk",
+    "bndmov", "bndstx", "bound", "bsf", "bsr", "bswap", "bt", "btc",
+    "btr", "bts", "bzhi", "call", "cbw", "cdq", "cdqe", "cl1invmb",
+    "clac", "clc", "cld", "cldemote", "clflush", "clflushopt", "clgi", "cli",
+    "clrssbsy", "clts", "clwb", "clzero", "cmc", "cmova", "cmovae", "cmovb",
+    "cmovbe", "cmove", "cmovg", "cmovge", "cmovl", "cmovle", "cmovne", "cmovno",
+    "cmovnp", "cmovns", "cmovo", "cmovp", "cmovs", "cmp", "cmppd", "cmpps",
+    "cmpsb", "cmpsd", "cmpsq", "cmpss", "cmpsw", "cmpxchg", "cmpxchg16b", "cmpxchg8b",
+    "comisd", "comiss", "cpuid", "cqo", "crc32", "cvtdq2pd", "cvtdq2ps", "cvtpd2dq",
+    "cvtpd2pi", "cvtpd2ps", "cvtpi2pd", "cvtpi2ps", "cvtps2dq", "cvtps2pd", "cvtps2pi", "cvtsd2si",
+    "cvtsd2ss", "cvtsi2sd", "cvtsi2ss", "cvtss2sd", "cvtss2si", "cvttpd2dq", "cvttpd2pi", "cvttps2dq",
+    "cvttps2pi", "cvttsd2si", "cvttss2si", "cwd", "cwde", "daa", "das", "db",
+    "dd", "dec", "div", "divpd", "divps", "divsd", "divss", "dppd",
+    "dpps", "dq", "dw", "emms", "encls", "enclu", "enclv", "endbr32",
+    "endbr64", "enqcmd", "enqcmds", "enter", "extractps", "extrq", "f2xm1", "fabs",
+    "fadd", "faddp", "fbld", "fbstp", "fchs", "fclex", "fcmovb", "fcmovbe",
+    "fcmove", "fcmovnb", "fcmovnbe", "fcmovne", "fcmovnu", "fcmovu", "fcom", "fcomi",
+    "fcomip", "fcomp", "fcompp", "fcos", "fdecstp", "fdisi", "fdiv", "fdivp",
+    "fdivr", "fdivrp", "femms", "feni", "ffree", "ffreep", "fiadd", "ficom",
+    "ficomp", "fidiv", "fidivr", "fild", "fimul", "fincstp", "finit", "fist",
+    "fistp", "fisttp", "fisub", "fisubr", "fld", "fld1", "fldcw", "fldenv",
+    "fldl2e", "fldl2t", "fldlg2", "fldln2", "fldpi", "fldz", "fmul", "fmulp",
+    "fnclex", "fndisi", "fneni", "fninit", "fnop", "fnsave", "fnsetpm", "fnstcw",
+    "fnstenv", "fnstsw", "fpatan", "fprem", "fprem1", "fptan", "frndint", "frstor",
+    "frstpm", "fsave", "fscale", "fsetpm", "fsin", "fsincos", "fsqrt", "fst",
+    "fstcw", "fstdw", "fstenv", "fstp", "fstpnce", "fstsg", "fstsw", "fsub",
+    "fsubp", "fsubr", "fsubrp", "ftst", "fucom", "fucomi", "fucomip", "fucomp",
+    "fucompp", "fxam", "fxch", "fxrstor", "fxrstor64", "fxsave", "fxsave64", "fxtract",
+    "fyl2x", "fyl2xp1", "getsec", "gf2p8affineinvqb", "gf2p8affineqb", "gf2p8mulb", "haddpd", "haddps",
+    "hlt", "hsubpd", "hsubps", "ibts", "idiv", "imul", "in", "inc",
+    "incsspd", "incsspq", "insb", "insd", "insertps", "insertq", "insw", "int",
+    "int1", "into", "invd", "invept", "invlpg", "invlpga", "invpcid", "invvpid",
+    "iret", "ja", "jae", "jb", "jbe", "jcxz", "je", "jecxz",
+    "jg", "jge", "jl", "jle", "jmp", "jmpe", "jne", "jno",
+    "jnp", "jns", "jo", "jp", "jrcxz", "js", "kaddb", "kaddd",
+    "kaddq", "kaddw", "kandb", "kandd", "kandnb", "kandnd", "kandnq", "kandnw",
+    "kandq", "kandw", "kmovb", "kmovd", "kmovq", "kmovw", "knotb", "knotd",
+    "knotq", "knotw", "korb", "kord", "korq", "kortestb", "kortestd", "kortestq",
+    "kortestw", "korw", "kshiftlb", "kshiftld", "kshiftlq", "kshiftlw", "kshiftrb", "kshiftrd",
+    "kshiftrq", "kshiftrw", "ktestb", "ktestd", "ktestq", "ktestw", "kunpckbw", "kunpckdq",
+    "kunpckwd", "kxnorb", "kxnord", "kxnorq", "kxnorw", "kxorb", "kxord", "kxorq",
+    "kxorw", "lahf", "lar", "lddqu", "ldmxcsr", "lds", "lea", "leave",
+    "les", "lfence", "lfs", "lgdt", "lgs", "lidt", "lldt", "llwpcb",
+    "lmsw", "loadall", "lodsb", "lodsd", "lodsq", "lodsw", "loop", "loope",
+    "loopne", "lsl", "lss", "ltr", "lwpins", "lwpval", "lzcnt", "maskmovdqu",
+    "maskmovq", "maxpd", "maxps", "maxsd", "maxss", "mcommit", "mfence", "minpd",
+    "minps", "minsd", "minss", "monitor", "monitorx", "montmul", "mov", "movapd",
+    "movaps", "movbe", "movd", "movddup", "movdir64b", "movdiri", "movdq2q", "movdqa",
+    "movdqu", "movhlps", "movhpd", "movhps", "movlhps", "movlpd", "movlps", "movmskpd",
+    "movmskps", "movntdq", "movntdqa", "movnti", "movntpd", "movntps", "movntq", "movntsd",
+    "movntss", "movq", "movq2dq", "movsb", "movsd", "movshdup", "movsldup", "movsq",
+    "movss", "movsw", "movsx", "movsxd", "movupd", "movups", "movzx", "mpsadbw",
+    "mul", "mulpd", "mulps", "mulsd", "mulss", "mulx", "mwait", "mwaitx",
+    "neg", "nop", "not", "or", "orpd", "orps", "out", "outsb",
+    "outsd", "outsw", "pabsb", "pabsd", "pabsw", "packssdw", "packsswb", "packusdw",
+    "packuswb", "paddb", "paddd", "paddq", "paddsb", "paddsw", "paddusb", "paddusw",
+    "paddw", "palignr", "pand", "pandn", "pause", "pavgb", "pavgusb", "pavgw",
+    "pblendvb", "pblendw", "pclmulqdq", "pcmpeqb", "pcmpeqd", "pcmpeqq", "pcmpeqw", "pcmpestri",
+    "pcmpestri64", "pcmpestrm", "pcmpestrm64", "pcmpgtb", "pcmpgtd", "pcmpgtq", "pcmpgtw", "pcmpistri",
+    "pcmpistrm", "pcommit", "pconfig", "pdep", "pext", "pextrb", "pextrd", "pextrq",
+    "pextrw", "pf2id", "pf2iw", "pfacc", "pfadd", "pfcmpeq", "pfcmpge", "pfcmpgt",
+    "pfmax", "pfmin", "pfmul", "pfnacc", "pfpnacc", "pfrcp", "pfrcpit1", "pfrcpit2",
+    "pfrcpv", "pfrsqit1", "pfrsqrt", "pfrsqrtv", "pfsub", "pfsubr", "phaddd", "phaddsw",
+    "phaddw", "phminposuw", "phsubd", "phsubsw", "phsubw", "pi2fd", "pi2fw", "pinsrb",
+    "pinsrd", "pinsrq", "pinsrw", "pmaddubsw", "pmaddwd", "pmaxsb", "pmaxsd", "pmaxsw",
+    "pmaxub", "pmaxud", "pmaxuw", "pminsb", "pminsd", "pminsw", "pminub", "pminud",
+    "pminuw", "pmovmskb", "pmovsxbd", "pmovsxbq", "pmovsxbw", "pmovsxdq", "pmovsxwd", "pmovsxwq",
+    "pmovzxbd", "pmovzxbq", "pmovzxbw", "pmovzxdq", "pmovzxwd", "pmovzxwq", "pmuldq", "pmulhrsw",
+    "pmulhrw", "pmulhuw", "pmulhw", "pmulld", "pmullw", "pmuludq", "pop", "popa",
+    "popcnt", "popf", "por", "prefetch", "prefetchnta", "prefetcht0", "prefetcht1", "prefetcht2",
+    "prefetchw", "prefetchwt1", "psadbw", "pshufb", "pshufd", "pshufhw", "pshuflw", "pshufw",
+    "psignb", "psignd", "psignw", "pslld", "pslldq", "psllq", "psllw", "psrad",
+    "psraw", "psrld", "psrldq", "psrlq", "psrlw", "psubb", "psubd", "psubq",
+    "psubsb", "psubsw", "psubusb", "psubusw", "psubw", "pswapd", "ptest", "ptwrite",
+    "punpckhbw", "punpckhdq", "punpckhqdq", "punpckhwd", "punpcklbw", "punpckldq", "punpcklqdq", "punpcklwd",
+    "push", "pusha", "pushf", "pxor", "rcl", "rcpps", "rcpss", "rcr",
+    "rdfsbase", "rdgsbase", "rdmsr", "rdpid", "rdpkru", "rdpmc", "rdpru", "rdrand",
+    "rdseed", "rdsspd", "rdsspq", "rdtsc", "rdtscp", "reservednop", "ret", "retf",
+    "rol", "ror", "rorx", "roundpd", "roundps", "roundsd", "roundss", "rsm",
+    "rsqrtps", "rsqrtss", "rstorssp", "sahf", "sal", "salc", "sar", "sarx",
+    "saveprevssp", "sbb", "scasb", "scasd", "scasq", "scasw", "seta", "setae",
+    "setb", "setbe", "sete", "setg", "setge", "setl", "setle", "setne",
+    "setno", "setnp", "setns", "seto", "setp", "sets", "setssbsy", "sfence",
+    "sgdt", "sha1msg1", "sha1msg2", "sha1nexte", "sha1rnds4", "sha256msg1", "sha256msg2", "sha256rnds2",
+    "shl", "shld", "shlx", "shr", "shrd", "shrx", "shufpd", "shufps",
+    "sidt", "skinit", "sldt", "slwpcb", "smsw", "sqrtpd", "sqrtps", "sqrtsd",
+    "sqrtss", "stac", "stc", "std", "stgi", "sti", "stmxcsr", "stosb",
+    "stosd", "stosq", "stosw", "str", "sub", "subpd", "subps", "subsd",
+    "subss", "swapgs", "syscall", "sysenter", "sysexit", "sysret", "t1mskc", "test",
+    "tpause", "tzcnt", "tzmsk", "ucomisd", "ucomiss", "ud0", "ud1", "ud2",
+    "umonitor", "umov", "umwait", "unpckhpd", "unpckhps", "unpcklpd", "unpcklps", "v4fmaddps",
+    "v4fmaddss", "v4fnmaddps", "v4fnmaddss", "vaddpd", "vaddps", "vaddsd", "vaddss", "vaddsubpd",
+    "vaddsubps", "vaesdec", "vaesdeclast", "vaesenc", "vaesenclast", "vaesimc", "vaeskeygenassist", "valignd",
+    "valignq", "vandnpd", "vandnps", "vandpd", "vandps", "vblendmpd", "vblendmps", "vblendpd",
+    "vblendps", "vblendvpd", "vblendvps", "vbroadcastf128", "vbroadcastf32x2", "vbroadcastf32x4", "vbroadcastf32x8", "vbroadcastf64x2",
+    "vbroadcastf64x4", "vbroadcasti128", "vbroadcasti32x2", "vbroadcasti32x4", "vbroadcasti32x8", "vbroadcasti64x2", "vbroadcasti64x4", "vbroadcastsd",
+    "vbroadcastss", "vcmppd", "vcmpps", "vcmpsd", "vcmpss", "vcomisd", "vcomiss", "vcompresspd",
+    "vcompressps", "vcvtdq2pd", "vcvtdq2ps", "vcvtne2ps2bf16", "vcvtneps2bf16", "vcvtpd2dq", "vcvtpd2ps", "vcvtpd2qq",
+    "vcvtpd2udq", "vcvtpd2uqq", "vcvtph2ps", "vcvtps2dq", "vcvtps2pd", "vcvtps2ph", "vcvtps2qq", "vcvtps2udq",
+    "vcvtps2uqq", "vcvtqq2pd", "vcvtqq2ps", "vcvtsd2si", "vcvtsd2ss", "vcvtsd2usi", "vcvtsi2sd", "vcvtsi2ss",
+    "vcvtss2sd", "vcvtss2si", "vcvtss2usi", "vcvttpd2dq", "vcvttpd2qq", "vcvttpd2udq", "vcvttpd2uqq", "vcvttps2dq",
+    "vcvttps2qq", "vcvttps2udq", "vcvttps2uqq", "vcvttsd2si", "vcvttsd2usi", "vcvttss2si", "vcvttss2usi", "vcvtudq2pd",
+    "vcvtudq2ps", "vcvtuqq2pd", "vcvtuqq2ps", "vcvtusi2sd", "vcvtusi2ss", "vdbpsadbw", "vdivpd", "vdivps",
+    "vdivsd", "vdivss", "vdpbf16ps", "vdppd", "vdpps", "verr", "verw", "vexp2pd",
+    "vexp2ps", "vexpandpd", "vexpandps", "vextractf128", "vextractf32x4", "vextractf32x8", "vextractf64x2", "vextractf64x4",
+    "vextracti128", "vextracti32x4", "vextracti32x8", "vextracti64x2", "vextracti64x4", "vextractps", "vfixupimmpd", "vfixupimmps",
+    "vfixupimmsd", "vfixupimmss", "vfmadd132pd", "vfmadd132ps", "vfmadd132sd", "vfmadd132ss", "vfmadd213pd", "vfmadd213ps",
+    "vfmadd213sd", "vfmadd213ss", "vfmadd231pd", "vfmadd231ps", "vfmadd231sd", "vfmadd231ss", "vfmaddpd", "vfmaddps",
+    "vfmaddsd", "vfmaddss", "vfmaddsub132pd", "vfmaddsub132ps", "vfmaddsub213pd", "vfmaddsub213ps", "vfmaddsub231pd", "vfmaddsub231ps",
+    "vfmaddsubpd", "vfmaddsubps", "vfmsub132pd", "vfmsub132ps", "vfmsub132sd", "vfmsub132ss", "vfmsub213pd", "vfmsub213ps",
+    "vfmsub213sd", "vfmsub213ss", "vfmsub231pd", "vfmsub231ps", "vfmsub231sd", "vfmsub231ss", "vfmsubadd132pd", "vfmsubadd132ps",
+    "vfmsubadd213pd", "vfmsubadd213ps", "vfmsubadd231pd", "vfmsubadd231ps", "vfmsubaddpd", "vfmsubaddps", "vfmsubpd", "vfmsubps",
+    "vfmsubsd", "vfmsubss", "vfnmadd132pd", "vfnmadd132ps", "vfnmadd132sd", "vfnmadd132ss", "vfnmadd213pd", "vfnmadd213ps",
+    "vfnmadd213sd", "vfnmadd213ss", "vfnmadd231pd", "vfnmadd231ps", "vfnmadd231sd", "vfnmadd231ss", "vfnmaddpd", "vfnmaddps",
+    "vfnmaddsd", "vfnmaddss", "vfnmsub132pd", "vfnmsub132ps", "vfnmsub132sd", "vfnmsub132ss", "vfnmsub213pd", "vfnmsub213ps",
+    "vfnmsub213sd", "vfnmsub213ss", "vfnmsub231pd", "vfnmsub231ps", "vfnmsub231sd", "vfnmsub231ss", "vfnmsubpd", "vfnmsubps",
+    "vfnmsubsd", "vfnmsubss", "vfpclasspd", "vfpclassps", "vfpclasssd", "vfpclassss", "vfrczpd", "vfrczps",
+    "vfrczsd", "vfrczss", "vgatherdpd", "vgatherdps", "vgatherpf0dpd", "vgatherpf0dps", "vgatherpf0qpd", "vgatherpf0qps",
+    "vgatherpf1dpd", "vgatherpf1dps", "vgatherpf1qpd", "vgatherpf1qps", "vgatherqpd", "vgatherqps", "vgetexppd", "vgetexpps",
+    "vgetexpsd", "vgetexpss", "vgetmantpd", "vgetmantps", "vgetmantsd", "vgetmantss", "vgf2p8affineinvqb", "vgf2p8affineqb",
+    "vgf2p8mulb", "vhaddpd", "vhaddps", "vhsubpd", "vhsubps", "vinsertf128", "vinsertf32x4", "vinsertf32x8",
+    "vinsertf64x2", "vinsertf64x4", "vinserti128", "vinserti32x4", "vinserti32x8", "vinserti64x2", "vinserti64x4", "vinsertps",
+    "vlddqu", "vldmxcsr", "vmaskmovdqu", "vmaskmovpd", "vmaskmovps", "vmaxpd", "vmaxps", "vmaxsd",
+    "vmaxss", "vmcall", "vmclear", "vmfunc", "vminpd", "vminps", "vminsd", "vminss",
+    "vmlaunch", "vmload", "vmmcall", "vmovapd", "vmovaps", "vmovd", "vmovddup", "vmovdqa",
+    "vmovdqa32", "vmovdqa64", "vmovdqu", "vmovdqu16", "vmovdqu32", "vmovdqu64", "vmovdqu8", "vmovhlps",
+    "vmovhpd", "vmovhps", "vmovlhps", "vmovlpd", "vmovlps", "vmovmskpd", "vmovmskps", "vmovntdq",
+    "vmovntdqa", "vmovntpd", "vmovntps", "vmovq", "vmovsd", "vmovshdup", "vmovsldup", "vmovss",
+    "vmovupd", "vmovups", "vmpsadbw", "vmptrld", "vmptrst", "vmread", "vmresume", "vmrun",
+    "vmsave", "vmulpd", "vmulps", "vmulsd", "vmulss", "vmwrite", "vmxoff", "vmxon",
+    "vorpd", "vorps", "vp2intersectd", "vp2intersectq", "vp4dpwssd", "vp4dpwssds", "vpabsb", "vpabsd",
+    "vpabsq", "vpabsw", "vpackssdw", "vpacksswb", "vpackusdw", "vpackuswb", "vpaddb", "vpaddd",
+    "vpaddq", "vpaddsb", "vpaddsw", "vpaddusb", "vpaddusw", "vpaddw", "vpalignr", "vpand",
+    "vpandd", "vpandn", "vpandnd", "vpandnq", "vpandq", "vpavgb", "vpavgw", "vpblendd",
+    "vpblendmb", "vpblendmd", "vpblendmq", "vpblendmw", "vpblendvb", "vpblendw", "vpbroadcastb", "vpbroadcastd",
+    "vpbroadcastmb2q", "vpbroadcastmw2d", "vpbroadcastq", "vpbroadcastw", "vpclmulqdq", "vpcmov", "vpcmpb", "vpcmpd",
+    "vpcmpeqb", "vpcmpeqd", "vpcmpeqq", "vpcmpeqw", "vpcmpestri", "vpcmpestri64", "vpcmpestrm", "vpcmpestrm64",
+    "vpcmpgtb", "vpcmpgtd", "vpcmpgtq", "vpcmpgtw", "vpcmpistri", "vpcmpistrm", "vpcmpq", "vpcmpub",
+    "vpcmpud", "vpcmpuq", "vpcmpuw", "vpcmpw", "vpcomb", "vpcomd", "vpcompressb", "vpcompressd",
+    "vpcompressq", "vpcompressw", "vpcomq", "vpcomub", "vpcomud", "vpcomuq", "vpcomuw", "vpcomw",
+    "vpconflictd", "vpconflictq", "vpdpbusd", "vpdpbusds", "vpdpwssd", "vpdpwssds", "vperm2f128", "vperm2i128",
+    "vpermb", "vpermd", "vpermi2b", "vpermi2d", "vpermi2pd", "vpermi2ps", "vpermi2q", "vpermi2w",
+    "vpermil2pd", "vpermil2ps", "vpermilpd", "vpermilps", "vpermpd", "vpermps", "vpermq", "vpermt2b",
+    "vpermt2d", "vpermt2pd", "vpermt2ps", "vpermt2q", "vpermt2w", "vpermw", "vpexpandb", "vpexpandd",
+    "vpexpandq", "vpexpandw", "vpextrb", "vpextrd", "vpextrq", "vpextrw", "vpgatherdd", "vpgatherdq",
+    "vpgatherqd", "vpgatherqq", "vphaddbd", "vphaddbq", "vphaddbw", "vphaddd", "vphadddq", "vphaddsw",
+    "vphaddubd", "vphaddubq", "vphaddubw", "vphaddudq", "vphadduwd", "vphadduwq", "vphaddw", "vphaddwd",
+    "vphaddwq", "vphminposuw", "vphsubbw", "vphsubd", "vphsubdq", "vphsubsw", "vphsubw", "vphsubwd",
+    "vpinsrb", "vpinsrd", "vpinsrq", "vpinsrw", "vplzcntd", "vplzcntq", "vpmacsdd", "vpmacsdqh",
+    "vpmacsdql", "vpmacssdd", "vpmacssdqh", "vpmacssdql", "vpmacsswd", "vpmacssww", "vpmacswd", "vpmacsww",
+    "vpmadcsswd", "vpmadcswd", "vpmadd52huq", "vpmadd52luq", "vpmaddubsw", "vpmaddwd", "vpmaskmovd", "vpmaskmovq",
+    "vpmaxsb", "vpmaxsd", "vpmaxsq", "vpmaxsw", "vpmaxub", "vpmaxud", "vpmaxuq", "vpmaxuw",
+    "vpminsb", "vpminsd", "vpminsq", "vpminsw", "vpminub", "vpminud", "vpminuq", "vpminuw",
+    "vpmovb2m", "vpmovd2m", "vpmovdb", "vpmovdw", "vpmovm2b", "vpmovm2d", "vpmovm2q", "vpmovm2w",
+    "vpmovmskb", "vpmovq2m", "vpmovqb", "vpmovqd", "vpmovqw", "vpmovsdb", "vpmovsdw", "vpmovsqb",
+    "vpmovsqd", "vpmovsqw", "vpmovswb", "vpmovsxbd", "vpmovsxbq", "vpmovsxbw", "vpmovsxdq", "vpmovsxwd",
+    "vpmovsxwq", "vpmovusdb", "vpmovusdw", "vpmovusqb", "vpmovusqd", "vpmovusqw", "vpmovuswb", "vpmovw2m",
+    "vpmovwb", "vpmovzxbd", "vpmovzxbq", "vpmovzxbw", "vpmovzxdq", "vpmovzxwd", "vpmovzxwq", "vpmuldq",
+    "vpmulhrsw", "vpmulhuw", "vpmulhw", "vpmulld", "vpmullq", "vpmullw", "vpmultishiftqb", "vpmuludq",
+    "vpopcntb", "vpopcntd", "vpopcntq", "vpopcntw", "vpor", "vpord", "vporq", "vpperm",
+    "vprold", "vprolq", "vprolvd", "vprolvq", "vprord", "vprorq", "vprorvd", "vprorvq",
+    "vprotb", "vprotd", "vprotq", "vprotw", "vpsadbw", "vpscatterdd", "vpscatterdq", "vpscatterqd",
+    "vpscatterqq", "vpshab", "vpshad", "vpshaq", "vpshaw", "vpshlb", "vpshld", "vpshldd",
+    "vpshldq", "vpshldvd", "vpshldvq", "vpshldvw", "vpshldw", "vpshlq", "vpshlw", "vpshrdd",
+    "vpshrdq", "vpshrdvd", "vpshrdvq", "vpshrdvw", "vpshrdw", "vpshufb", "vpshufbitqmb", "vpshufd",
+    "vpshufhw", "vpshuflw", "vpsignb", "vpsignd", "vpsignw", "vpslld", "vpslldq", "vpsllq",
+    "vpsllvd", "vpsllvq", "vpsllvw", "vpsllw", "vpsrad", "vpsraq", "vpsravd", "vpsravq",
+    "vpsravw", "vpsraw", "vpsrld", "vpsrldq", "vpsrlq", "vpsrlvd", "vpsrlvq", "vpsrlvw",
+    "vpsrlw", "vpsubb", "vpsubd", "vpsubq", "vpsubsb", "vpsubsw", "vpsubusb", "vpsubusw",
+    "vpsubw", "vpternlogd", "vpternlogq", "vptest", "vptestmb", "vptestmd", "vptestmq", "vptestmw",
+    "vptestnmb", "vptestnmd", "vptestnmq", "vptestnmw", "vpunpckhbw", "vpunpckhdq", "vpunpckhqdq", "vpunpckhwd",
+    "vpunpcklbw", "vpunpckldq", "vpunpcklqdq", "vpunpcklwd", "vpxor", "vpxord", "vpxorq", "vrangepd",
+    "vrangeps", "vrangesd", "vrangess", "vrcp14pd", "vrcp14ps", "vrcp14sd", "vrcp14ss", "vrcp28pd",
+    "vrcp28ps", "vrcp28sd", "vrcp28ss", "vrcpps", "vrcpss", "vreducepd", "vreduceps", "vreducesd",
+    "vreducess", "vrndscalepd", "vrndscaleps", "vrndscalesd", "vrndscaless", "vroundpd", "vroundps", "vroundsd",
+    "vroundss", "vrsqrt14pd", "vrsqrt14ps", "vrsqrt14sd", "vrsqrt14ss", "vrsqrt28pd", "vrsqrt28ps", "vrsqrt28sd",
+    "vrsqrt28ss", "vrsqrtps", "vrsqrtss", "vscalefpd", "vscalefps", "vscalefsd", "vscalefss", "vscatterdpd",
+    "vscatterdps", "vscatterpf0dpd", "vscatterpf0dps", "vscatterpf0qpd", "vscatterpf0qps", "vscatterpf1dpd", "vscatterpf1dps", "vscatterpf1qpd",
+    "vscatterpf1qps", "vscatterqpd", "vscatterqps", "vshuff32x4", "vshuff64x2", "vshufi32x4", "vshufi64x2", "vshufpd",
+    "vshufps", "vsqrtpd", "vsqrtps", "vsqrtsd", "vsqrtss", "vstmxcsr", "vsubpd", "vsubps",
+    "vsubsd", "vsubss", "vtestpd", "vtestps", "vucomisd", "vucomiss", "vunpckhpd", "vunpckhps",
+    "vunpcklpd", "vunpcklps", "vxorpd", "vxorps", "vzeroall", "vzeroupper", "wait", "wbinvd",
+    "wbnoinvd", "wrfsbase", "wrgsbase", "wrmsr", "wrpkru", "wrssd", "wrssq", "wrussd",
+    "wrussq", "xabort", "xadd", "xbegin", "xbts", "xchg", "xcryptcbc", "xcryptcfb",
+    "xcryptctr", "xcryptecb", "xcryptofb", "xend", "xgetbv", "xlatb", "xor", "xorpd",
+    "xorps", "xrstor", "xrstor64", "xrstors", "xrstors64", "xsave", "xsave64", "xsavec",
+    "xsavec64", "xsaveopt", "xsaveopt64", "xsaves", "xsaves64", "xsetbv", "xsha1", "xsha256",
+    "xstore", "xtest", "rmpadjust", "rmpupdate", "psmash", "pvalidate", "serialize", "xsusldtrk",
+    "xresldtrk", "invlpgb", "tlbsync", "vmgexit", "getsecq", "sysexitq", "ldtilecfg", "tilerelease",
+    "sttilecfg", "tilezero", "tileloaddt1", "tilestored", "tileloadd", "tdpbf16ps", "tdpbuud", "tdpbusd",
+    "tdpbsud", "tdpbssd", "sysretq", "fnstdw", "fnstsg", "rdshr", "wrshr", "smint",
+    "dmint", "rdm", "svdc", "rsdc", "svldt", "rsldt", "svts", "rsts",
+    "bb0_reset", "bb1_reset", "cpu_write", "cpu_read", "altinst", "paveb", "paddsiw", "pmagw",
+    "pdistib", "psubsiw", "pmvzb", "pmvnzb", "pmvlzb", "pmvgezb", "pmulhriw", "pmachriw",
+    "ftstp", "frint2", "frichop", "frinear", "undoc", "tdcall", "seamret", "seamops",
+    "seamcall", "aesencwide128kl", "aesdecwide128kl", "aesencwide256kl", "aesdecwide256kl", "loadiwkey", "aesenc128kl", "aesdec128kl",
+    "aesenc256kl", "aesdec256kl", "encodekey128", "encodekey256", "pushad", "popad", "pushfd", "pushfq",
+    "popfd", "popfq", "iretd", "iretq", "int3", "uiret", "testui", "clui",
+    "stui", "senduipi", "hreset", "ccs_hash", "ccs_encrypt", "lkgs", "eretu", "erets",
+    "storeall", "vaddph", "vaddsh", "vcmpph", "vcmpsh", "vcomish", "vcvtdq2ph", "vcvtpd2ph",
+    "vcvtph2dq", "vcvtph2pd", "vcvtph2psx", "vcvtph2qq", "vcvtph2udq", "vcvtph2uqq", "vcvtph2uw", "vcvtph2w",
+    "vcvtps2phx", "vcvtqq2ph", "vcvtsd2sh", "vcvtsh2sd", "vcvtsh2si", "vcvtsh2ss", "vcvtsh2usi", "vcvtsi2sh",
+    "vcvtss2sh", "vcvttph2dq", "vcvttph2qq", "vcvttph2udq", "vcvttph2uqq", "vcvttph2uw", "vcvttph2w", "vcvttsh2si",
+    "vcvttsh2usi", "vcvtudq2ph", "vcvtuqq2ph", "vcvtusi2sh", "vcvtuw2ph", "vcvtw2ph", "vdivph", "vdivsh",
+    "vfcmaddcph", "vfmaddcph", "vfcmaddcsh", "vfmaddcsh", "vfcmulcph", "vfmulcph", "vfcmulcsh", "vfmulcsh",
+    "vfmaddsub132ph", "vfmaddsub213ph", "vfmaddsub231ph", "vfmsubadd132ph", "vfmsubadd213ph", "vfmsubadd231ph", "vfmadd132ph", "vfmadd213ph",
+    "vfmadd231ph", "vfnmadd132ph", "vfnmadd213ph", "vfnmadd231ph", "vfmadd132sh", "vfmadd213sh", "vfmadd231sh", "vfnmadd132sh",
+    "vfnmadd213sh", "vfnmadd231sh", "vfmsub132ph", "vfmsub213ph", "vfmsub231ph", "vfnmsub132ph", "vfnmsub213ph", "vfnmsub231ph",
+    "vfmsub132sh", "vfmsub213sh", "vfmsub231sh", "vfnmsub132sh", "vfnmsub213sh", "vfnmsub231sh", "vfpclassph", "vfpclasssh",
+    "vgetexpph", "vgetexpsh", "vgetmantph", "vgetmantsh", "vmaxph", "vmaxsh", "vminph", "vminsh",
+    "vmovsh", "vmovw", "vmulph", "vmulsh", "vrcpph", "vrcpsh", "vreduceph", "vreducesh",
+    "vrndscaleph", "vrndscalesh", "vrsqrtph", "vrsqrtsh", "vscalefph", "vscalefsh", "vsqrtph", "vsqrtsh",
+    "vsubph", "vsubsh", "vucomish", "rdudbg", "wrudbg", "clevict0", "clevict1", "delay",
+    "jknzd", "jkzd", "kand", "kandn", "kandnr", "kconcath", "kconcatl", "kextract",
+    "kmerge2l1h", "kmerge2l1l", "kmov", "knot", "kor", "kortest", "kxnor", "kxor",
+    "spflt", "tzcnti", "vaddnpd", "vaddnps", "vaddsetsps", "vcvtfxpntdq2ps", "vcvtfxpntpd2dq", "vcvtfxpntpd2udq",
+    "vcvtfxpntps2dq", "vcvtfxpntps2udq", "vcvtfxpntudq2ps", "vexp223ps", "vfixupnanpd", "vfixupnanps", "vfmadd233ps", "vgatherpf0hintdpd",
+    "vgatherpf0hintdps", "vgmaxabsps", "vgmaxpd", "vgmaxps", "vgminpd", "vgminps", "vloadunpackhd", "vloadunpackhpd",
+    "vloadunpackhps", "vloadunpackhq", "vloadunpackld", "vloadunpacklpd", "vloadunpacklps", "vloadunpacklq", "vlog2ps", "vmovnrapd",
+    "vmovnraps", "vmovnrngoapd", "vmovnrngoaps", "vpackstorehd", "vpackstorehpd", "vpackstorehps", "vpackstorehq", "vpackstoreld",
+    "vpackstorelpd", "vpackstorelps", "vpackstorelq", "vpadcd", "vpaddsetcd", "vpaddsetsd", "vpcmpltd", "vpermf32x4",
+    "vpmadd231d", "vpmadd233d", "vpmulhd", "vpmulhud", "vprefetch0", "vprefetch1", "vprefetch2", "vprefetche0",
+    "vprefetche1", "vprefetche2", "vprefetchenta", "vprefetchnta", "vpsbbd", "vpsbbrd", "vpsubrd", "vpsubrsetbd",
+    "vpsubsetbd", "vrcp23ps", "vrndfxpntpd", "vrndfxpntps", "vrsqrt23ps", "vscaleps", "vscatterpf0hintdpd", "vscatterpf0hintdps",
+    "vsubrpd", "vsubrps", "xsha512", "xstore_alt", "xsha512_alt", "zero_bytes", "aadd", "aand",
+    "aor", "axor", "cmpbexadd", "cmpbxadd", "cmplexadd", "cmplxadd", "cmpnbexadd", "cmpnbxadd",
+    "cmpnlexadd", "cmpnlxadd", "cmpnoxadd", "cmpnpxadd", "cmpnsxadd", "cmpnzxadd", "cmpoxadd", "cmppxadd",
+    "cmpsxadd", "cmpzxadd", "prefetchit0", "prefetchit1", "rdmsrlist", "rmpquery", "tdpfp16ps", "vbcstnebf162ps",
+    "vbcstnesh2ps", "vcvtneebf162ps", "vcvtneeph2ps", "vcvtneobf162ps", "vcvtneoph2ps", "vpdpbssd", "vpdpbssds", "vpdpbsud",
+    "vpdpbsuds", "vpdpbuud", "vpdpbuuds", "wrmsrlist", "wrmsrns", "tcmmrlfp16ps", "tcmmimfp16ps", "pbndkb",
+    "vpdpwsud", "vpdpwsuds", "vpdpwusd", "vpdpwusds", "vpdpwuud", "vpdpwuuds", "vsha512msg1", "vsha512msg2",
+    "vsha512rnds2", "vsm3msg1", "vsm3msg2", "vsm3rnds2", "vsm4key4", "vsm4rnds4",
+  };
+
+  /// Lowercase Register names, indexed by value (empty for the reserved values)
+  inline constexpr const char* registerNames [ 256 ] = {
+    "none", "al", "cl", "dl", "bl", "ah", "ch", "dh",
+    "bh", "spl", "bpl", "sil", "dil", "r8l", "r9l", "r10l",
+    "r11l", "r12l", "r13l", "r14l", "r15l", "ax", "cx", "dx",
+    "bx", "sp", "bp", "si", "di", "r8w", "r9w", "r10w",
+    "r11w", "r12w", "r13w", "r14w", "r15w", "eax", "ecx", "edx",
+    "ebx", "esp", "ebp", "esi", "edi", "r8d", "r9d", "r10d",
+    "r11d", "r12d", "r13d", "r14d", "r15d", "rax", "rcx", "rdx",
+    "rbx", "rsp", "rbp", "rsi", "rdi", "r8", "r9", "r10",
+    "r11", "r12", "r13", "r14", "r15", "eip", "rip", "es",
+    "cs", "ss", "ds", "fs", "gs", "xmm0", "xmm1", "xmm2",
+    "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8", "xmm9", "xmm10",
+    "xmm11", "xmm12", "xmm13", "xmm14", "xmm15", "xmm16", "xmm17", "xmm18",
+    "xmm19", "xmm20", "xmm21", "xmm22", "xmm23", "xmm24", "xmm25", "xmm26",
+    "xmm27", "xmm28", "xmm29", "xmm30", "xmm31", "ymm0", "ymm1", "ymm2",
+    "ymm3", "ymm4", "ymm5", "ymm6", "ymm7", "ymm8", "ymm9", "ymm10",
+    "ymm11", "ymm12", "ymm13", "ymm14", "ymm15", "ymm16", "ymm17", "ymm18",
+    "ymm19", "ymm20", "ymm21", "ymm22", "ymm23", "ymm24", "ymm25", "ymm26",
+    "ymm27", "ymm28", "ymm29", "ymm30", "ymm31", "zmm0", "zmm1", "zmm2",
+    "zmm3", "zmm4", "zmm5", "zmm6", "zmm7", "zmm8", "zmm9", "zmm10",
+    "zmm11", "zmm12", "zmm13", "zmm14", "zmm15", "zmm16", "zmm17", "zmm18",
+    "zmm19", "zmm20", "zmm21", "zmm22", "zmm23", "zmm24", "zmm25", "zmm26",
+    "zmm27", "zmm28", "zmm29", "zmm30", "zmm31", "k0", "k1", "k2",
+    "k3", "k4", "k5", "k6", "k7", "bnd0", "bnd1", "bnd2",
+    "bnd3", "cr0", "cr1", "cr2", "cr3", "cr4", "cr5", "cr6",
+    "cr7", "cr8", "cr9", "cr10", "cr11", "cr12", "cr13", "cr14",
+    "cr15", "dr0", "dr1", "dr2", "dr3", "dr4", "dr5", "dr6",
+    "dr7", "dr8", "dr9", "dr10", "dr11", "dr12", "dr13", "dr14",
+    "dr15", "st0", "st1", "st2", "st3", "st4", "st5", "st6",
+    "st7", "mm0", "mm1", "mm2", "mm3", "mm4", "mm5", "mm6",
+    "mm7", "tr0", "tr1", "tr2", "tr3", "tr4", "tr5", "tr6",
+    "tr7", "tmm0", "tmm1", "tmm2", "tmm3", "tmm4", "tmm5", "tmm6",
+    "tmm7", "", "", "", "", "", "", "",
+  };
+
+  /// Perfect hash (hash and displace) over mnemonicNames; empty slots hold 0xFFFF
+  inline constexpr uint16_t mnemonicHashSeeds [ 512 ] = {
+    5, 1, 12, 1, 1, 0, 5, 2, 38, 44, 4, 2, 8, 1, 1, 1,
+    2, 2, 4, 2, 5, 16, 1, 39, 9, 8, 26, 1, 14, 9, 20, 0,
+    3, 39, 7, 1, 172, 5, 24, 2, 1, 51, 30, 16, 1, 9, 5, 11,
+    36, 1, 38, 56, 0, 1, 12, 45, 87, 5, 46, 33, 1, 50, 20, 20,
+    31, 67, 5, 22, 2, 3, 1, 4, 30, 1, 60, 1, 17, 33, 22, 1,
+    1, 3, 5, 2, 3, 3, 41, 17, 8, 4, 10, 4, 7, 2, 5, 13,
+    65, 2, 7, 8, 85, 2, 1, 6, 1, 1, 36, 11, 19, 3, 19, 7,
+    24, 73, 162, 11, 15, 13, 96, 3, 3, 32, 1, 5, 1, 1, 7, 1,
+    24, 2, 38, 0, 12, 34, 8, 2, 3, 2, 17, 26, 8, 0, 3, 68,
+    6, 2, 23, 10, 12, 10, 4, 13, 1, 55, 4, 21, 4, 41, 1, 1,
+    1, 12, 34, 16, 1, 4, 5, 2, 30, 7, 6, 13, 5, 1, 129, 106,
+    51, 101, 6, 14, 32, 7, 10, 3, 21, 13, 2, 169, 6, 15, 1, 3,
+    3, 25, 14, 1, 17, 9, 94, 3, 35, 8, 11, 8, 17, 93, 7, 4,
+    7, 2, 0, 35, 1, 5, 8, 11, 1, 12, 40, 15, 48, 12, 0, 4,
+    1, 56, 4, 11, 4, 48, 64, 40, 10, 81, 6, 20, 110, 2, 52, 40,
+    13, 4, 6, 75, 50, 11, 1, 8, 99, 71, 28, 13, 3, 2, 46, 10,
+    13, 11, 3, 34, 222, 0, 2, 10, 17, 27, 26, 3, 89, 62, 28, 28,
+    30, 51, 60, 63, 5, 4, 12, 42, 22, 7, 15, 32, 2, 7, 7, 13,
+    2, 2, 3, 1, 21, 1, 25, 32, 9, 31, 17, 26, 57, 9, 238, 98,
+    47, 57, 5, 3, 16, 2, 7, 88, 12, 12, 13, 30, 8, 1, 19, 58,
+    1, 4, 123, 28, 109, 118, 51, 3, 31, 8, 65, 87, 1, 115, 16, 2,
+    11, 126, 4, 52, 82, 76, 4, 33, 1, 25, 1, 0, 34, 33, 2, 1,
+    57, 0, 142, 13, 9, 15, 4, 0, 1, 2, 5, 4, 22, 23, 51, 8,
+    149, 55, 56, 33, 177, 30, 65, 67, 142, 0, 5, 131, 192, 65, 16, 63,
+    56, 3, 1, 11, 46, 21, 1, 7, 11, 83, 3, 0, 42, 1, 13, 31,
+    158, 148, 73, 2, 76, 2, 170, 2, 116, 71, 74, 56, 72, 27, 6, 2,
+    17, 250, 36, 14, 121, 140, 63, 20, 82, 190, 6, 9, 8, 10, 18, 30,
+    6, 25, 0, 1, 56, 4, 6, 94, 318, 11, 1, 89, 1, 2, 17, 28,
+    31, 1, 4, 20, 47, 13, 15, 58, 82, 45, 15, 32, 95, 12, 80, 10,
+    27, 110, 0, 5, 18, 3, 92, 3, 67, 3, 1, 96, 22, 137, 169, 30,
+    68, 71, 52, 3, 62, 9, 70, 8, 23, 3, 42, 41, 17, 137, 151, 7,
+    1, 105, 9, 49, 6, 42, 15, 2, 53, 82, 5, 2, 70, 90, 44, 48,
+  };
+
+  inline constexpr uint16_t mnemonicHashSlots [ 2048 ] = {
+    175, 729, 594, 1802, 1097, 178, 837, 1023, 1753, 65535, 366, 418, 697, 977, 15, 33,
+    900, 170, 954, 1673, 400, 330, 521, 1690, 1246, 1717, 498, 1011, 577, 1072, 1367, 339,
+    1447, 1282, 1468, 985, 570, 1725, 1419, 564, 1364, 1776, 65535, 1676, 695, 1360, 1043, 65535,
+    953, 1076, 216, 1180, 749, 718, 796, 507, 861, 1147, 1734, 205, 1724, 1061, 1457, 1436,
+    1528, 810, 1738, 917, 590, 1751, 505, 1065, 255, 385, 1443, 659, 1574, 430, 701, 1595,
+    1404, 240, 65535, 1266, 109, 571, 200, 1604, 124, 1329, 1093, 179, 106, 65535, 375, 996,
+    1831, 133, 770, 1051, 1335, 1749, 337, 1864, 65535, 65535, 934, 1366, 1346, 919, 319, 1162,
+    655, 1342, 431, 1635, 55, 1392, 341, 925, 720, 65535, 129, 1478, 1678, 1714, 381, 1217,
+    65535, 439, 306, 26, 524, 365, 1349, 1290, 65535, 110, 789, 561, 1306, 482, 177, 1245,
+    65535, 32, 1440, 675, 470, 1384, 166, 65535, 448, 1289, 1075, 1387, 1430, 1677, 65535, 65535,
+    533, 1255, 453, 1769, 1883, 1843, 1647, 1115, 1312, 1069, 1292, 65535, 1205, 320, 518, 1547,
+    1771, 65535, 1190, 364, 609, 184, 1111, 973, 781, 896, 1027, 901, 1096, 65535, 96, 1494,
+    84, 1765, 1721, 1453, 658, 1884, 1106, 1234, 1467, 579, 160, 1080, 654, 1700, 65535, 685,
+    812, 1286, 662, 902, 1844, 644, 1795, 1117, 65535, 1331, 1277, 869, 1139, 538, 1555, 648,
+    1687, 1582, 1768, 1782, 313, 1564, 706, 817, 727, 879, 966, 1171, 757, 1233, 1304, 1489,
+    1880, 354, 1172, 243, 401, 1109, 554, 65535, 65535, 65535, 63, 1250, 1150, 1455, 1703, 657,
+    568, 1130, 1890, 327, 746, 1861, 1868, 1390, 1491, 445, 342, 443, 1527, 831, 1128, 960,
+    938, 1288, 768, 788, 1628, 868, 1505, 65535, 1382, 624, 546, 1770, 116, 484, 233, 708,
+    65535, 961, 742, 1731, 730, 1800, 1657, 144, 65535, 21, 1094, 986, 1691, 787, 786, 687,
+    7, 968, 836, 1733, 437, 146, 1533, 414, 1490, 307, 1512, 904, 1381, 784, 426, 573,
+    523, 1671, 1174, 469, 1265, 555, 1398, 822, 1400, 1718, 382, 769, 1333, 65535, 434, 1105,
+    1058, 1244, 1819, 1036, 193, 748, 1158, 888, 1155, 316, 249, 1463, 795, 747, 627, 422,
+    1182, 773, 65535, 1143, 1684, 1068, 198, 120, 10, 125, 943, 415, 275, 281, 1675, 1847,
+    1730, 181, 1762, 1556, 247, 1086, 775, 143, 1633, 373, 196, 859, 1429, 1729, 65535, 203,
+    705, 1271, 76, 758, 472, 622, 1112, 118, 1415, 1537, 559, 1744, 991, 273, 51, 863,
+    389, 357, 715, 575, 346, 583, 1012, 1569, 485, 466, 369, 1407, 1383, 962, 65535, 1229,
+    1705, 1411, 1046, 947, 1499, 58, 1593, 553, 885, 1123, 1789, 898, 1433, 1029, 1755, 1587,
+    65535, 296, 703, 510, 1541, 1857, 195, 982, 1145, 1199, 874, 511, 65535, 1766, 1545, 1226,
+    65535, 225, 927, 46, 525, 1615, 1735, 1311, 192, 65535, 65535, 752, 1855, 1683, 103, 65535,
+    862, 899, 1422, 764, 1264, 1437, 1661, 65535, 1281, 1854, 65535, 673, 1262, 254, 1560, 95,
+    665, 1167, 1276, 989, 121, 616, 65535, 1019, 744, 1010, 1192, 1087, 693, 601, 212, 1018,
+    65535, 294, 512, 65535, 1178, 674, 65535, 446, 411, 1165, 858, 1558, 652, 1370, 1160, 1378,
+    429, 1064, 978, 515, 1060, 283, 881, 1132, 1554, 65535, 221, 260, 914, 1704, 1103, 65535,
+    65535, 1872, 65535, 1375, 1606, 1631, 1394, 227, 1842, 785, 1120, 1409, 686, 640, 1737, 132,
+    65535, 1334, 1608, 1137, 1584, 305, 1260, 661, 292, 1542, 1643, 50, 199, 158, 1152, 611,
+    256, 1492, 1359, 65535, 467, 232, 1614, 1525, 1077, 963, 606, 994, 150, 1032, 268, 850,
+    604, 462, 714, 946, 1590, 548, 1142, 245, 1144, 1509, 1125, 1579, 1134, 1689, 794, 803,
+    368, 1672, 263, 218, 694, 1548, 1091, 65535, 224, 456, 671, 1879, 1837, 65535, 23, 1002,
+    754, 43, 1314, 1617, 1040, 428, 1088, 928, 1102, 983, 1004, 514, 907, 1025, 516, 1648,
+    1348, 1372, 1092, 1287, 1791, 1470, 338, 1713, 1347, 209, 1201, 967, 1373, 626, 408, 1268,
+    596, 1783, 552, 1399, 1620, 410, 1568, 1154, 1640, 820, 1352, 1113, 625, 1834, 1212, 1317,
+    1269, 18, 987, 36, 1644, 517, 57, 1095, 911, 698, 126, 65535, 28, 1784, 356, 154,
+    707, 670, 827, 1567, 1005, 1630, 1815, 1865, 65535, 1701, 98, 1278, 1801, 915, 432, 621,
+    1256, 1020, 351, 65535, 1459, 499, 647, 540, 65535, 797, 632, 49, 473, 872, 939, 1038,
+    1519, 1326, 807, 131, 1563, 1221, 65535, 1641, 1839, 1452, 501, 474, 774, 1362, 65535, 1208,
+    1014, 1284, 823, 1321, 65535, 572, 1231, 691, 608, 566, 394, 140, 1410, 780, 680, 1853,
+    1552, 383, 348, 1610, 563, 1209, 310, 1118, 61, 315, 1594, 1651, 1179, 496, 1652, 826,
+    1607, 1487, 1583, 1838, 1806, 1670, 1634, 1693, 1549, 1417, 1807, 1508, 909, 1516, 274, 1187,
+    1156, 65535, 1089, 950, 463, 877, 367, 1414, 65535, 335, 1368, 941, 1699, 1460, 1697, 1506,
+    65535, 586, 1874, 78, 582, 1393, 13, 1054, 1254, 65535, 1238, 1057, 1473, 970, 223, 1754,
+    65535, 34, 1418, 581, 1252, 65535, 191, 1829, 1001, 906, 1597, 1177, 1636, 912, 1796, 926,
+    759, 1852, 68, 964, 65535, 536, 1149, 1526, 574, 1195, 471, 30, 1151, 739, 876, 731,
+    324, 186, 308, 435, 277, 1892, 298, 984, 70, 1811, 29, 799, 457, 1645, 892, 1062,
+    1761, 326, 1416, 1222, 1305, 636, 399, 1243, 532, 349, 1220, 328, 65535, 207, 761, 839,
+    461, 65535, 1391, 162, 1618, 172, 374, 865, 105, 979, 1832, 1446, 1176, 1790, 65535, 1395,
+    940, 1291, 204, 128, 1379, 1230, 605, 1028, 65535, 1495, 620, 1170, 65535, 1588, 1893, 442,
+    819, 487, 475, 1466, 1870, 402, 1764, 168, 551, 171, 361, 637, 65535, 486, 1609, 1760,
+    531, 332, 65535, 1049, 1827, 1442, 591, 1709, 856, 860, 1572, 3, 1037, 1084, 1522, 1320,
+    894, 1462, 458, 834, 252, 1000, 1878, 1723, 1561, 716, 25, 187, 65535, 878, 413, 1432,
+    1293, 756, 65535, 1763, 529, 1493, 1710, 1298, 642, 599, 460, 1477, 65535, 440, 1856, 997,
+    1885, 398, 1822, 1601, 65535, 633, 1515, 639, 1488, 753, 800, 669, 1778, 393, 436, 791,
+    1471, 908, 1702, 846, 1024, 114, 1622, 258, 910, 45, 1538, 340, 1240, 1242, 12, 1247,
+    1339, 847, 454, 19, 1483, 1426, 1169, 1454, 646, 425, 1223, 699, 65535, 65535, 65535, 65535,
+    350, 91, 1050, 1774, 1535, 1337, 1369, 849, 1273, 65535, 1581, 1297, 1343, 65535, 762, 290,
+    65535, 1445, 41, 959, 1858, 65535, 65535, 156, 1596, 182, 27, 42, 891, 210, 584, 630,
+    763, 447, 1474, 48, 1325, 1531, 151, 1758, 1108, 1313, 1408, 779, 65535, 713, 867, 619,
+    1083, 79, 1664, 229, 1336, 112, 65535, 73, 1570, 1100, 65535, 743, 1779, 476, 1712, 1257,
+    1475, 676, 1146, 811, 829, 974, 1354, 291, 65535, 736, 65535, 893, 1047, 1194, 1249, 137,
+    65535, 219, 65535, 459, 751, 1215, 211, 1274, 833, 930, 492, 717, 890, 107, 732, 1424,
+    1211, 628, 406, 494, 481, 352, 1877, 71, 722, 1053, 663, 1513, 798, 65535, 958, 433,
+    206, 1685, 1444, 1239, 1524, 65535, 667, 321, 1186, 386, 1830, 1792, 944, 1129, 165, 1674,
+    1464, 1814, 1654, 1589, 220, 1740, 1496, 104, 666, 1748, 405, 1616, 235, 790, 1739, 86,
+    1682, 740, 65535, 416, 1821, 767, 1869, 189, 897, 615, 660, 173, 345, 1124, 1423, 202,
+    1848, 1833, 875, 322, 65535, 1562, 24, 285, 1435, 495, 67, 250, 1153, 1860, 948, 39,
+    1006, 828, 65535, 922, 924, 1345, 1258, 1371, 65535, 635, 180, 1578, 1138, 412, 1575, 1013,
+    952, 185, 602, 1389, 451, 242, 776, 1746, 478, 595, 215, 818, 672, 1862, 830, 1206,
+    1327, 580, 1529, 1116, 1441, 502, 855, 1632, 282, 585, 359, 65535, 587, 1148, 427, 1235,
+    1270, 363, 301, 1110, 1450, 65535, 1688, 251, 1759, 527, 1041, 1523, 1540, 880, 336, 334,
+    1461, 801, 65535, 618, 391, 993, 1600, 1361, 1340, 108, 1817, 1309, 1669, 65535, 854, 1517,
+    1681, 65535, 65535, 1033, 1481, 1805, 1480, 569, 864, 1241, 1840, 1655, 1055, 176, 1518, 692,
+    1514, 1813, 1873, 44, 1218, 65535, 520, 149, 1126, 65535, 923, 1328, 1181, 920, 1586, 237,
+    1052, 1341, 65535, 1520, 999, 101, 1228, 1082, 1319, 1251, 134, 1420, 704, 1745, 935, 1198,
+    1694, 197, 1818, 65535, 1456, 119, 734, 1497, 634, 65535, 1794, 1357, 843, 449, 217, 738,
+    1804, 544, 1722, 1163, 1465, 1403, 1272, 845, 1624, 1449, 65535, 1412, 1009, 1715, 299, 465,
+    1085, 649, 1310, 679, 392, 65535, 1224, 1363, 1592, 318, 777, 873, 188, 270, 1787, 643,
+    244, 241, 1066, 1767, 750, 190, 312, 141, 1797, 56, 65535, 1786, 159, 1063, 1679, 832,
+    857, 75, 995, 53, 539, 66, 526, 35, 1498, 677, 887, 1022, 300, 214, 1330, 1875,
+    419, 148, 1716, 535, 1003, 444, 1008, 578, 1539, 1803, 1351, 688, 1649, 77, 265, 841,
+    493, 712, 1775, 905, 1259, 1104, 1374, 792, 65535, 1756, 816, 142, 728, 1565, 1044, 1859,
+    65535, 387, 1090, 40, 1376, 1350, 2, 600, 1585, 347, 1301, 1048, 1659, 737, 1638, 1502,
+    1405, 276, 1708, 1660, 607, 1017, 360, 1344, 1695, 377, 1750, 1034, 1253, 990, 1280, 65535,
+    65535, 509, 269, 65535, 1692, 262, 1318, 1396, 9, 1720, 1133, 11, 1534, 378, 1812, 593,
+    550, 65535, 65535, 1662, 690, 1356, 1299, 480, 1667, 1059, 1203, 65535, 65535, 1308, 1365, 1629,
+    848, 1484, 1889, 1261, 65535, 69, 1845, 1504, 65535, 724, 976, 280, 37, 65535, 949, 1127,
+    65535, 918, 130, 766, 1267, 1421, 1808, 932, 293, 760, 1197, 417, 617, 1070, 965, 895,
+    557, 1887, 65535, 629, 1236, 14, 815, 1550, 421, 1650, 65535, 710, 1300, 741, 1742, 1507,
+    52, 16, 92, 1073, 65535, 1479, 497, 631, 765, 1605, 1665, 1850, 545, 1656, 1316, 379,
+    1, 745, 1107, 1119, 167, 696, 913, 253, 547, 1358, 560, 1591, 1204, 1067, 1867, 370,
+    650, 208, 1866, 556, 1191, 955, 65535, 1079, 1214, 1772, 1559, 603, 157, 1279, 1551, 1476,
+    1210, 152, 455, 929, 65535, 1283, 723, 1747, 1166, 358, 1891, 844, 1732, 1621, 916, 115,
+    1189, 508, 709, 452, 1543, 271, 1042, 678, 1810, 390, 1557, 64, 804, 127, 638, 733,
+    234, 1503, 1185, 1307, 612, 1642, 534, 598, 1078, 1799, 549, 1639, 1071, 623, 702, 163,
+    88, 236, 488, 479, 980, 1666, 1816, 614, 681, 1536, 1613, 684, 1603, 588, 1427, 1841,
+    5, 1824, 519, 503, 937, 1183, 1663, 65535, 1637, 138, 1793, 682, 396, 1757, 793, 344,
+    852, 1881, 1532, 1598, 1402, 468, 1413, 65535, 1248, 522, 22, 1482, 1159, 1573, 610, 65535,
+    1173, 1711, 309, 155, 1752, 80, 653, 656, 1074, 297, 1168, 1121, 491, 1322, 1098, 1472,
+    1736, 1876, 97, 302, 542, 1486, 528, 1619, 771, 1294, 921, 1157, 933, 558, 65535, 504,
+    1826, 838, 355, 942, 388, 1658, 1332, 353, 314, 65535, 1882, 65535, 1031, 755, 489, 246,
+    1385, 266, 1521, 1863, 772, 1809, 20, 1425, 711, 1851, 371, 47, 645, 65, 65535, 1743,
+    824, 231, 1207, 1406, 1580, 1741, 228, 1388, 343, 287, 99, 407, 969, 194, 323, 721,
+    441, 500, 60, 1627, 1056, 286, 1828, 1175, 1438, 1788, 1021, 782, 477, 689, 380, 1140,
+    1698, 1668, 956, 409, 1798, 8, 4, 651, 778, 82, 135, 0, 541, 853, 1696, 971,
+    1039, 226, 65535, 1401, 613, 1577, 65535, 65535, 1777, 806, 1773, 1707, 201, 1045, 821, 164,
+    889, 1544, 450, 311, 1016, 1131, 65535, 325, 65535, 1823, 1886, 279, 945, 1458, 267, 1355,
+    395, 259, 1193, 576, 1719, 213, 230, 870, 842, 975, 513, 1015, 882, 1646, 87, 1213,
+    423, 1602, 72, 100, 1680, 1026, 65535, 835, 81, 1324, 808, 1566, 530, 988, 565, 668,
+    1434, 1122, 589, 372, 1136, 1820, 153, 1161, 1728, 1511, 1232, 1338, 329, 317, 957, 1295,
+    998, 397, 951, 289, 1377, 295, 725, 1135, 1625, 726, 851, 1184, 805, 123, 1081, 1546,
+    883, 222, 641, 65535, 420, 802, 1653, 814, 62, 59, 866, 464, 1099, 592, 74, 17,
+    1501, 147, 93, 136, 562, 1323, 1571, 65535, 94, 1825, 1439, 248, 1448, 54, 1431, 1599,
+    89, 1706, 102, 183, 139, 1202, 174, 1227, 1510, 65535, 735, 783, 1727, 65535, 38, 1302,
+    278, 65535, 1216, 809, 65535, 840, 1781, 261, 1315, 1380, 506, 424, 333, 1469, 1576, 6,
+    1200, 483, 1141, 1780, 1296, 303, 1164, 1397, 264, 272, 537, 1835, 304, 1007, 1237, 1500,
+    1530, 65535, 65535, 1611, 438, 1888, 239, 825, 813, 903, 1623, 1188, 664, 257, 1485, 1303,
+    288, 85, 331, 1196, 981, 65535, 31, 376, 1225, 65535, 384, 65535, 1785, 1114, 90, 1686,
+    683, 169, 1285, 871, 1612, 490, 122, 884, 65535, 1626, 1353, 111, 931, 1386, 1263, 719,
+    1726, 83, 362, 1849, 972, 543, 117, 1451, 1846, 992, 1275, 567, 404, 1553, 65535, 161,
+    1428, 597, 886, 1836, 700, 1219, 403, 1030, 1101, 1871, 145, 113, 238, 936, 284, 1035,
+  };
+
+  /// Perfect hash over registerNames
+  inline constexpr uint16_t registerHashSeeds [ 128 ] = {
+    1, 3, 1, 2, 1, 2, 3, 9, 1, 4, 2, 3, 1, 1, 2, 3,
+    2, 4, 1, 1, 0, 1, 1, 2, 0, 1, 1, 3, 3, 6, 1, 1,
+    2, 1, 1, 4, 3, 2, 1, 1, 3, 2, 1, 1, 2, 2, 1, 1,
+    0, 1, 1, 3, 1, 1, 1, 1, 1, 2, 1, 1, 1, 5, 0, 1,
+    1, 1, 1, 2, 6, 2, 1, 2, 1, 1, 3, 2, 3, 3, 2, 8,
+    2, 3, 9, 3, 0, 0, 0, 2, 1, 10, 2, 0, 0, 1, 1, 3,
+    1, 1, 1, 0, 2, 2, 1, 1, 4, 0, 0, 4, 4, 1, 0, 7,
+    1, 1, 3, 2, 5, 4, 1, 1, 0, 2, 0, 1, 1, 3, 1, 1,
+  };
+
+  inline constexpr uint16_t registerHashSlots [ 512 ] = {
+    80, 214, 42, 65535, 65535, 179, 65535, 65535, 65535, 49, 57, 65535, 65535, 65535, 65535, 201,
+    186, 65535, 199, 65535, 129, 223, 68, 5, 7, 26, 65535, 65535, 65535, 65535, 65535, 65535,
+    65535, 65535, 195, 65535, 13, 113, 65535, 65535, 65535, 65535, 182, 65535, 44, 65535, 37, 36,
+    72, 65535, 65535, 65535, 217, 235, 65535, 29, 65535, 152, 65535, 65535, 65535, 109, 66, 20,
+    117, 192, 165, 136, 65535, 65535, 65535, 248, 86, 65535, 3, 65535, 65535, 65535, 124, 65535,
+    114, 50, 65535, 65535, 65535, 65535, 65535, 207, 17, 236, 125, 65535, 56, 19, 240, 89,
+    46, 65535, 237, 65535, 65535, 188, 25, 132, 65535, 65535, 218, 65535, 65535, 45, 65535, 65535,
+    135, 65535, 92, 181, 65535, 27, 65535, 65535, 65535, 111, 98, 65535, 247, 65535, 65535, 65535,
+    94, 52, 100, 75, 123, 65535, 82, 189, 31, 163, 65535, 171, 131, 65535, 198, 15,
+    65535, 9, 65535, 143, 65535, 65535, 65535, 65535, 93, 174, 64, 65535, 144, 2, 65535, 120,
+    87, 16, 148, 112, 0, 65535, 65535, 65535, 69, 65535, 65535, 65535, 65535, 65535, 65, 65535,
+    234, 161, 23, 43, 61, 107, 156, 65535, 65535, 147, 146, 84, 65535, 166, 246, 65535,
+    65535, 65535, 65535, 176, 244, 65535, 65535, 65535, 242, 65535, 65535, 220, 65535, 65535, 6, 65535,
+    99, 65535, 206, 238, 150, 168, 65535, 47, 215, 65535, 65535, 54, 167, 137, 65535, 65535,
+    65535, 65535, 228, 65535, 71, 65535, 65535, 65535, 39, 73, 65535, 65535, 119, 65535, 21, 65535,
+    101, 74, 65535, 65535, 102, 65535, 90, 65535, 221, 65535, 32, 65535, 65535, 79, 65535, 191,
+    65535, 128, 216, 65535, 208, 65535, 65535, 65535, 190, 10, 225, 227, 233, 232, 60, 83,
+    65535, 65535, 65535, 204, 65535, 65535, 205, 65535, 65535, 63, 65535, 196, 164, 65535, 65535, 185,
+    197, 65535, 65535, 65535, 65535, 58, 118, 65535, 77, 213, 65535, 65535, 65535, 65535, 122, 65535,
+    65535, 105, 18, 65535, 65535, 65535, 159, 65535, 149, 65535, 200, 177, 70, 138, 210, 65535,
+    65535, 65535, 88, 65535, 4, 145, 170, 65535, 219, 65535, 239, 35, 40, 65535, 65535, 65535,
+    65535, 65535, 65535, 140, 65535, 65535, 202, 65535, 65535, 65535, 65535, 231, 184, 65535, 193, 160,
+    65535, 65535, 65535, 65535, 126, 127, 65535, 65535, 142, 110, 65535, 157, 65535, 241, 65535, 30,
+    97, 1, 65535, 65535, 65535, 8, 65535, 65535, 65535, 78, 65535, 65535, 103, 65535, 62, 65535,
+    55, 65535, 65535, 65535, 243, 172, 65535, 183, 65535, 65535, 158, 130, 65535, 65535, 65535, 91,
+    81, 65535, 65535, 41, 211, 65535, 65535, 65535, 65535, 51, 153, 65535, 65535, 65535, 65535, 65535,
+    116, 104, 65535, 65535, 65535, 106, 229, 151, 95, 65535, 48, 155, 226, 65535, 134, 224,
+    65535, 230, 222, 162, 65535, 76, 65535, 65535, 203, 65535, 33, 115, 59, 65535, 65535, 22,
+    34, 65535, 65535, 173, 175, 65535, 85, 65535, 65535, 65535, 65535, 38, 14, 11, 65535, 24,
+    65535, 65535, 65535, 209, 65535, 180, 65535, 65535, 65535, 96, 245, 65535, 65535, 65535, 133, 187,
+    65535, 65535, 65535, 65535, 65535, 121, 65535, 65535, 65535, 65535, 28, 12, 65535, 141, 65535, 139,
+    53, 65535, 65535, 65535, 67, 65535, 65535, 169, 65535, 65535, 65535, 178, 212, 194, 108, 154,
+  };
+
+  constexpr char lower_ascii ( char c ) noexcept { return c >= 'A' && c <= 'Z' ? static_cast< char >( c + ( 'a' - 'A' ) ) : c; }
+
+  /// Hash used by the perfect hash tables: FNV-1a over the lowercased name, then a final mix
+  constexpr uint32_t name_hash ( const char* text, size_t length, uint32_t seed ) noexcept {
+    uint32_t hash = 2166136261u ^ seed;
+    for ( size_t index = 0; index < length; ++index ) {
+      hash ^= static_cast< uint8_t >( lower_ascii ( text [ index ] ) );
+      hash *= 16777619u;
+    }
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+  }
+
+  /// <returns>Index of `text` (case-insensitive) in `names`, or -1</returns>
+  template<size_t Buckets, size_t Slots, size_t Count>
+  constexpr int name_lookup ( const uint16_t ( &seeds ) [ Buckets ], const uint16_t ( &slots ) [ Slots ],
+                                        const char* const ( &names ) [ Count ], const char* text, size_t length ) noexcept {
+    const auto value = slots [ name_hash ( text, length, seeds [ name_hash ( text, length, 0 ) % Buckets ] ) % Slots ];
+    if ( value >= Count ) {
+      return -1;
+    }
+
+    const auto* name = names [ value ];
+    for ( size_t index = 0; index < length; ++index ) {
+      if ( name [ index ] != lower_ascii ( text [ index ] ) ) {
+        return -1;
+      }
+    }
+    return name [ length ] == '\0' ? value : -1;
+  }
+
+  struct IcedSymbol {
+    uint64_t address;
+    const char* name;
+    size_t name_length;
+  };
+
+  using IcedSymbolCallback = bool ( * )( void* context, uint64_t address, IcedSymbol* out );
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+#ifndef __ICED_IO_DEF
+#define __ICED_IO_DEF
+
+#include "iced.hpp"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace iced
+{
+	/// <summary>
+	///  Read-only memory mapping of a whole file. Pages are only faulted in when touched.
+	/// </summary>
+	class MappedFile {
+	public:
+		MappedFile ( ) = default;
+		explicit MappedFile ( const char* path ) { open ( path ); }
+
+		MappedFile ( const MappedFile& ) = delete;
+		MappedFile& operator=( const MappedFile& ) = delete;
+
+		MappedFile ( MappedFile&& other ) noexcept : data_ ( other.data_ ), size_ ( other.size_ ) {
+			other.data_ = nullptr;
+			other.size_ = 0;
+		}
+
+		MappedFile& operator=( MappedFile&& other ) noexcept {
+			if ( this != &other ) {
+				close ( );
+				data_ = other.data_;
+				size_ = other.size_;
+				other.data_ = nullptr;
+				other.size_ = 0;
+			}
+			return *this;
+		}
+
+		~MappedFile ( ) { close ( ); }
+
+		bool open ( const char* path ) noexcept {
+			close ( );
+#if defined(_WIN32)
+			const auto file = CreateFileA ( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+			if ( file == INVALID_HANDLE_VALUE ) {
+				return false;
+			}
+
+			LARGE_INTEGER size {};
+			if ( !GetFileSizeEx ( file, &size ) || size.QuadPart == 0 ) {
+				CloseHandle ( file );
+				return false;
+			}
+
+			const auto mapping = CreateFileMappingA ( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+			CloseHandle ( file );
+			if ( !mapping ) {
+				return false;
+			}
+
+			const auto view = MapViewOfFile ( mapping, FILE_MAP_READ, 0, 0, 0 );
+			CloseHandle ( mapping );
+			if ( !view ) {
+				return false;
+			}
+
+			data_ = static_cast< const std::uint8_t* >( view );
+			size_ = static_cast< std::size_t >( size.QuadPart );
+#else
+			const auto fd = ::open ( path, O_RDONLY );
+			if ( fd < 0 ) {
+				return false;
+			}
+
+			struct stat info {};
+			if ( fstat ( fd, &info ) != 0 || info.st_size == 0 ) {
+				::close ( fd );
+				return false;
+			}
+
+			const auto view = mmap ( nullptr, static_cast< std::size_t >( info.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+			::close ( fd );
+			if ( view == MAP_FAILED ) {
+				return false;
+			}
+
+			data_ = static_cast< const std::uint8_t* >( view );
+			size_ = static_cast< std::size_t >( info.st_size );
+#endif
+			return true;
+		}
+
+		void close ( ) noexcept {
+			if ( !data_ ) {
+				return;
+			}
+#if defined(_WIN32)
+			UnmapViewOfFile ( data_ );
+#else
+			munmap ( const_cast< std::uint8_t* >( data_ ), size_ );
+#endif
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+		NODISCARD FORCE_INLINE bool is_open ( ) const noexcept { return data_ != nullptr; }
+		NODISCARD FORCE_INLINE const std::uint8_t* data ( ) const noexcept { return data_; }
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return size_; }
+
+	private:
+		const std::uint8_t* data_ = nullptr;
+		std::size_t size_ = 0;
+	};
+
+	/// <summary>
+	///  Collects small writes into one large buffer and hands it to fwrite in big blocks.
+	///  Writes at least as large as the buffer skip the copy and go straight to the file.
+	///  The first failed fwrite, fflush or stream error sticks: later writes are dropped and
+	///  flush ( ) / good ( ) report false, so callers can turn it into an exit status.
+	/// </summary>
+	class BufferedWriter {
+	public:
+		static constexpr std::size_t defaultCapacity = 1 << 22;
+
+		/// <param name="capacity">buffer size in bytes, at least 1</param>
+		explicit BufferedWriter ( std::FILE* file, std::size_t capacity = defaultCapacity )
+			: file_ ( file ), buffer_ ( new char [ std::max<std::size_t> ( capacity, 1 ) ] ), capacity_ ( std::max<std::size_t> ( capacity, 1 ) ),
+			failed_ ( !file ) { }
+
+		BufferedWriter ( const BufferedWriter& ) = delete;
+		BufferedWriter& operator=( const BufferedWriter& ) = delete;
+
+		~BufferedWriter ( ) { flush ( ); }
+
+		void write ( const char* data, std::size_t size ) noexcept {
+			if ( size > capacity_ - used_ ) {
+				flush ( );
+				if ( size >= capacity_ ) {
+					commit ( data, size );
+					return;
+				}
+			}
+
+			std::memcpy ( buffer_.get ( ) + used_, data, size );
+			used_ += size;
+		}
+
+		FORCE_INLINE void write ( std::string_view text ) noexcept { write ( text.data ( ), text.size ( ) ); }
+
+		FORCE_INLINE void put ( char value ) noexcept {
+			if ( used_ == capacity_ ) {
+				flush ( );
+			}
+			buffer_ [ used_++ ] = value;
+		}
+
+		/// <summary>
+		///  Hands the buffer to the file and flushes the stream, so errors stdio would only
+		///  report on fclose ( e.g. a full disk or closed pipe on stdout ) surface here
+		/// </summary>
+		/// <returns>false once any write to the file has failed</returns>
+		bool flush ( ) noexcept {
+			if ( used_ ) {
+				commit ( buffer_.get ( ), used_ );
+				used_ = 0;
+			}
+			if ( !failed_ ) {
+				failed_ = std::fflush ( file_ ) != 0 || std::ferror ( file_ );
+			}
+			return !failed_;
+		}
+
+		NODISCARD FORCE_INLINE bool good ( ) const noexcept { return !failed_; }
+		NODISCARD FORCE_INLINE std::uint64_t written ( ) const noexcept { return written_ + used_; }
+
+	private:
+		void commit ( const char* data, std::size_t size ) noexcept {
+			if ( failed_ ) {
+				return;
+			}
+
+			const auto done = std::fwrite ( data, 1, size, file_ );
+			written_ += done;
+			failed_ = done != size || std::ferror ( file_ );
+		}
+
+		std::FILE* file_;
+		std::unique_ptr<char [ ]> buffer_;
+		std::size_t capacity_;
+		std::size_t used_ = 0;
+		std::uint64_t written_ = 0;
+		bool failed_ = false;
+	};
+};
+#endif
@@ -0,0 +1,510 @@
+#pragma once
+#ifndef __ICED_LENGTH_DEF
+#define __ICED_LENGTH_DEF
+
+#include "iced.hpp"
+
+namespace iced
+{
+	/// <summary>
+	///  Native x86-64 instruction length decoding for scans that only need boundaries (boundary
+	///  maps, padding skipping, superset passes). Table driven and header only, so it inlines
+	///  into the caller's loop instead of paying a backend call per instruction. It follows
+	///  iced's lengths for every encoding iced accepts, but checks validity only coarsely:
+	///  undefined opcodes, invalid prefix combinations and lock on anything but the memory form
+	///  of a lockable instruction are rejected, other operand constraints and undefined
+	///  VEX/EVEX/XOP opcodes are not.
+	/// </summary>
+	namespace length
+	{
+		/// Opcode table entries
+		enum Flags : std::uint8_t {
+			ModRm = 0x01,
+			ImmMask = 0x0E,
+			Imm8 = 0x02,
+			Imm16 = 0x04,
+			ImmZ = 0x06,    // 16 or 32 bits by operand size
+			Enter = 0x08,   // imm16 + imm8
+			ImmV = 0x0A,    // 16, 32 or 64 bits by operand size (mov r, imm)
+			Moffs = 0x0C,   // 32 or 64 bits by address size
+			Imm32 = 0x0E,   // rel32, the operand size prefix is ignored in 64-bit mode
+			Escape = 0x10,  // 0F, or the VEX, EVEX and XOP escapes C4, C5, 62 and 8F
+			Lockable = 0x20, // lock is valid with a memory operand, see lock_allowed ( )
+			Special = 0x40, // validity or immediate depends on the ModRM byte or a mandatory prefix
+			Invalid = 0x80,
+		};
+
+		/// Prefix table entries
+		enum Prefix : std::uint8_t {
+			OperandSize = 0x01,
+			AddressSize = 0x02,
+			Lock = 0x04,
+			Repeat = 0x08,
+			Segment = 0x10,
+			Rex = 0x20,
+		};
+
+		/// ModRM table entries: bytes of ModRM and displacement, plus a flag when a SIB byte follows
+		constexpr std::uint8_t sibFollows = 0x80;
+
+		struct Tables {
+			std::uint8_t prefix [ 256 ];
+			std::uint8_t oneByte [ 256 ];
+			std::uint8_t map0F [ 256 ];
+			std::uint8_t map0F38 [ 256 ];
+			std::uint8_t map0F3A [ 256 ];
+			std::uint8_t modrm [ 256 ];
+			// Immediate bytes of each ImmMask kind, 4 bits per kind, by operand size 32/16/64
+			// (+3 with the address size prefix); kept in registers rather than looked up per opcode
+			std::uint32_t immediate [ 6 ];
+		};
+
+		constexpr Tables build_tables ( ) noexcept {
+			Tables tables {};
+			const auto set = [ ] ( std::uint8_t* table, unsigned first, unsigned last, std::uint8_t flags ) {
+				for ( auto opcode = first; opcode <= last; ++opcode ) {
+					table [ opcode ] = flags;
+				}
+			};
+
+			auto* prefix = tables.prefix;
+			set ( prefix, 0x40, 0x4F, Rex );
+			prefix [ 0x66 ] = OperandSize;
+			prefix [ 0x67 ] = AddressSize;
+			prefix [ 0xF0 ] = Lock;
+			prefix [ 0xF2 ] = Repeat;
+			prefix [ 0xF3 ] = Repeat;
+			for ( auto opcode : { 0x26, 0x2E, 0x36, 0x3E, 0x64, 0x65 } ) {
+				prefix [ opcode ] = Segment;
+			}
+
+			auto* one = tables.oneByte;
+			for ( unsigned row = 0x00; row < 0x40; row += 8 ) {
+				set ( one, row, row + 3, ModRm );
+				one [ row + 4 ] = Imm8;
+				one [ row + 5 ] = ImmZ;
+				// add ... xor r/m, r; cmp ( row 0x38 ) never writes
+				if ( row != 0x38 ) {
+					set ( one, row, row + 1, ModRm | Lockable );
+				}
+			}
+			for ( auto opcode : { 0x06, 0x07, 0x0E, 0x16, 0x17, 0x1E, 0x1F, 0x27, 0x2F, 0x37, 0x3F, 0x60, 0x61, 0x82, 0x9A, 0xCE, 0xD4, 0xD5, 0xD6, 0xEA } ) {
+				one [ opcode ] = Invalid;
+			}
+			for ( auto opcode : { 0x0F, 0x62, 0x8F, 0xC4, 0xC5 } ) {
+				one [ opcode ] = Escape;
+			}
+			one [ 0x63 ] = ModRm;
+			one [ 0x68 ] = ImmZ;
+			one [ 0x69 ] = ModRm | ImmZ;
+			one [ 0x6A ] = Imm8;
+			one [ 0x6B ] = ModRm | Imm8;
+			set ( one, 0x70, 0x7F, Imm8 );
+			one [ 0x80 ] = ModRm | Imm8 | Lockable;
+			one [ 0x81 ] = ModRm | ImmZ | Lockable;
+			one [ 0x83 ] = ModRm | Imm8 | Lockable;
+			set ( one, 0x84, 0x8B, ModRm );
+			set ( one, 0x86, 0x87, ModRm | Lockable );
+			one [ 0x8C ] = ModRm | Special;
+			one [ 0x8D ] = ModRm | Special;
+			one [ 0x8E ] = ModRm | Special;
+			set ( one, 0xA0, 0xA3, Moffs );
+			one [ 0xA8 ] = Imm8;
+			one [ 0xA9 ] = ImmZ;
+			set ( one, 0xB0, 0xB7, Imm8 );
+			set ( one, 0xB8, 0xBF, ImmV );
+			one [ 0xC0 ] = ModRm | Imm8;
+			one [ 0xC1 ] = ModRm | Imm8;
+			one [ 0xC2 ] = Imm16;
+			one [ 0xC6 ] = ModRm | Imm8 | Special;
+			one [ 0xC7 ] = ModRm | ImmZ | Special;
+			one [ 0xC8 ] = Enter;
+			one [ 0xCA ] = Imm16;
+			one [ 0xCD ] = Imm8;
+			set ( one, 0xD0, 0xD3, ModRm );
+			set ( one, 0xD8, 0xDF, ModRm );
+			set ( one, 0xE0, 0xE7, Imm8 );
+			one [ 0xE8 ] = Imm32;
+			one [ 0xE9 ] = Imm32;
+			one [ 0xEB ] = Imm8;
+			set ( one, 0xF6, 0xF7, ModRm | Special | Lockable );
+			set ( one, 0xFE, 0xFF, ModRm | Special | Lockable );
+
+			auto* two = tables.map0F;
+			set ( two, 0x00, 0xFF, ModRm );
+			for ( auto opcode : { 0x05, 0x06, 0x07, 0x08, 0x09, 0x0B, 0x0E, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x37, 0x77, 0xA0, 0xA1, 0xA2, 0xA8, 0xA9, 0xAA } ) {
+				two [ opcode ] = 0;
+			}
+			for ( auto opcode : { 0x04, 0x0A, 0x0C, 0x36, 0x39, 0x7A, 0x7B } ) {
+				two [ opcode ] = Invalid;
+			}
+			two [ 0x0F ] = ModRm | Imm8; // 3DNow!, the suffix opcode sits where an imm8 would
+			set ( two, 0x20, 0x23, ModRm | Special );
+			set ( two, 0x24, 0x27, Invalid );
+			set ( two, 0x3B, 0x3F, Invalid );
+			set ( two, 0x70, 0x73, ModRm | Imm8 );
+			two [ 0x78 ] = ModRm | Special;
+			set ( two, 0x80, 0x8F, Imm32 );
+			two [ 0xA4 ] = ModRm | Imm8;
+			two [ 0xAC ] = ModRm | Imm8;
+			for ( auto opcode : { 0xAB, 0xB0, 0xB1, 0xB3, 0xBB, 0xC0, 0xC1, 0xC7 } ) {
+				two [ opcode ] = ModRm | Lockable; // bts, cmpxchg, btr, btc, xadd, cmpxchg8b/16b
+			}
+			two [ 0xB8 ] = ModRm | Special;
+			two [ 0xBA ] = ModRm | Imm8 | Special | Lockable;
+			two [ 0xC2 ] = ModRm | Imm8;
+			set ( two, 0xC4, 0xC6, ModRm | Imm8 );
+			set ( two, 0xC8, 0xCF, 0 );
+
+			set ( tables.map0F38, 0x00, 0xFF, Invalid );
+			const std::pair<unsigned, unsigned> defined0F38 [ ] = {
+				{ 0x00, 0x0B }, { 0x10, 0x10 }, { 0x14, 0x15 }, { 0x17, 0x17 }, { 0x1C, 0x1E }, { 0x20, 0x25 }, { 0x28, 0x2B },
+				{ 0x30, 0x35 }, { 0x37, 0x41 }, { 0x80, 0x82 }, { 0xC8, 0xCD }, { 0xCF, 0xCF }, { 0xD8, 0xDF }, { 0xF0, 0xF1 },
+				{ 0xF5, 0xF6 }, { 0xF8, 0xFC },
+			};
+			for ( const auto& range : defined0F38 ) {
+				set ( tables.map0F38, range.first, range.second, ModRm );
+			}
+
+			set ( tables.map0F3A, 0x00, 0xFF, Invalid );
+			const std::pair<unsigned, unsigned> defined0F3A [ ] = {
+				{ 0x08, 0x0F }, { 0x14, 0x17 }, { 0x20, 0x22 }, { 0x40, 0x42 }, { 0x44, 0x44 }, { 0x60, 0x63 }, { 0xCC, 0xCC },
+				{ 0xCE, 0xCF }, { 0xDF, 0xDF }, { 0xF0, 0xF0 },
+			};
+			for ( const auto& range : defined0F3A ) {
+				set ( tables.map0F3A, range.first, range.second, ModRm | Imm8 );
+			}
+
+			for ( unsigned modrm = 0; modrm < 256; ++modrm ) {
+				const auto mod = modrm >> 6;
+				const auto rm = modrm & 7;
+				std::uint8_t bytes = 1;
+				if ( mod == 1 ) {
+					bytes += 1;
+				}
+				else if ( mod == 2 || ( mod == 0 && rm == 5 ) ) {
+					bytes += 4;
+				}
+				tables.modrm [ modrm ] = mod != 3 && rm == 4 ? bytes | sibFollows : bytes;
+			}
+
+			for ( unsigned mode = 0; mode < 6; ++mode ) {
+				const auto operandSize = mode % 3;
+				const std::uint32_t bytes [ 8 ] = {
+					0, 1, 2, operandSize == 1 ? 2u : 4u, 3, operandSize == 1 ? 2u : operandSize == 2 ? 8u : 4u, mode >= 3 ? 4u : 8u, 4,
+				};
+				for ( unsigned kind = 0; kind < 8; ++kind ) {
+					tables.immediate [ mode ] |= bytes [ kind ] << ( kind * 4 );
+				}
+			}
+			return tables;
+		}
+
+		inline constexpr Tables tables = build_tables ( );
+
+		/// Longest possible x86 instruction
+		constexpr std::size_t maxLength = 15;
+
+		/// Bytes taken by the ModRM byte at `offset` with its SIB and displacement; 0 if the SIB byte is missing
+		NODISCARD FORCE_INLINE std::size_t modrm_length ( const std::uint8_t* code, std::size_t offset, std::size_t limit ) noexcept {
+			const auto modrm = code [ offset ];
+			const std::size_t entry = tables.modrm [ modrm ];
+			if ( !( entry & sibFollows ) ) {
+				return entry;
+			}
+
+			if ( offset + 1 >= limit ) {
+				return 0;
+			}
+			// mod 0 with SIB base 5 adds a disp32
+			const auto disp32 = modrm < 0x40 && ( code [ offset + 1 ] & 7 ) == 5;
+			return ( entry & ~std::size_t { sibFollows } ) + 1 + ( disp32 ? 4 : 0 );
+		}
+
+		/// <summary>
+		///  Whether a lock prefix is valid on a Lockable opcode (`key` as in instruction_length) with
+		///  this ModRM byte: only the memory forms, and only the group members that write memory
+		/// </summary>
+		NODISCARD FORCE_INLINE bool lock_allowed ( unsigned key, std::uint8_t modrm ) noexcept {
+			if ( modrm >= 0xC0 ) {
+				return false;
+			}
+
+			const auto reg = ( modrm >> 3 ) & 7;
+			switch ( key ) {
+				case 0x80:
+				case 0x81:
+				case 0x83: // all but cmp
+					return reg != 7;
+				case 0xF6:
+				case 0xF7: // not, neg
+					return reg == 2 || reg == 3;
+				case 0xFE:
+				case 0xFF: // inc, dec
+					return reg < 2;
+				case 0x0FBA: // bts, btr, btc
+					return reg >= 5;
+				case 0x0FC7: // cmpxchg8b/16b
+					return reg == 1;
+				default:
+					return true;
+			}
+		}
+
+		/// Immediates of VEX and EVEX instructions in opcode map 1 (0F)
+		NODISCARD FORCE_INLINE bool map1_imm8 ( std::uint8_t opcode ) noexcept {
+			return ( opcode >= 0x70 && opcode <= 0x73 ) || opcode == 0xC2 || ( opcode >= 0xC4 && opcode <= 0xC6 );
+		}
+
+		/// <summary>
+		///  Length of a VEX (C4, C5), EVEX (62) or XOP (8F) instruction whose escape byte is at `offset`
+		/// </summary>
+		/// <returns>Total length, 0 if invalid or cut off</returns>
+		NODISCARD inline std::size_t vector_length ( const std::uint8_t* code, std::size_t offset, std::size_t limit ) noexcept {
+			const auto escape = code [ offset ];
+			const std::size_t payload = escape == 0xC5 ? 1 : escape == 0x62 ? 3 : 2;
+			if ( offset + payload + 1 >= limit ) {
+				return 0;
+			}
+
+			const auto p0 = code [ offset + 1 ];
+			unsigned map = 1;
+			if ( escape == 0xC4 ) {
+				map = p0 & 0x1F;
+				if ( map < 1 || map > 3 ) {
+					return 0;
+				}
+			}
+			else if ( escape == 0x62 ) {
+				map = p0 & 0x07;
+				if ( ( p0 & 0x08 ) || !( code [ offset + 2 ] & 0x04 ) || map == 0 || map == 4 || map == 7 ) {
+					return 0;
+				}
+			}
+			else if ( escape == 0x8F ) {
+				map = p0 & 0x1F;
+				if ( map < 8 || map > 10 ) {
+					return 0;
+				}
+			}
+
+			offset += payload + 1;
+			const auto opcode = code [ offset++ ];
+			if ( escape != 0x62 && map == 1 && opcode == 0x77 ) {
+				return offset; // vzeroupper / vzeroall
+			}
+
+			const auto modrm = offset < limit ? modrm_length ( code, offset, limit ) : 0;
+			if ( !modrm ) {
+				return 0;
+			}
+			offset += modrm;
+
+			if ( map == 3 || map == 8 || ( map == 1 && map1_imm8 ( opcode ) ) ) {
+				offset += 1;
+			}
+			else if ( map == 10 ) {
+				offset += 4;
+			}
+			return offset <= limit ? offset : 0;
+		}
+	};
+
+	/// <summary>
+	///  Length of the 64-bit mode instruction at `code`, reading at most `size` bytes
+	/// </summary>
+	/// <returns>Length in bytes, 0 if the bytes are not a valid instruction or are cut off</returns>
+	NODISCARD FORCE_INLINE std::size_t instruction_length ( const std::uint8_t* code, std::size_t size ) noexcept {
+		const auto limit = std::min ( size, length::maxLength );
+		if ( !limit ) {
+			return 0;
+		}
+
+		std::size_t offset = 0;
+		std::uint8_t opcode = code [ 0 ];
+		std::uint8_t prefixes = 0;
+		std::uint8_t repeat = 0;
+		std::uint8_t rex = 0;
+		for ( auto kind = length::tables.prefix [ opcode ]; kind; kind = length::tables.prefix [ opcode ] ) {
+			// REX only counts right before the opcode; of F2 and F3 the last one wins
+			rex = kind == length::Rex ? opcode : 0;
+			repeat = kind == length::Repeat ? opcode : repeat;
+			prefixes |= kind;
+			if ( ++offset >= limit ) {
+				return 0;
+			}
+			opcode = code [ offset ];
+		}
+
+		const bool rexW = rex & 0x08;
+		const bool operandSize = prefixes & length::OperandSize;
+		const auto immediates = length::tables.immediate [ ( rexW ? 2 : operandSize ? 1 : 0 ) + ( prefixes & length::AddressSize ? 3 : 0 ) ];
+
+		auto flags = length::tables.oneByte [ opcode ];
+		unsigned key = opcode;
+		++offset;
+		if ( flags & length::Escape ) {
+			if ( opcode == 0x0F ) {
+				if ( offset >= limit ) {
+					return 0;
+				}
+
+				const auto second = code [ offset++ ];
+				if ( second == 0x38 || second == 0x3A ) {
+					if ( offset >= limit ) {
+						return 0;
+					}
+					const auto third = code [ offset++ ];
+					flags = second == 0x38 ? length::tables.map0F38 [ third ] : length::tables.map0F3A [ third ];
+				}
+				else {
+					flags = length::tables.map0F [ second ];
+					key = 0x0F00 | second;
+				}
+			}
+			else if ( opcode != 0x8F || ( offset < limit && ( code [ offset ] & 0x1F ) >= 8 ) ) {
+				// VEX, EVEX and XOP allow no 66, F2, F3, lock or REX prefix
+				if ( prefixes & ( length::OperandSize | length::Lock | length::Repeat ) || rex ) {
+					return 0;
+				}
+				return length::vector_length ( code, offset - 1, limit );
+			}
+			else {
+				flags = length::ModRm | length::Special; // pop r/m
+			}
+		}
+
+		if ( flags & length::Invalid ) {
+			return 0;
+		}
+		if ( ( prefixes & length::Lock ) && !( flags & length::Lockable ) ) {
+			return 0;
+		}
+
+		// ImmMask holds the kind shifted left by one, the table 4 bits per kind
+		std::size_t immediate = ( immediates >> ( ( flags & length::ImmMask ) * 2 ) ) & 0xF;
+		if ( flags & length::ModRm ) {
+			if ( offset >= limit ) {
+				return 0;
+			}
+
+			const auto modrm = code [ offset ];
+			if ( ( prefixes & length::Lock ) && !length::lock_allowed ( key, modrm ) ) {
+				return 0;
+			}
+			if ( flags & length::Special ) {
+				const auto mod = modrm >> 6;
+				const auto reg = ( modrm >> 3 ) & 7;
+				switch ( key ) {
+					case 0x8C: // mov r/m, Sreg: es ... gs
+						if ( reg > 5 ) {
+							return 0;
+						}
+						break;
+					case 0x8E: // mov Sreg, r/m: cs cannot be loaded
+						if ( reg == 1 || reg > 5 ) {
+							return 0;
+						}
+						break;
+					case 0x8D: // lea
+						if ( mod == 3 ) {
+							return 0;
+						}
+						break;
+					case 0x8F: // pop r/m
+						if ( reg ) {
+							return 0;
+						}
+						break;
+					case 0xC6: // mov r/m, imm; xabort
+					case 0xC7: // mov r/m, imm; xbegin
+						if ( reg && modrm != 0xF8 ) {
+							return 0;
+						}
+						break;
+					case 0xF6: // test r/m, imm for /0 and /1
+						immediate = reg < 2 ? 1 : 0;
+						break;
+					case 0xF7:
+						immediate = reg < 2 ? ( immediates >> ( length::ImmZ * 2 ) ) & 0xF : 0;
+						break;
+					case 0xFE:
+						if ( reg >= 2 ) {
+							return 0;
+						}
+						break;
+					case 0xFF:
+						if ( reg == 7 || ( mod == 3 && ( reg == 3 || reg == 5 ) ) ) {
+							return 0;
+						}
+						break;
+					case 0x0F20:
+					case 0x0F21:
+					case 0x0F22:
+					case 0x0F23: // mov to and from control and debug registers ignores mod
+						return offset + 1 <= limit ? offset + 1 : 0;
+					case 0x0F78: // vmread; extrq and insertq take two imm8 with 66 or F2
+						if ( repeat == 0xF3 ) {
+							return 0;
+						}
+						immediate = repeat == 0xF2 || operandSize ? 2 : 0;
+						break;
+					case 0x0FB8: // popcnt, only with F3
+						if ( repeat != 0xF3 ) {
+							return 0;
+						}
+						break;
+					case 0x0FBA: // bt group
+						if ( reg < 4 ) {
+							return 0;
+						}
+						break;
+					default:
+						break;
+				}
+			}
+
+			const auto modrmBytes = length::modrm_length ( code, offset, limit );
+			if ( !modrmBytes ) {
+				return 0;
+			}
+			offset += modrmBytes;
+		}
+
+		offset += immediate;
+		return offset <= limit ? offset : 0;
+	}
+
+	/// <summary>
+	///  Bytes of alignment padding at `code`: int3, nop, and the multi-byte nops compilers emit
+	///  (66 90, 0F 1F /0, with any number of 66, 2E and 3E prefixes)
+	/// </summary>
+	NODISCARD inline std::size_t padding_length ( const std::uint8_t* code, std::size_t size ) noexcept {
+		std::size_t offset = 0;
+		while ( offset < size ) {
+			if ( code [ offset ] == 0xCC || code [ offset ] == 0x90 ) {
+				++offset;
+				continue;
+			}
+
+			const auto length = instruction_length ( code + offset, size - offset );
+			if ( !length ) {
+				break;
+			}
+
+			std::size_t body = offset;
+			while ( code [ body ] == 0x66 || code [ body ] == 0x2E || code [ body ] == 0x3E ) {
+				++body;
+			}
+
+			const bool nop = code [ body ] == 0x90 ||
+				( code [ body ] == 0x0F && code [ body + 1 ] == 0x1F && ( ( code [ body + 2 ] >> 3 ) & 7 ) == 0 );
+			if ( !nop ) {
+				break;
+			}
+			offset += length;
+		}
+		return offset;
+	}
+};
+#endif
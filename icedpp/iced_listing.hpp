@@ -0,0 +1,247 @@
+#pragma once
+#ifndef __ICED_LISTING_DEF
+#define __ICED_LISTING_DEF
+
+#include "iced.hpp"
+#include "iced_cache.hpp"
+
+namespace iced
+{
+	/// Bytes [address, address + size) were modified in the listed buffer
+	struct PatchRange {
+		std::uint64_t address;
+		std::size_t size;
+	};
+
+	/// <summary>
+	///  Linear sweep of a caller-owned, mutable code buffer. Instructions are kept in
+	///  chunks of a few thousand entries, so after a byte patch only the affected
+	///  instructions are re-decoded (until the sweep lines up with the old boundaries
+	///  again) and spliced into one or two chunks instead of redoing the whole sweep.
+	/// </summary>
+	class IncrementalListing {
+	public:
+		struct Entry {
+			__iced_internal::IcedInstructionRecord record;
+			std::uint32_t offset;
+		};
+
+		IncrementalListing ( ) = delete;
+		IncrementalListing ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress )
+			: data_ ( buffer ), baseAddr_ ( baseAddress ), size_ ( size ), count_ ( 0 ) {
+			assert ( size <= 0xFFFFFFFFULL && "Listing is limited to 4GB" );
+			rebuild ( );
+		}
+
+		/// Full sweep, discarding all previous entries
+		void rebuild ( ) {
+			chunks_.clear ( );
+			count_ = 0;
+
+			std::vector<Entry> entries;
+			decode_until ( 0, size_, entries, nullptr );
+			append_chunks ( entries, chunks_.end ( ) );
+		}
+
+		/// <summary>
+		///  Call after bytes of the underlying buffer changed
+		/// </summary>
+		void patch ( std::uint64_t address, std::size_t size ) {
+			if ( address < baseAddr_ || address - baseAddr_ >= size_ || !size ) {
+				return;
+			}
+
+			const auto low = static_cast< std::size_t >( address - baseAddr_ );
+			const auto high = std::min ( size_, low + size );
+			if ( chunks_.empty ( ) ) {
+				rebuild ( );
+				return;
+			}
+
+			// Last instruction starting at or before the first modified byte
+			auto first = locate ( low );
+			const auto start = chunks_ [ first.chunk ] [ first.index ].offset;
+
+			// Old boundaries ahead of the re-decode, used to detect resynchronization
+			auto last = first;
+			std::vector<Entry> entries;
+			decode_until ( start, high, entries, &last );
+
+			splice ( first, last, entries );
+		}
+
+		/// Applies several patches; ranges may overlap and come in any order
+		void patch ( std::vector<PatchRange> ranges ) {
+			std::sort ( ranges.begin ( ), ranges.end ( ), [ ] ( const PatchRange& lhs, const PatchRange& rhs ) {
+				return lhs.address < rhs.address;
+			} );
+
+			for ( const auto& range : ranges ) {
+				patch ( range.address, range.size );
+			}
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return count_; }
+		NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return count_ == 0; }
+		NODISCARD FORCE_INLINE std::uint64_t base_address ( ) const noexcept { return baseAddr_; }
+
+		NODISCARD FORCE_INLINE CachedInstruction instruction ( const Entry& entry ) const noexcept {
+			return CachedInstruction ( entry.record, baseAddr_ + entry.offset );
+		}
+
+		/// <returns>The instruction starting exactly at `ip`, or nullptr</returns>
+		NODISCARD const Entry* find ( std::uint64_t ip ) const noexcept {
+			if ( chunks_.empty ( ) || ip < baseAddr_ || ip - baseAddr_ >= size_ ) {
+				return nullptr;
+			}
+
+			const auto position = locate ( static_cast< std::size_t >( ip - baseAddr_ ) );
+			const auto& entry = chunks_ [ position.chunk ] [ position.index ];
+			return baseAddr_ + entry.offset == ip ? &entry : nullptr;
+		}
+
+		/// Visits every instruction in address order
+		template<typename Callback>
+		void for_each ( Callback&& callback ) const {
+			for ( const auto& chunk : chunks_ ) {
+				for ( const auto& entry : chunk ) {
+					callback ( instruction ( entry ) );
+				}
+			}
+		}
+
+	private:
+		using Chunk = std::vector<Entry>;
+		static constexpr std::size_t chunkSize = 4096;
+
+		struct Position {
+			std::size_t chunk;
+			std::size_t index;
+		};
+
+		NODISCARD Position locate ( std::size_t offset ) const noexcept {
+			const auto chunk = std::upper_bound ( chunks_.begin ( ), chunks_.end ( ), offset, [ ] ( std::size_t value, const Chunk& rhs ) {
+				return value < rhs.front ( ).offset;
+			} );
+			const auto chunkIndex = chunk == chunks_.begin ( ) ? 0 : static_cast< std::size_t >( chunk - chunks_.begin ( ) ) - 1;
+
+			const auto& entries = chunks_ [ chunkIndex ];
+			const auto entry = std::upper_bound ( entries.begin ( ), entries.end ( ), offset, [ ] ( std::size_t value, const Entry& rhs ) {
+				return value < rhs.offset;
+			} );
+			return { chunkIndex, entry == entries.begin ( ) ? 0 : static_cast< std::size_t >( entry - entries.begin ( ) ) - 1 };
+		}
+
+		/// <summary>
+		///  Decodes from `offset` until at least `high`. With `old` set, continues until the
+		///  new sweep lands on an old boundary and leaves `old` at that boundary (or the end).
+		/// </summary>
+		void decode_until ( std::size_t offset, std::size_t high, std::vector<Entry>& entries, Position* old ) const {
+			while ( offset < size_ ) {
+				if ( old && offset >= high ) {
+					while ( old->chunk < chunks_.size ( ) && chunks_ [ old->chunk ] [ old->index ].offset < offset ) {
+						if ( ++old->index == chunks_ [ old->chunk ].size ( ) ) {
+							++old->chunk;
+							old->index = 0;
+						}
+					}
+
+					// Past the last old boundary there is nothing to line up with; decode to the end
+					if ( old->chunk < chunks_.size ( ) && chunks_ [ old->chunk ] [ old->index ].offset == offset ) {
+						return;
+					}
+				}
+				else if ( !old && offset >= high ) {
+					return;
+				}
+
+				Entry entry {};
+				entry.offset = static_cast< std::uint32_t >( offset );
+				disas ( &entry.record, data_ + offset, std::min ( DecoderBase::maxInstructionLength, size_ - offset ) );
+				if ( !entry.record.length ) {
+					break;
+				}
+
+				offset += entry.record.length;
+				entries.push_back ( entry );
+			}
+
+			if ( old ) {
+				old->chunk = chunks_.size ( );
+				old->index = 0;
+			}
+		}
+
+		/// Replaces entries [first, last) with `entries`
+		void splice ( Position first, Position last, const std::vector<Entry>& entries ) {
+			auto& head = chunks_ [ first.chunk ];
+
+			// Common case: the patch stays inside one chunk
+			if ( last.chunk == first.chunk ) {
+				count_ += entries.size ( );
+				count_ -= last.index - first.index;
+				if ( last.index - first.index == entries.size ( ) ) {
+					std::copy ( entries.begin ( ), entries.end ( ), head.begin ( ) + first.index );
+					return;
+				}
+
+				head.erase ( head.begin ( ) + first.index, head.begin ( ) + last.index );
+				head.insert ( head.begin ( ) + first.index, entries.begin ( ), entries.end ( ) );
+				normalize ( first.chunk );
+				return;
+			}
+
+			for ( auto chunk = first.chunk; chunk < last.chunk; ++chunk ) {
+				count_ -= chunks_ [ chunk ].size ( );
+			}
+			count_ += first.index + entries.size ( );
+
+			head.resize ( first.index );
+			head.insert ( head.end ( ), entries.begin ( ), entries.end ( ) );
+			if ( last.chunk < chunks_.size ( ) ) {
+				auto& tail = chunks_ [ last.chunk ];
+				count_ -= last.index;
+				head.insert ( head.end ( ), tail.begin ( ) + last.index, tail.end ( ) );
+				chunks_.erase ( chunks_.begin ( ) + first.chunk + 1, chunks_.begin ( ) + last.chunk + 1 );
+			}
+			else {
+				chunks_.erase ( chunks_.begin ( ) + first.chunk + 1, chunks_.end ( ) );
+			}
+
+			normalize ( first.chunk );
+		}
+
+		/// Splits an oversized chunk and drops an empty one
+		void normalize ( std::size_t index ) {
+			if ( chunks_ [ index ].empty ( ) ) {
+				chunks_.erase ( chunks_.begin ( ) + index );
+				return;
+			}
+
+			if ( chunks_ [ index ].size ( ) > 2 * chunkSize ) {
+				auto entries = std::move ( chunks_ [ index ] );
+				chunks_.erase ( chunks_.begin ( ) + index );
+				count_ -= entries.size ( );
+				append_chunks ( entries, chunks_.begin ( ) + index );
+			}
+		}
+
+		void append_chunks ( const std::vector<Entry>& entries, std::vector<Chunk>::iterator where ) {
+			std::vector<Chunk> added;
+			for ( std::size_t begin = 0; begin < entries.size ( ); begin += chunkSize ) {
+				const auto end = std::min ( entries.size ( ), begin + chunkSize );
+				added.emplace_back ( entries.begin ( ) + begin, entries.begin ( ) + end );
+			}
+
+			count_ += entries.size ( );
+			chunks_.insert ( where, std::make_move_iterator ( added.begin ( ) ), std::make_move_iterator ( added.end ( ) ) );
+		}
+
+		const std::uint8_t* data_;
+		std::uint64_t baseAddr_;
+		std::size_t size_;
+		std::size_t count_;
+		std::vector<Chunk> chunks_;
+	};
+};
+#endif
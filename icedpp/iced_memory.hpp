@@ -0,0 +1,282 @@
+#pragma once
+#ifndef __ICED_MEMORY_DEF
+#define __ICED_MEMORY_DEF
+
+#include "iced.hpp"
+
+namespace iced
+{
+	/// Bytes mapped at [address, address + size); the memory is borrowed, not copied
+	struct MemorySegment {
+		std::uint64_t address;
+		std::uint64_t size;
+		const std::uint8_t* data;
+	};
+
+	/// <summary>
+	///  Reads up to `size` bytes at `address` into `buffer` for addresses no segment covers,
+	///  e.g. from a debugger or emulator. Called with page-aligned addresses.
+	/// </summary>
+	/// <returns>Number of bytes readable from `address` on, 0 if it is not mapped</returns>
+	using MemoryFetchCallback = std::size_t ( * )( void* context, std::uint64_t address, std::uint8_t* buffer, std::size_t size );
+
+	/// <summary>
+	///  Sparse address space: a sorted table of disjoint segments, plus an optional fetch callback
+	///  for everything else. It holds no decoding state and can be shared by any number of
+	///  MemoryDecoders, each of which keeps its own page cache for fetched memory.
+	/// </summary>
+	class MemoryImage {
+	public:
+		MemoryImage ( ) = default;
+
+		/// <returns>false if the segment is empty or overlaps one already added</returns>
+		bool add_segment ( std::uint64_t address, const std::uint8_t* data, std::size_t size ) {
+			if ( !data || !size || address + size < address ) {
+				return false;
+			}
+
+			const auto it = std::lower_bound ( segments_.begin ( ), segments_.end ( ), address, [ ] ( const MemorySegment& lhs, std::uint64_t value ) {
+				return lhs.address < value;
+			} );
+			if ( ( it != segments_.end ( ) && it->address < address + size ) ||
+				 ( it != segments_.begin ( ) && std::prev ( it )->address + std::prev ( it )->size > address ) ) {
+				return false;
+			}
+
+			segments_.insert ( it, { address, size, data } );
+			return true;
+		}
+
+		/// <summary>
+		///  Serves addresses outside the segments through `callback`, a page of `pageSize` bytes
+		///  (a power of two) at a time. Pass nullptr to disable. Decoders take the callback and
+		///  page size when they are constructed, so this only affects decoders created afterwards.
+		/// </summary>
+		/// <param name="context">passed back to every fetch call</param>
+		void set_fetch ( MemoryFetchCallback callback, void* context, std::size_t pageSize = 4096 ) noexcept {
+			assert ( pageSize >= DecoderBase::maxInstructionLength && !( pageSize & ( pageSize - 1 ) ) && "page size must be a power of two" );
+			fetch_ = callback;
+			fetchContext_ = context;
+			pageSize_ = pageSize;
+		}
+
+		void clear ( ) noexcept {
+			segments_.clear ( );
+			fetch_ = nullptr;
+			fetchContext_ = nullptr;
+		}
+
+		/// <returns>Index of the segment holding `address`, or npos</returns>
+		NODISCARD std::size_t find_segment ( std::uint64_t address ) const noexcept {
+			const auto it = std::upper_bound ( segments_.begin ( ), segments_.end ( ), address, [ ] ( std::uint64_t value, const MemorySegment& rhs ) {
+				return value < rhs.address;
+			} );
+			if ( it == segments_.begin ( ) ) {
+				return npos;
+			}
+
+			const auto& segment = *std::prev ( it );
+			return address - segment.address < segment.size ? static_cast< std::size_t >( it - segments_.begin ( ) - 1 ) : npos;
+		}
+
+		NODISCARD FORCE_INLINE const std::vector<MemorySegment>& segments ( ) const noexcept { return segments_; }
+		NODISCARD FORCE_INLINE const MemorySegment& segment ( std::size_t index ) const noexcept { return segments_ [ index ]; }
+		NODISCARD FORCE_INLINE MemoryFetchCallback fetch ( ) const noexcept { return fetch_; }
+		NODISCARD FORCE_INLINE void* fetch_context ( ) const noexcept { return fetchContext_; }
+		NODISCARD FORCE_INLINE std::size_t page_size ( ) const noexcept { return pageSize_; }
+
+		static constexpr std::size_t npos = ~std::size_t { 0 };
+
+	private:
+		std::vector<MemorySegment> segments_;
+		MemoryFetchCallback fetch_ = nullptr;
+		void* fetchContext_ = nullptr;
+		std::size_t pageSize_ = 4096;
+	};
+
+	/// <summary>
+	///  Decoder over a MemoryImage instead of one contiguous buffer. set_ip ( ) accepts any mapped
+	///  address. Instructions are decoded in place from segment memory; only one that crosses the
+	///  end of a segment or fetched page has its (at most 15) bytes gathered into a small window.
+	///  Fetched pages are kept in a direct-mapped cache of `cachePages` entries per decoder,
+	///  unmapped pages included, so the callback is only asked again after invalidate ( ). The
+	///  fetch callback and page size are the image's at construction; segments are looked up live.
+	///  Not thread-safe; use one decoder per thread over a shared image.
+	/// </summary>
+	template<bool Debug = false, typename Syntax = syntax::Fast>
+	class BasicMemoryDecoder {
+		struct Page {
+			std::uint64_t address;
+			std::size_t valid; // readable bytes from the page start, 0 if unmapped
+			bool loaded;
+		};
+
+	public:
+		explicit BasicMemoryDecoder ( const MemoryImage& image, std::size_t cachePages = 64 )
+			: image_ ( &image ), fetch_ ( image.fetch ( ) ), fetchContext_ ( image.fetch_context ( ) ), pageSize_ ( image.page_size ( ) ),
+			pages_ ( fetch_ ? std::max<std::size_t> ( cachePages, 1 ) : 0 ), pageData_ ( pages_.size ( ) * pageSize_ ) {
+			invalidate ( );
+			if ( !image.segments ( ).empty ( ) ) {
+				set_ip ( image.segments ( ).front ( ).address );
+			}
+		}
+
+		/// <returns>false (and the position unchanged) if nothing is mapped at `ip`</returns>
+		bool set_ip ( std::uint64_t ip ) noexcept {
+			const std::uint8_t* bytes;
+			if ( !contiguous ( ip, bytes ) ) {
+				return false;
+			}
+			ip_ = ip;
+			return true;
+		}
+
+		NODISCARD FORCE_INLINE std::uint64_t ip ( ) const noexcept { return ip_; }
+		NODISCARD FORCE_INLINE const Instruction& current_instruction ( ) const noexcept { return currentInstruction_; }
+		NODISCARD FORCE_INLINE std::uint64_t last_successful_ip ( ) const noexcept { return lastSuccessfulIp_; }
+		NODISCARD FORCE_INLINE std::uint16_t last_successful_length ( ) const noexcept { return lastSuccessfulLength_; }
+		NODISCARD FORCE_INLINE const MemoryImage& image ( ) const noexcept { return *image_; }
+
+		/// Whether the current position is mapped
+		NODISCARD bool can_decode ( ) noexcept {
+			const std::uint8_t* bytes;
+			return contiguous ( ip_, bytes ) != 0;
+		}
+
+		/// <summary>
+		///  Decodes at ip ( ) and advances past the instruction. An unmapped position yields an
+		///  invalid instruction of length 0; bytes cut off by a gap decode as invalid.
+		/// </summary>
+		NODISCARD Instruction& decode ( ) noexcept {
+			__iced_internal::IcedInstruction icedInstruction {};
+			const std::uint8_t* bytes;
+			const auto available = window ( ip_, bytes );
+			if ( available ) {
+				decode_function ( &icedInstruction, bytes, available );
+			}
+
+			currentInstruction_ = Instruction { icedInstruction, ip_ };
+			if ( icedInstruction.length ) {
+				lastSuccessfulIp_ = ip_;
+				lastSuccessfulLength_ = icedInstruction.length;
+				ip_ += icedInstruction.length;
+			}
+			return currentInstruction_;
+		}
+
+		NODISCARD Instruction peek ( ) noexcept {
+			__iced_internal::IcedInstruction icedInstruction {};
+			const std::uint8_t* bytes;
+			const auto available = window ( ip_, bytes );
+			if ( available ) {
+				decode_function ( &icedInstruction, bytes, available );
+			}
+			return Instruction ( icedInstruction, ip_ );
+		}
+
+		/// Forgets every cached page, e.g. after the emulated memory changed
+		void invalidate ( ) noexcept {
+			for ( auto& page : pages_ ) {
+				page.loaded = false;
+			}
+		}
+
+	private:
+		static constexpr auto decode_function = Debug ? Syntax::decode : disas;
+
+		/// <summary>
+		///  Up to 15 bytes at `ip`: a pointer straight into a segment or cached page when they are
+		///  contiguous there, otherwise gathered across the boundary into window_
+		/// </summary>
+		std::size_t window ( std::uint64_t ip, const std::uint8_t*& bytes ) noexcept {
+			constexpr auto maxLength = DecoderBase::maxInstructionLength;
+
+			const auto available = contiguous ( ip, bytes );
+			if ( available >= maxLength || !available ) {
+				return std::min ( available, maxLength );
+			}
+
+			// Copy the head before looking up the rest, which may evict the page it lives in
+			std::memcpy ( window_, bytes, available );
+			auto filled = available;
+			while ( filled < maxLength ) {
+				const std::uint8_t* next;
+				const auto more = std::min ( contiguous ( ip + filled, next ), maxLength - filled );
+				if ( !more ) {
+					break;
+				}
+				std::memcpy ( window_ + filled, next, more );
+				filled += more;
+			}
+
+			bytes = window_;
+			return filled;
+		}
+
+		/// Readable bytes from `address` up to the end of its segment or page, 0 if unmapped
+		std::size_t contiguous ( std::uint64_t address, const std::uint8_t*& bytes ) noexcept {
+			const auto& segments = image_->segments ( );
+
+			// Sequential decoding nearly always stays in the segment of the previous lookup
+			if ( segment_ >= segments.size ( ) || address - segments [ segment_ ].address >= segments [ segment_ ].size ) {
+				segment_ = image_->find_segment ( address );
+			}
+			if ( segment_ != MemoryImage::npos ) {
+				const auto& segment = segments [ segment_ ];
+				const auto offset = address - segment.address;
+				bytes = segment.data + offset;
+				return static_cast< std::size_t >( segment.size - offset );
+			}
+
+			if ( pages_.empty ( ) ) {
+				return 0;
+			}
+
+			const auto pageAddress = address & ~static_cast< std::uint64_t >( pageSize_ - 1 );
+			const auto slot = static_cast< std::size_t >( pageAddress / pageSize_ % pages_.size ( ) );
+			auto& page = pages_ [ slot ];
+			auto* data = pageData_.data ( ) + slot * pageSize_;
+			if ( !page.loaded || page.address != pageAddress ) {
+				page.address = pageAddress;
+				page.valid = std::min ( fetch_ ( fetchContext_, pageAddress, data, pageSize_ ), pageSize_ );
+				page.loaded = true;
+			}
+
+			const auto offset = static_cast< std::size_t >( address - pageAddress );
+			if ( page.valid <= offset ) {
+				return 0;
+			}
+
+			// Segments take precedence: the fetched bytes only run up to the next segment start
+			auto available = page.valid - offset;
+			const auto next = std::upper_bound ( segments.begin ( ), segments.end ( ), address, [ ] ( std::uint64_t value, const MemorySegment& rhs ) {
+				return value < rhs.address;
+			} );
+			if ( next != segments.end ( ) && next->address - address < available ) {
+				available = static_cast< std::size_t >( next->address - address );
+			}
+
+			bytes = data + offset;
+			return available;
+		}
+
+		const MemoryImage* image_;
+		MemoryFetchCallback fetch_;
+		void* fetchContext_;
+		std::size_t pageSize_;
+		std::uint64_t ip_ = 0;
+		std::size_t segment_ = MemoryImage::npos;
+		std::vector<Page> pages_;
+		std::vector<std::uint8_t> pageData_;
+		std::uint8_t window_ [ DecoderBase::maxInstructionLength ];
+
+		std::uint64_t lastSuccessfulIp_ = 0;
+		std::uint16_t lastSuccessfulLength_ = 0;
+		Instruction currentInstruction_ { };
+	};
+
+	using MemoryDecoder = BasicMemoryDecoder<>;
+	template<typename Syntax = syntax::Fast>
+	using DebugMemoryDecoder = BasicMemoryDecoder<true, Syntax>;
+};
+#endif
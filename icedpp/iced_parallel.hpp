@@ -0,0 +1,231 @@
+#pragma once
+#ifndef __ICED_PARALLEL_DEF
+#define __ICED_PARALLEL_DEF
+
+#include "iced.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace iced
+{
+	/// Resolves a requested thread count; 0 means one per hardware thread
+	NODISCARD inline std::size_t worker_count ( std::size_t requested = 0 ) noexcept {
+		if ( requested ) {
+			return requested;
+		}
+
+		const auto hardware = std::thread::hardware_concurrency ( );
+		return hardware ? hardware : 1;
+	}
+
+	/// <summary>
+	///  Runs callback ( index ) for every index in [0, count) on up to `threads` threads.
+	///  Indices are handed out one at a time, so uneven tasks balance themselves.
+	/// </summary>
+	template<typename Callback>
+	void parallel_for ( std::size_t count, std::size_t threads, Callback&& callback ) {
+		threads = std::min ( worker_count ( threads ), count );
+		if ( threads <= 1 ) {
+			for ( std::size_t index = 0; index < count; ++index ) {
+				callback ( index );
+			}
+			return;
+		}
+
+		std::atomic<std::size_t> next { 0 };
+		const auto work = [ & ] ( ) {
+			for ( auto index = next.fetch_add ( 1, std::memory_order_relaxed ); index < count;
+				  index = next.fetch_add ( 1, std::memory_order_relaxed ) ) {
+				callback ( index );
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve ( threads - 1 );
+		for ( std::size_t thread = 1; thread < threads; ++thread ) {
+			workers.emplace_back ( work );
+		}
+		work ( );
+
+		for ( auto& worker : workers ) {
+			worker.join ( );
+		}
+	}
+
+	/// <summary>
+	///  Sorts runs on separate threads, then merges them pairwise, each round in parallel
+	/// </summary>
+	template<typename T, typename Compare>
+	void parallel_sort ( std::vector<T>& values, Compare compare, std::size_t threads = 0 ) {
+		constexpr std::size_t minimumParallel = 1 << 16;
+
+		threads = worker_count ( threads );
+		if ( threads <= 1 || values.size ( ) < minimumParallel ) {
+			std::sort ( values.begin ( ), values.end ( ), compare );
+			return;
+		}
+
+		std::vector<std::size_t> bounds ( threads + 1 );
+		for ( std::size_t run = 0; run <= threads; ++run ) {
+			bounds [ run ] = values.size ( ) * run / threads;
+		}
+
+		parallel_for ( threads, threads, [ & ] ( std::size_t run ) {
+			std::sort ( values.begin ( ) + bounds [ run ], values.begin ( ) + bounds [ run + 1 ], compare );
+		} );
+
+		std::vector<T> buffer ( values.size ( ) );
+		for ( std::size_t width = 1; width < threads; width *= 2 ) {
+			const auto pairs = ( threads + 2 * width - 1 ) / ( 2 * width );
+			parallel_for ( pairs, threads, [ & ] ( std::size_t pair ) {
+				const auto first = bounds [ pair * 2 * width ];
+				const auto middle = bounds [ std::min ( threads, pair * 2 * width + width ) ];
+				const auto last = bounds [ std::min ( threads, pair * 2 * width + 2 * width ) ];
+				std::merge ( values.begin ( ) + first, values.begin ( ) + middle, values.begin ( ) + middle, values.begin ( ) + last,
+							 buffer.begin ( ) + first, compare );
+			} );
+			values.swap ( buffer );
+		}
+	}
+
+	/// <summary>
+	///  Renders pieces [0, count) into text on `threads` threads and passes them to emit ( text )
+	///  in index order on the calling thread. Pieces go in windows of a few per thread whose
+	///  strings are reused, so memory stays bounded however large `count` is.
+	/// </summary>
+	template<typename Render, typename Emit>
+	void parallel_ordered ( std::size_t count, std::size_t threads, Render&& render, Emit&& emit ) {
+		constexpr std::size_t piecesPerThread = 8;
+
+		threads = worker_count ( threads );
+		std::vector<std::string> texts ( std::min ( count, threads * piecesPerThread ) );
+		for ( std::size_t window = 0; window < count; window += texts.size ( ) ) {
+			const auto pieces = std::min ( texts.size ( ), count - window );
+			parallel_for ( pieces, threads, [ & ] ( std::size_t index ) {
+				texts [ index ].clear ( );
+				render ( window + index, texts [ index ] );
+			} );
+
+			for ( std::size_t index = 0; index < pieces; ++index ) {
+				emit ( std::string_view ( texts [ index ] ) );
+			}
+		}
+	}
+
+	/// <summary>
+	///  DecoderBase::gather split into blocks decoded on `threads` threads (0 = all hardware
+	///  threads). Worth it from a few thousand addresses on; smaller requests stay on this thread.
+	/// </summary>
+	template<typename Output>
+	std::size_t parallel_gather ( const DecoderBase& decoder, const std::uint64_t* ips, std::size_t count, Output* out, std::size_t threads = 0 ) {
+		constexpr std::size_t blockSize = 4096;
+
+		std::atomic<std::size_t> decoded { 0 };
+		parallel_for ( ( count + blockSize - 1 ) / blockSize, threads, [ & ] ( std::size_t block ) {
+			const auto first = block * blockSize;
+			decoded.fetch_add ( decoder.gather ( ips + first, std::min ( blockSize, count - first ), out + first ), std::memory_order_relaxed );
+		} );
+		return decoded.load ( );
+	}
+
+	/// <summary>
+	///  Linear sweep split across sinks.size ( ) threads, one contiguous chunk each, with the
+	///  same result as a single sequential sweep. A Sink provides
+	///    void operator()( const Instruction& )      - called in address order within its chunk
+	///    void discard_before ( std::uint64_t ip )     - drop instructions below ip
+	///  Chunks that started mid-instruction are repaired afterwards: the previous sink is fed
+	///  the correct instructions until the sweep lines up with the chunk's own boundaries again,
+	///  and the misaligned prefix is discarded. Concatenating the sinks in order gives the sweep.
+	/// </summary>
+	template<typename Sink>
+	void parallel_sweep ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, std::vector<Sink>& sinks ) {
+		constexpr std::size_t recordedStarts = 1024;
+
+		struct Chunk {
+			std::size_t begin;
+			std::size_t end;
+			std::size_t exit;
+			std::vector<std::size_t> starts;
+			bool complete;
+		};
+
+		const auto count = sinks.size ( );
+		if ( !count || !size ) {
+			return;
+		}
+
+		std::vector<Chunk> chunks ( count );
+		for ( std::size_t chunk = 0; chunk < count; ++chunk ) {
+			chunks [ chunk ].begin = size * chunk / count;
+			chunks [ chunk ].end = size * ( chunk + 1 ) / count;
+		}
+
+		parallel_for ( count, count, [ & ] ( std::size_t index ) {
+			auto& chunk = chunks [ index ];
+			chunk.starts.reserve ( recordedStarts );
+
+			ReleaseDecoder decoder ( code, size, baseAddress );
+			chunk.exit = chunk.begin;
+			if ( chunk.begin < chunk.end ) {
+				decoder.set_ip ( baseAddress + chunk.begin );
+			}
+
+			while ( chunk.exit < chunk.end ) {
+				if ( chunk.starts.size ( ) < recordedStarts ) {
+					chunk.starts.push_back ( chunk.exit );
+				}
+
+				const auto& instruction = decoder.decode ( );
+				if ( !instruction.length ( ) ) {
+					break;
+				}
+
+				sinks [ index ] ( instruction );
+				chunk.exit += instruction.length ( );
+			}
+			chunk.complete = chunk.starts.size ( ) < recordedStarts;
+		} );
+
+		// Stitch the chunks together in address order
+		ReleaseDecoder decoder ( code, size, baseAddress );
+		auto entry = chunks [ 0 ].exit;
+		for ( std::size_t index = 1; index < count; ++index ) {
+			const auto& chunk = chunks [ index ];
+			if ( entry == chunk.begin ) {
+				entry = chunk.exit;
+				continue;
+			}
+
+			// Past the recorded starts of a long chunk alignment can no longer be seen; redo the rest
+			bool aligned = false;
+			while ( entry < chunk.end ) {
+				if ( ( chunk.complete || entry <= chunk.starts.back ( ) ) &&
+					 std::binary_search ( chunk.starts.begin ( ), chunk.starts.end ( ), entry ) ) {
+					aligned = true;
+					break;
+				}
+
+				decoder.set_ip ( baseAddress + entry );
+				const auto& instruction = decoder.decode ( );
+				if ( !instruction.length ( ) ) {
+					entry = size;
+					break;
+				}
+
+				sinks [ index - 1 ] ( instruction );
+				entry += instruction.length ( );
+			}
+
+			if ( aligned ) {
+				sinks [ index ].discard_before ( baseAddress + entry );
+				entry = chunk.exit;
+			}
+			else {
+				sinks [ index ].discard_before ( baseAddress + chunk.end );
+			}
+		}
+	}
+};
+#endif
@@ -0,0 +1,192 @@
+#pragma once
+#ifndef __ICED_POOL_DEF
+#define __ICED_POOL_DEF
+
+#include "iced.hpp"
+#include "iced_parallel.hpp"
+
+#include <atomic>
+#include <functional>
+
+namespace iced
+{
+	/// <summary>
+	///  Creates the backend's per-thread state (text buffer, formatters) on first use
+	///  from the calling thread; later calls are a thread-local check
+	/// </summary>
+	inline void warm_up_current_thread ( ) noexcept {
+		thread_local bool warm = false;
+		if ( !warm ) {
+			::warm_up_thread ( );
+			warm = true;
+		}
+	}
+
+	struct DecoderPoolStats {
+		std::size_t capacity;
+		std::size_t inUse;
+		std::size_t peakInUse;
+		std::uint64_t acquires;
+		std::uint64_t overflows; // acquires served by a temporary decoder because every slot was busy
+	};
+
+	/// <summary>
+	///  Fixed set of ready decoders bound to one shared, read-only code buffer.
+	///  acquire ( ) claims a free slot with one atomic exchange (starting from a per-thread
+	///  slot so threads rarely collide) and the returned Lease gives it back on destruction.
+	///  No locks; when every slot is busy a temporary decoder is handed out instead.
+	/// </summary>
+	template<typename DecoderType = ReleaseDecoder>
+	class DecoderPool {
+		struct alignas( 64 ) Slot {
+			std::atomic<bool> busy { false };
+			DecoderType decoder;
+		};
+
+	public:
+		class Lease {
+		public:
+			Lease ( const Lease& ) = delete;
+			Lease& operator=( const Lease& ) = delete;
+
+			Lease ( Lease&& other ) noexcept
+				: pool_ ( other.pool_ ), slot_ ( other.slot_ ), overflow_ ( std::move ( other.overflow_ ) ), decoder_ ( other.decoder_ ) {
+				other.pool_ = nullptr;
+				other.slot_ = nullptr;
+				other.decoder_ = nullptr;
+			}
+
+			Lease& operator=( Lease&& other ) noexcept {
+				if ( this != &other ) {
+					release ( );
+					pool_ = other.pool_;
+					slot_ = other.slot_;
+					overflow_ = std::move ( other.overflow_ );
+					decoder_ = other.decoder_;
+					other.pool_ = nullptr;
+					other.slot_ = nullptr;
+					other.decoder_ = nullptr;
+				}
+				return *this;
+			}
+
+			~Lease ( ) { release ( ); }
+
+			NODISCARD FORCE_INLINE DecoderType& operator*( ) const noexcept { return *decoder_; }
+			NODISCARD FORCE_INLINE DecoderType* operator->( ) const noexcept { return decoder_; }
+			NODISCARD FORCE_INLINE DecoderType& get ( ) const noexcept { return *decoder_; }
+			NODISCARD FORCE_INLINE bool pooled ( ) const noexcept { return slot_ != nullptr; }
+
+			/// Returns the decoder early; the lease is empty afterwards
+			void release ( ) noexcept {
+				if ( pool_ ) {
+					pool_->release ( slot_ );
+				}
+				pool_ = nullptr;
+				slot_ = nullptr;
+				overflow_.reset ( );
+				decoder_ = nullptr;
+			}
+
+		private:
+			friend class DecoderPool;
+			Lease ( DecoderPool* pool, Slot* slot, std::unique_ptr<DecoderType> overflow ) noexcept
+				: pool_ ( pool ), slot_ ( slot ), overflow_ ( std::move ( overflow ) ),
+				decoder_ ( slot ? &slot->decoder : overflow_.get ( ) ) { }
+
+			DecoderPool* pool_;
+			Slot* slot_;
+			std::unique_ptr<DecoderType> overflow_;
+			DecoderType* decoder_;
+		};
+
+		/// <summary>
+		///  `capacity` decoders over [buffer, buffer + size), 0 = one per hardware thread
+		/// </summary>
+		DecoderPool ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress, std::size_t capacity = 0 )
+			: data_ ( buffer ), size_ ( size ), baseAddr_ ( baseAddress ), capacity_ ( worker_count ( capacity ) ),
+			slots_ ( new Slot [ capacity_ ] ) {
+			for ( std::size_t index = 0; index < capacity_; ++index ) {
+				slots_ [ index ].decoder.reconfigure ( buffer, size, baseAddress );
+			}
+		}
+
+		DecoderPool ( const DecoderPool& ) = delete;
+		DecoderPool& operator=( const DecoderPool& ) = delete;
+
+		~DecoderPool ( ) {
+			assert ( inUse_.load ( ) == 0 && "DecoderPool destroyed while decoders are leased" );
+		}
+
+		/// <summary>
+		///  Claims a decoder positioned at the start of the buffer
+		/// </summary>
+		NODISCARD Lease acquire ( ) {
+			warm_up_current_thread ( );
+			acquires_.fetch_add ( 1, std::memory_order_relaxed );
+
+			const auto start = home_slot ( );
+			for ( std::size_t probe = 0; probe < capacity_; ++probe ) {
+				auto& slot = slots_ [ ( start + probe ) % capacity_ ];
+				if ( !slot.busy.load ( std::memory_order_relaxed ) && !slot.busy.exchange ( true, std::memory_order_acquire ) ) {
+					track_in_use ( );
+					return Lease ( this, &slot, nullptr );
+				}
+			}
+
+			overflows_.fetch_add ( 1, std::memory_order_relaxed );
+			return Lease ( nullptr, nullptr, std::unique_ptr<DecoderType> ( new DecoderType ( data_, size_, baseAddr_ ) ) );
+		}
+
+		/// Claims a decoder positioned at `ip` (left at the start if `ip` is outside the buffer)
+		NODISCARD Lease acquire ( std::uint64_t ip ) {
+			auto lease = acquire ( );
+			lease->set_ip ( ip );
+			return lease;
+		}
+
+		NODISCARD DecoderPoolStats stats ( ) const noexcept {
+			return {
+				capacity_,
+				inUse_.load ( std::memory_order_relaxed ),
+				peakInUse_.load ( std::memory_order_relaxed ),
+				acquires_.load ( std::memory_order_relaxed ),
+				overflows_.load ( std::memory_order_relaxed ),
+			};
+		}
+
+		NODISCARD FORCE_INLINE std::size_t capacity ( ) const noexcept { return capacity_; }
+
+	private:
+		/// Spreads threads over the slots so they usually claim different cache lines
+		NODISCARD std::size_t home_slot ( ) const noexcept {
+			thread_local const std::uint64_t home = std::hash<std::thread::id> { }( std::this_thread::get_id ( ) ) * 0x9E3779B97F4A7C15ULL;
+			return static_cast< std::size_t >( home >> 32 ) % capacity_;
+		}
+
+		void track_in_use ( ) noexcept {
+			const auto current = inUse_.fetch_add ( 1, std::memory_order_relaxed ) + 1;
+			auto peak = peakInUse_.load ( std::memory_order_relaxed );
+			while ( current > peak && !peakInUse_.compare_exchange_weak ( peak, current, std::memory_order_relaxed ) ) {
+			}
+		}
+
+		void release ( Slot* slot ) noexcept {
+			slot->decoder.reset ( );
+			inUse_.fetch_sub ( 1, std::memory_order_relaxed );
+			slot->busy.store ( false, std::memory_order_release );
+		}
+
+		const std::uint8_t* data_;
+		std::size_t size_;
+		std::uint64_t baseAddr_;
+		std::size_t capacity_;
+		std::unique_ptr<Slot [ ]> slots_;
+
+		std::atomic<std::size_t> inUse_ { 0 };
+		std::atomic<std::size_t> peakInUse_ { 0 };
+		std::atomic<std::uint64_t> acquires_ { 0 };
+		std::atomic<std::uint64_t> overflows_ { 0 };
+	};
+};
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+#ifndef __ICED_SUPERSET_DEF
+#define __ICED_SUPERSET_DEF
+
+#include "iced.hpp"
+#include "iced_parallel.hpp"
+
+#include <atomic>
+
+namespace iced
+{
+	/// <summary>
+	///  Superset disassembly: one decode at every byte offset of a buffer, kept as two byte
+	///  arrays (length, 0 when invalid, and flow control class). Overlapping instructions and
+	///  junk bytes are all represented, which makes it the input for overlap detection,
+	///  gadget search and function recovery on code a linear sweep misreads.
+	/// </summary>
+	class Superset {
+	public:
+		Superset ( ) = default;
+		Superset ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress, std::size_t threads = 0 ) {
+			build ( buffer, size, baseAddress, threads );
+		}
+
+		/// <summary>
+		///  Decodes every offset of the buffer, split into fixed ranges across `threads` threads
+		/// </summary>
+		void build ( const std::uint8_t* buffer, std::size_t size, std::uint64_t baseAddress, std::size_t threads = 0 ) {
+			constexpr std::size_t rangeSize = 1 << 16;
+
+			baseAddr_ = baseAddress;
+			lengths_.assign ( size, 0 );
+			flows_.assign ( size, static_cast< std::uint8_t >( FlowControl::Next ) );
+			validCount_ = 0;
+			if ( !buffer || !size ) {
+				return;
+			}
+
+			std::atomic<std::size_t> valid { 0 };
+			parallel_for ( ( size + rangeSize - 1 ) / rangeSize, threads, [ & ] ( std::size_t range ) {
+				const auto first = range * rangeSize;
+				const auto count = std::min ( rangeSize, size - first );
+				const auto decoded = disas_superset ( lengths_.data ( ) + first, flows_.data ( ) + first, buffer, size, first, count );
+				if ( decoded > 0 ) {
+					valid.fetch_add ( static_cast< std::size_t >( decoded ), std::memory_order_relaxed );
+				}
+			} );
+			validCount_ = valid.load ( );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return lengths_.size ( ); }
+		NODISCARD FORCE_INLINE std::size_t valid_count ( ) const noexcept { return validCount_; }
+		NODISCARD FORCE_INLINE std::uint64_t base_address ( ) const noexcept { return baseAddr_; }
+		NODISCARD FORCE_INLINE const std::uint8_t* lengths ( ) const noexcept { return lengths_.data ( ); }
+		NODISCARD FORCE_INLINE const std::uint8_t* flows ( ) const noexcept { return flows_.data ( ); }
+
+		NODISCARD FORCE_INLINE bool contains ( std::uint64_t ip ) const noexcept { return ip >= baseAddr_ && ip - baseAddr_ < lengths_.size ( ); }
+
+		/// Length of the instruction at `ip`, 0 if it does not decode; `ip` must be inside the buffer
+		NODISCARD FORCE_INLINE std::uint8_t length ( std::uint64_t ip ) const noexcept { return lengths_ [ ip - baseAddr_ ]; }
+		NODISCARD FORCE_INLINE bool valid ( std::uint64_t ip ) const noexcept { return length ( ip ) != 0; }
+		NODISCARD FORCE_INLINE FlowControl flow_control ( std::uint64_t ip ) const noexcept {
+			return static_cast< FlowControl >( flows_ [ ip - baseAddr_ ] );
+		}
+
+		/// <summary>
+		///  Follows fall-through from `ip` while instructions stay valid and inside the buffer.
+		///  Stops after jumps, returns and exceptions, which have no fall-through successor.
+		/// </summary>
+		/// <returns>Number of instructions visited; callback ( ip ) returning false stops early</returns>
+		template<typename Callback>
+		std::size_t walk ( std::uint64_t ip, Callback&& callback ) const {
+			std::size_t visited = 0;
+			while ( contains ( ip ) && valid ( ip ) ) {
+				++visited;
+				if ( !callback ( ip ) ) {
+					break;
+				}
+
+				const auto flow = flow_control ( ip );
+				if ( flow == FlowControl::UnconditionalBranch || flow == FlowControl::IndirectBranch ||
+					 flow == FlowControl::Return || flow == FlowControl::Exception ) {
+					break;
+				}
+				ip += length ( ip );
+			}
+			return visited;
+		}
+
+	private:
+		std::uint64_t baseAddr_ = 0;
+		std::size_t validCount_ = 0;
+		std::vector<std::uint8_t> lengths_;
+		std::vector<std::uint8_t> flows_;
+	};
+};
+#endif
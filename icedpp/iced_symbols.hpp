@@ -0,0 +1,186 @@
+#pragma once
+#ifndef __ICED_SYMBOLS_DEF
+#define __ICED_SYMBOLS_DEF
+
+#include "iced.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace iced
+{
+	struct Symbol {
+		std::uint64_t address;
+		/// Bytes covered by the symbol; 0 extends it up to the next symbol
+		std::uint64_t size;
+		/// Rendered as-is, e.g. "kernel32!CreateFileW" or "g_config"
+		std::string name;
+	};
+
+	struct SymbolMatch {
+		std::uint64_t address;
+		std::string_view name;
+	};
+
+	/// <summary>
+	///  Sorted address-to-symbol table built once from a bulk load. Addresses are kept in
+	///  Eytzinger (BFS) order so the predecessor search is branchless and touches
+	///  one cache line per level, which keeps symbolized formatting close to plain formatting.
+	/// </summary>
+	class SymbolTable {
+	public:
+		SymbolTable ( ) = default;
+		explicit SymbolTable ( std::vector<Symbol> symbols ) { load ( std::move ( symbols ) ); }
+
+		/// <summary>
+		///  Replaces the table contents. Duplicate addresses keep the first symbol given.
+		/// </summary>
+		void load ( std::vector<Symbol> symbols ) {
+			std::stable_sort ( symbols.begin ( ), symbols.end ( ), [ ] ( const Symbol& lhs, const Symbol& rhs ) {
+				return lhs.address < rhs.address;
+			} );
+			symbols.erase ( std::unique ( symbols.begin ( ), symbols.end ( ), [ ] ( const Symbol& lhs, const Symbol& rhs ) {
+				return lhs.address == rhs.address;
+			} ), symbols.end ( ) );
+
+			const auto count = symbols.size ( );
+			addresses_.resize ( count );
+			ends_.resize ( count );
+			nameOffsets_.resize ( count + 1 );
+			names_.clear ( );
+
+			for ( auto i = 0u; i < count; ++i ) {
+				const auto& symbol = symbols [ i ];
+				const auto next = i + 1 < count ? symbols [ i + 1 ].address : ~0ULL;
+				addresses_ [ i ] = symbol.address;
+				ends_ [ i ] = symbol.size ? symbol.address + symbol.size : next;
+				nameOffsets_ [ i ] = names_.size ( );
+				names_ += symbol.name;
+			}
+			nameOffsets_ [ count ] = names_.size ( );
+
+			// Slot 0 is unused so children of k sit at 2k and 2k+1; order_[0] maps "past the end"
+			keys_.assign ( count + 1, 0 );
+			order_.assign ( count + 1, static_cast< std::uint32_t >( count ) );
+			std::size_t next = 0;
+			build ( 1, next );
+		}
+
+		void clear ( ) noexcept {
+			keys_.clear ( );
+			order_.clear ( );
+			addresses_.clear ( );
+			ends_.clear ( );
+			nameOffsets_.clear ( );
+			names_.clear ( );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return addresses_.size ( ); }
+		NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return addresses_.empty ( ); }
+
+		/// <summary>
+		///  Finds the symbol covering `address`, i.e. the closest one at or below it
+		/// </summary>
+		/// <returns>Index into the sorted table, or size() if no symbol covers the address</returns>
+		NODISCARD FORCE_INLINE std::size_t find ( std::uint64_t address ) const noexcept {
+			const auto count = addresses_.size ( );
+			if ( !count ) {
+				return count;
+			}
+
+			const auto* keys = keys_.data ( );
+
+			std::size_t k = 1;
+			while ( k <= count ) {
+				prefetch ( keys + std::min ( k * 8, count ) );
+				k = 2 * k + ( keys [ k ] <= address );
+			}
+			// Undo the trailing right turns; k is then the first key above `address`
+			k >>= trailing_ones ( k ) + 1;
+
+			const auto index = static_cast< std::size_t >( order_ [ k ] ) - 1;
+			if ( index >= count || address >= ends_ [ index ] ) {
+				return count;
+			}
+
+			return index;
+		}
+
+		NODISCARD FORCE_INLINE bool lookup ( std::uint64_t address, SymbolMatch& match ) const noexcept {
+			const auto index = find ( address );
+			if ( index == size ( ) ) {
+				return false;
+			}
+
+			match.address = addresses_ [ index ];
+			match.name = name ( index );
+			return true;
+		}
+
+		NODISCARD FORCE_INLINE std::uint64_t address ( std::size_t index ) const noexcept { return addresses_ [ index ]; }
+		NODISCARD FORCE_INLINE std::string_view name ( std::size_t index ) const noexcept {
+			return std::string_view ( names_.data ( ) + nameOffsets_ [ index ], nameOffsets_ [ index + 1 ] - nameOffsets_ [ index ] );
+		}
+
+		/// <summary>
+		///  Resolver callback for BatchFormatter::set_symbol_resolver with the table as context
+		/// </summary>
+		static bool resolve ( void* context, std::uint64_t address, __iced_internal::IcedSymbol* out ) {
+			const auto* table = static_cast< const SymbolTable* >( context );
+			const auto index = table->find ( address );
+			if ( index == table->size ( ) ) {
+				return false;
+			}
+
+			const auto text = table->name ( index );
+			out->address = table->addresses_ [ index ];
+			out->name = text.data ( );
+			out->name_length = text.size ( );
+			return true;
+		}
+
+	private:
+		void build ( std::size_t k, std::size_t& next ) {
+			if ( k >= keys_.size ( ) ) {
+				return;
+			}
+
+			build ( 2 * k, next );
+			keys_ [ k ] = addresses_ [ next ];
+			order_ [ k ] = static_cast< std::uint32_t >( next );
+			++next;
+			build ( 2 * k + 1, next );
+		}
+
+		static FORCE_INLINE std::size_t trailing_ones ( std::size_t value ) noexcept {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64 ( &index, ~static_cast< unsigned long long >( value ) );
+			return index;
+#else
+			return static_cast< std::size_t >( __builtin_ctzll ( ~static_cast< unsigned long long >( value ) ) );
+#endif
+		}
+
+		static FORCE_INLINE void prefetch ( const void* address ) noexcept {
+#if defined(_MSC_VER)
+			_mm_prefetch ( static_cast< const char* >( address ), _MM_HINT_T0 );
+#else
+			__builtin_prefetch ( address );
+#endif
+		}
+
+		std::vector<std::uint64_t> keys_;
+		std::vector<std::uint32_t> order_;
+		std::vector<std::uint64_t> addresses_;
+		std::vector<std::uint64_t> ends_;
+		std::vector<std::size_t> nameOffsets_;
+		std::string names_;
+	};
+};
+#endif
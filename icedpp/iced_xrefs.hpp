@@ -0,0 +1,209 @@
+#pragma once
+#ifndef __ICED_XREFS_DEF
+#define __ICED_XREFS_DEF
+
+#include "iced.hpp"
+#include "iced_parallel.hpp"
+
+namespace iced
+{
+	enum class XrefKind : std::uint8_t {
+		Call,
+		Jump,
+		ConditionalJump,
+		Data,
+	};
+
+	struct Xref {
+		std::uint64_t from;
+		std::uint64_t to;
+		XrefKind kind;
+	};
+
+	/// <summary>
+	///  Cross references of a code buffer: direct branches and calls (code -> code) and
+	///  RIP-relative memory operands (code -> data). Built with a parallel linear sweep,
+	///  stored as two sorted, compressed tables instead of a map of vectors.
+	///  Sources are kept as 32-bit offsets from the base address.
+	/// </summary>
+	class XrefIndex {
+	public:
+		/// Sources referencing one address
+		class References {
+		public:
+			NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return count_; }
+			NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return count_ == 0; }
+			NODISCARD FORCE_INLINE std::uint64_t address ( std::size_t index ) const noexcept { return base_ + sources_ [ index ]; }
+			NODISCARD FORCE_INLINE XrefKind kind ( std::size_t index ) const noexcept { return kinds_ [ index ]; }
+		private:
+			friend class XrefIndex;
+			References ( std::uint64_t base, const std::uint32_t* sources, const XrefKind* kinds, std::size_t count ) noexcept
+				: base_ ( base ), sources_ ( sources ), kinds_ ( kinds ), count_ ( count ) { }
+
+			std::uint64_t base_;
+			const std::uint32_t* sources_;
+			const XrefKind* kinds_;
+			std::size_t count_;
+		};
+
+		/// Targets referenced by one instruction
+		class Targets {
+		public:
+			NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return count_; }
+			NODISCARD FORCE_INLINE bool empty ( ) const noexcept { return count_ == 0; }
+			NODISCARD FORCE_INLINE std::uint64_t address ( std::size_t index ) const noexcept { return targets_ [ index ]; }
+			NODISCARD FORCE_INLINE XrefKind kind ( std::size_t index ) const noexcept { return kinds_ [ index ]; }
+		private:
+			friend class XrefIndex;
+			Targets ( const std::uint64_t* targets, const XrefKind* kinds, std::size_t count ) noexcept
+				: targets_ ( targets ), kinds_ ( kinds ), count_ ( count ) { }
+
+			const std::uint64_t* targets_;
+			const XrefKind* kinds_;
+			std::size_t count_;
+		};
+
+		XrefIndex ( ) = default;
+
+		/// <summary>
+		///  Sweeps `code` on `threads` threads (0 = all hardware threads) and indexes every reference
+		/// </summary>
+		void build ( const std::uint8_t* code, std::size_t size, std::uint64_t baseAddress, std::size_t threads = 0 ) {
+			assert ( size <= 0xFFFFFFFFULL && "Xref index is limited to 4GB" );
+			clear ( );
+			baseAddr_ = baseAddress;
+
+			std::vector<Collector> collectors ( worker_count ( threads ) );
+			parallel_sweep ( code, size, baseAddress, collectors );
+
+			// Concatenated in chunk order the sweep is already sorted by source
+			std::size_t total = 0;
+			for ( const auto& collector : collectors ) {
+				total += collector.xrefs.size ( );
+			}
+
+			std::vector<Xref> xrefs;
+			xrefs.reserve ( total );
+			for ( auto& collector : collectors ) {
+				xrefs.insert ( xrefs.end ( ), collector.xrefs.begin ( ), collector.xrefs.end ( ) );
+				collector.xrefs = { };
+			}
+
+			build_table ( xrefs, fromKeys_, fromOffsets_, [ & ] ( const Xref& xref ) {
+				fromKeys_.push_back ( static_cast< std::uint32_t >( xref.from - baseAddr_ ) );
+			}, [ & ] ( const Xref& xref ) {
+				targets_.push_back ( xref.to );
+				targetKinds_.push_back ( xref.kind );
+			}, [ ] ( const Xref& lhs, const Xref& rhs ) { return lhs.from == rhs.from; } );
+
+			parallel_sort ( xrefs, [ ] ( const Xref& lhs, const Xref& rhs ) {
+				return lhs.to < rhs.to || ( lhs.to == rhs.to && lhs.from < rhs.from );
+			}, threads );
+
+			build_table ( xrefs, toKeys_, toOffsets_, [ & ] ( const Xref& xref ) {
+				toKeys_.push_back ( xref.to );
+			}, [ & ] ( const Xref& xref ) {
+				sources_.push_back ( static_cast< std::uint32_t >( xref.from - baseAddr_ ) );
+				sourceKinds_.push_back ( xref.kind );
+			}, [ ] ( const Xref& lhs, const Xref& rhs ) { return lhs.to == rhs.to; } );
+		}
+
+		void clear ( ) noexcept {
+			toKeys_.clear ( );
+			toOffsets_.clear ( );
+			sources_.clear ( );
+			sourceKinds_.clear ( );
+			fromKeys_.clear ( );
+			fromOffsets_.clear ( );
+			targets_.clear ( );
+			targetKinds_.clear ( );
+		}
+
+		/// Who references `address`
+		NODISCARD References references_to ( std::uint64_t address ) const noexcept {
+			const auto it = std::lower_bound ( toKeys_.begin ( ), toKeys_.end ( ), address );
+			if ( it == toKeys_.end ( ) || *it != address ) {
+				return References ( baseAddr_, nullptr, nullptr, 0 );
+			}
+
+			const auto key = static_cast< std::size_t >( it - toKeys_.begin ( ) );
+			const auto first = toOffsets_ [ key ];
+			return References ( baseAddr_, sources_.data ( ) + first, sourceKinds_.data ( ) + first, toOffsets_ [ key + 1 ] - first );
+		}
+
+		/// What the instruction at `ip` references
+		NODISCARD Targets referenced_by ( std::uint64_t ip ) const noexcept {
+			if ( ip < baseAddr_ || ip - baseAddr_ > 0xFFFFFFFFULL ) {
+				return Targets ( nullptr, nullptr, 0 );
+			}
+
+			const auto offset = static_cast< std::uint32_t >( ip - baseAddr_ );
+			const auto it = std::lower_bound ( fromKeys_.begin ( ), fromKeys_.end ( ), offset );
+			if ( it == fromKeys_.end ( ) || *it != offset ) {
+				return Targets ( nullptr, nullptr, 0 );
+			}
+
+			const auto key = static_cast< std::size_t >( it - fromKeys_.begin ( ) );
+			const auto first = fromOffsets_ [ key ];
+			return Targets ( targets_.data ( ) + first, targetKinds_.data ( ) + first, fromOffsets_ [ key + 1 ] - first );
+		}
+
+		NODISCARD FORCE_INLINE std::size_t size ( ) const noexcept { return sources_.size ( ); }
+		NODISCARD FORCE_INLINE std::size_t target_count ( ) const noexcept { return toKeys_.size ( ); }
+		NODISCARD FORCE_INLINE std::size_t source_count ( ) const noexcept { return fromKeys_.size ( ); }
+
+	private:
+		struct Collector {
+			std::vector<Xref> xrefs;
+
+			void operator()( const Instruction& instruction ) {
+				if ( instruction.op_kind_simple ( 0 ) == OpKindSimple::NearBranch ) {
+					const auto kind = instruction.call ( ) ? XrefKind::Call : instruction.jmp ( ) ? XrefKind::Jump : XrefKind::ConditionalJump;
+					xrefs.push_back ( { instruction.ip, instruction.branch_target ( ), kind } );
+				}
+				else if ( instruction.mem_base ( ) == Register::RIP ) {
+					xrefs.push_back ( { instruction.ip, instruction.compute_memory_address ( ), XrefKind::Data } );
+				}
+			}
+
+			void discard_before ( std::uint64_t ip ) {
+				const auto end = std::lower_bound ( xrefs.begin ( ), xrefs.end ( ), ip, [ ] ( const Xref& lhs, std::uint64_t value ) {
+					return lhs.from < value;
+				} );
+				xrefs.erase ( xrefs.begin ( ), end );
+			}
+		};
+
+		/// Groups sorted xrefs by key into keys / offsets (one past the last key too) / values
+		template<typename Keys, typename PushKey, typename PushValue, typename SameKey>
+		static void build_table ( const std::vector<Xref>& xrefs, Keys& keys, std::vector<std::uint32_t>& offsets,
+								  PushKey&& pushKey, PushValue&& pushValue, SameKey&& sameKey ) {
+			for ( std::size_t index = 0; index < xrefs.size ( ); ++index ) {
+				if ( !index || !sameKey ( xrefs [ index - 1 ], xrefs [ index ] ) ) {
+					offsets.push_back ( static_cast< std::uint32_t >( index ) );
+					pushKey ( xrefs [ index ] );
+				}
+				pushValue ( xrefs [ index ] );
+			}
+			offsets.push_back ( static_cast< std::uint32_t >( xrefs.size ( ) ) );
+
+			keys.shrink_to_fit ( );
+			offsets.shrink_to_fit ( );
+		}
+
+		std::uint64_t baseAddr_ = 0;
+
+		// Target address -> sources
+		std::vector<std::uint64_t> toKeys_;
+		std::vector<std::uint32_t> toOffsets_;
+		std::vector<std::uint32_t> sources_;
+		std::vector<XrefKind> sourceKinds_;
+
+		// Source offset -> targets
+		std::vector<std::uint32_t> fromKeys_;
+		std::vector<std::uint32_t> fromOffsets_;
+		std::vector<std::uint64_t> targets_;
+		std::vector<XrefKind> targetKinds_;
+	};
+};
+#endif
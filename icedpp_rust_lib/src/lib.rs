@@ -1,9 +1,11 @@
 use iced_x86::{
-    Decoder, DecoderOptions, Formatter, Instruction, MemorySize, Mnemonic, NasmFormatter, OpKind,
-    Register, SpecializedFormatter, SpecializedFormatterTraitOptions,
+    CpuidFeature, Decoder, DecoderOptions, FlowControl, Formatter, GasFormatter, Instruction,
+    IntelFormatter, MasmFormatter, MemorySize, Mnemonic, NasmFormatter, OpKind, Register,
+    SpecializedFormatter, SpecializedFormatterTraitOptions, SymbolResolver, SymbolResult,
 };
 use memoffset::offset_of;
-use std::os::raw::c_char;
+use std::os::raw::{c_char, c_void};
+use std::sync::atomic::{AtomicU8, Ordering};
 use std::{ptr, slice};
 
 #[repr(u8)]
@@ -15,6 +17,9 @@ pub enum MergenPrefix {
     Lock = 1 << 2,  // 0b0100
 }
 
+// IcedAttribute::stack_positive, next to the prefix bits
+const STACK_POSITIVE: u8 = 1 << 3;
+
 #[derive(Debug, Clone, Copy)]
 enum OperandType {
     Invalid,
@@ -57,6 +62,11 @@ pub struct MergenDisassembledInstructionBase {
     pub mem_disp: u64,
     pub segment_prefix: u8,
     pub is_broadcast: bool,
+    pub op_mask: u8,
+    pub rounding: u8,
+    pub vector: u8,
+    pub cpuid_groups: u8,
+    pub code: u16,
 }
 #[repr(C)]
 #[derive(Debug, Clone)]
@@ -75,6 +85,11 @@ pub struct MergenDisassembledInstructionBase2 {
     pub mem_disp: u64,
     pub segment_prefix: u8,
     pub is_broadcast: bool,
+    pub op_mask: u8,
+    pub rounding: u8,
+    pub vector: u8,
+    pub cpuid_groups: u8,
+    pub code: u16,
     pub text: [u8; 64],
 }
 
@@ -127,6 +142,26 @@ const _: () = assert!(
     offset_of!(MergenDisassembledInstructionBase, mem_disp) == 32,
     "invalid offset"
 );
+const _: () = assert!(
+    offset_of!(MergenDisassembledInstructionBase, op_mask) == 42,
+    "invalid offset"
+);
+const _: () = assert!(
+    offset_of!(MergenDisassembledInstructionBase, vector) == 44,
+    "invalid offset"
+);
+const _: () = assert!(
+    offset_of!(MergenDisassembledInstructionBase, code) == 46,
+    "invalid offset"
+);
+const _: () = assert!(
+    std::mem::size_of::<MergenDisassembledInstructionBase>() == 48,
+    "invalid size"
+);
+const _: () = assert!(
+    offset_of!(MergenDisassembledInstructionBase2, text) == 48,
+    "invalid offset"
+);
 
 #[inline(always)]
 fn convert_type_to_mergen(instr: &Instruction, index: u32) -> OperandType {
@@ -185,9 +220,108 @@ fn set_attributes(instr: &Instruction) -> u8 {
     if instr.has_lock_prefix() {
         flags |= MergenPrefix::Lock as u8;
     }
+    // stack_growth only keeps the magnitude
+    if instr.stack_pointer_increment() > 0 {
+        flags |= STACK_POSITIVE;
+    }
+    flags
+}
+
+const VECTOR_ZEROING: u8 = 1 << 0;
+const VECTOR_SAE: u8 = 1 << 1;
+const VECTOR_VSIB: u8 = 1 << 2;
+
+// IcedVectorAttribute on the C++ side
+#[inline(always)]
+fn set_vector_attributes(instr: &Instruction) -> u8 {
+    let mut flags = 0u8;
+    if instr.zeroing_masking() {
+        flags |= VECTOR_ZEROING;
+    }
+    if instr.suppress_all_exceptions() {
+        flags |= VECTOR_SAE;
+    }
+    if instr.is_vsib() {
+        flags |= VECTOR_VSIB;
+    }
     flags
 }
 
+// CpuidGroup on the C++ side
+const CPUID_GENERAL: u8 = 1 << 0;
+const CPUID_X87: u8 = 1 << 1;
+const CPUID_MMX: u8 = 1 << 2;
+const CPUID_SSE: u8 = 1 << 3;
+const CPUID_AVX: u8 = 1 << 4;
+const CPUID_AVX512: u8 = 1 << 5;
+const CPUID_AMX: u8 = 1 << 6;
+const CPUID_SYSTEM: u8 = 1 << 7;
+
+// Same prefixes as iced::cpuid_group in iced.hpp
+fn classify_cpuid_feature(name: &str) -> u8 {
+    let starts = |prefixes: &[&str]| prefixes.iter().any(|prefix| name.starts_with(prefix));
+
+    if starts(&["AVX512", "AVX10"]) {
+        CPUID_AVX512
+    } else if starts(&["AMX"]) {
+        CPUID_AMX
+    } else if starts(&[
+        "AVX",
+        "FMA",
+        "F16C",
+        "XOP",
+        "VAES",
+        "VPCLMULQDQ",
+        "SHA512",
+        "SM3",
+        "SM4",
+    ]) {
+        CPUID_AVX
+    } else if starts(&["SSE", "SSSE", "AES", "PCLMULQDQ", "GFNI"]) || name == "SHA" {
+        CPUID_SSE
+    } else if name == "MMX" || starts(&["D3NOW", "AMD3DNOW"]) {
+        CPUID_MMX
+    } else if starts(&["FPU"]) || name == "X87" {
+        CPUID_X87
+    } else if starts(&["VMX", "VTX", "SVM", "SMX", "SGX", "TDX", "SEV"]) {
+        CPUID_SYSTEM
+    } else {
+        CPUID_GENERAL
+    }
+}
+
+// Group of each CpuidFeature, classified by name the first time it is seen (0 = not yet).
+// Threads racing on an entry store the same value.
+const UNCLASSIFIED: AtomicU8 = AtomicU8::new(0);
+static CPUID_FEATURE_GROUPS: [AtomicU8; 256] = [UNCLASSIFIED; 256];
+
+#[inline(always)]
+fn cpuid_groups(instr: &Instruction) -> u8 {
+    let mut groups = 0u8;
+    for &feature in instr.cpuid_features() {
+        let index = feature as usize;
+        let cached = CPUID_FEATURE_GROUPS
+            .get(index)
+            .map_or(0, |entry| entry.load(Ordering::Relaxed));
+        groups |= if cached != 0 {
+            cached
+        } else {
+            classify_uncached(feature)
+        };
+    }
+    groups
+}
+
+#[cold]
+#[inline(never)]
+fn classify_uncached(feature: CpuidFeature) -> u8 {
+    let group = classify_cpuid_feature(&format!("{:?}", feature));
+    if let Some(entry) = CPUID_FEATURE_GROUPS.get(feature as usize) {
+        entry.store(group, Ordering::Relaxed);
+    }
+    group
+}
+
 const HAS_64BIT_IMM: u8 = 0b01;
 const IS_RELATIVE: u8 = 0b10;
 
@@ -243,6 +377,7 @@ fn disassemble_instruction(instr: &Instruction) -> MergenDisassembledInstruction
                 OpKind::Immediate8 => instr.immediate8() as u64,
                 OpKind::Immediate16 => instr.immediate16() as u64,
                 OpKind::Immediate32 => instr.immediate32() as u64,
+                OpKind::Immediate32to64 => instr.immediate32to64() as u64,
                 OpKind::Immediate64 => instr.immediate64(),
                 OpKind::Immediate8to16 => instr.immediate8to16() as u64,
                 OpKind::Immediate8to32 => instr.immediate8to32() as u64,
@@ -283,6 +418,11 @@ fn disassemble_instruction(instr: &Instruction) -> MergenDisassembledInstruction
         length: instr_len_u8,
         segment_prefix: instr.segment_prefix() as u8,
         is_broadcast: instr.is_broadcast(),
+        op_mask: instr.op_mask() as u8,
+        rounding: instr.rounding_control() as u8,
+        vector: set_vector_attributes(&instr),
+        cpuid_groups: cpuid_groups(&instr),
+        code: instr.code() as u16,
     }
 }
 #[inline(always)]
@@ -304,6 +444,7 @@ fn disassemble_instruction2(instr: &Instruction) -> MergenDisassembledInstructio
                 OpKind::Immediate8 => instr.immediate8() as u64,
                 OpKind::Immediate16 => instr.immediate16() as u64,
                 OpKind::Immediate32 => instr.immediate32() as u64,
+                OpKind::Immediate32to64 => instr.immediate32to64() as u64,
                 OpKind::Immediate64 => instr.immediate64(),
                 OpKind::Immediate8to16 => instr.immediate8to16() as u64,
                 OpKind::Immediate8to32 => instr.immediate8to32() as u64,
@@ -344,6 +485,11 @@ fn disassemble_instruction2(instr: &Instruction) -> MergenDisassembledInstructio
         length: instr_len_u8,
         segment_prefix: instr.segment_prefix() as u8,
         is_broadcast: instr.is_broadcast(),
+        op_mask: instr.op_mask() as u8,
+        rounding: instr.rounding_control() as u8,
+        vector: set_vector_attributes(&instr),
+        cpuid_groups: cpuid_groups(&instr),
+        code: instr.code() as u16,
         text: [0u8; 64],
     }
 }
@@ -382,8 +528,177 @@ thread_local! {
     static CACHED_STRING: std::cell::RefCell<String> = std::cell::RefCell::new(String::with_capacity(64));
 }
 
-#[no_mangle]
-pub extern "C" fn disas2(
+// Specialized formatter options
+struct MyTraitOptions;
+impl SpecializedFormatterTraitOptions for MyTraitOptions {
+    const ENABLE_DB_DW_DD_DQ: bool = false;
+    unsafe fn verify_output_has_enough_bytes_left() -> bool {
+        false
+    }
+}
+
+type MyFormatter = SpecializedFormatter<MyTraitOptions>;
+
+// Specialized formatter that calls back into the caller's symbol resolver
+struct MySymbolTraitOptions;
+impl SpecializedFormatterTraitOptions for MySymbolTraitOptions {
+    const ENABLE_SYMBOL_RESOLVER: bool = true;
+    const ENABLE_DB_DW_DD_DQ: bool = false;
+    unsafe fn verify_output_has_enough_bytes_left() -> bool {
+        false
+    }
+}
+
+type MySymbolFormatter = SpecializedFormatter<MySymbolTraitOptions>;
+
+trait FormatText {
+    fn format_text(&mut self, instr: &Instruction, output: &mut String);
+}
+
+impl<T: SpecializedFormatterTraitOptions> FormatText for SpecializedFormatter<T> {
+    #[inline(always)]
+    fn format_text(&mut self, instr: &Instruction, output: &mut String) {
+        self.format(instr, output);
+    }
+}
+
+// One implementation per output syntax; every exported entry point is monomorphized over it
+// so the fast formatter never pays for dynamic dispatch.
+trait TextFormatter: FormatText + Sized + 'static {
+    type Symbolic: FormatText;
+
+    fn with<R>(f: impl FnOnce(&mut Self) -> R) -> R;
+    // Runs `f` on this thread's symbolic formatter, which resolves through ACTIVE_RESOLVER
+    fn with_symbols<R>(f: impl FnOnce(&mut Self::Symbolic) -> R) -> R;
+}
+
+thread_local! {
+    static CACHED_SYMBOL_FORMATTER: std::cell::RefCell<MySymbolFormatter> = std::cell::RefCell::new(
+        MySymbolFormatter::try_with_options(Some(Box::new(CallbackResolver)))
+            .unwrap_or_else(|_| MySymbolFormatter::new()),
+    );
+}
+
+impl TextFormatter for MyFormatter {
+    type Symbolic = MySymbolFormatter;
+
+    #[inline(always)]
+    fn with<R>(f: impl FnOnce(&mut Self) -> R) -> R {
+        f(&mut MyFormatter::new())
+    }
+
+    #[inline(always)]
+    fn with_symbols<R>(f: impl FnOnce(&mut MySymbolFormatter) -> R) -> R {
+        CACHED_SYMBOL_FORMATTER.with(|formatter| f(&mut *formatter.borrow_mut()))
+    }
+}
+
+// The full formatters allocate their options, so each thread keeps one of each around,
+// plus one with the callback resolver installed
+macro_rules! impl_text_formatter {
+    ($formatter:ty, $cache:ident, $symbol_cache:ident) => {
+        thread_local! {
+            static $cache: std::cell::RefCell<$formatter> = std::cell::RefCell::new(<$formatter>::new());
+            static $symbol_cache: std::cell::RefCell<$formatter> =
+                std::cell::RefCell::new(<$formatter>::with_options(Some(Box::new(CallbackResolver)), None));
+        }
+
+        impl FormatText for $formatter {
+            #[inline(always)]
+            fn format_text(&mut self, instr: &Instruction, output: &mut String) {
+                self.format(instr, output);
+            }
+        }
+
+        impl TextFormatter for $formatter {
+            type Symbolic = $formatter;
+
+            #[inline(always)]
+            fn with<R>(f: impl FnOnce(&mut Self) -> R) -> R {
+                $cache.with(|formatter| f(&mut *formatter.borrow_mut()))
+            }
+
+            #[inline(always)]
+            fn with_symbols<R>(f: impl FnOnce(&mut $formatter) -> R) -> R {
+                $symbol_cache.with(|formatter| f(&mut *formatter.borrow_mut()))
+            }
+        }
+    };
+}
+
+impl_text_formatter!(
+    IntelFormatter,
+    CACHED_INTEL_FORMATTER,
+    CACHED_INTEL_SYMBOL_FORMATTER
+);
+impl_text_formatter!(
+    MasmFormatter,
+    CACHED_MASM_FORMATTER,
+    CACHED_MASM_SYMBOL_FORMATTER
+);
+impl_text_formatter!(
+    NasmFormatter,
+    CACHED_NASM_FORMATTER,
+    CACHED_NASM_SYMBOL_FORMATTER
+);
+impl_text_formatter!(
+    GasFormatter,
+    CACHED_GAS_FORMATTER,
+    CACHED_GAS_SYMBOL_FORMATTER
+);
+
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MergenSymbol {
+    pub address: u64,
+    pub name: *const u8,
+    pub name_length: usize,
+}
+
+pub type MergenSymbolFn =
+    extern "C" fn(context: *mut c_void, address: u64, out: *mut MergenSymbol) -> bool;
+pub type MergenSymbolCallback = Option<MergenSymbolFn>;
+
+// Callback and context of the symbolic batch running on this thread. The cached symbolic
+// formatters own a CallbackResolver, so they are built once and only this pair changes.
+thread_local! {
+    static ACTIVE_RESOLVER: std::cell::Cell<Option<(MergenSymbolFn, *mut c_void)>> =
+        std::cell::Cell::new(None);
+}
+
+// Forwards iced's symbol lookups to the caller. The returned name must stay valid for the
+// whole batch, which holds for the C++ symbol table and any caller-owned string storage.
+struct CallbackResolver;
+
+impl SymbolResolver for CallbackResolver {
+    #[inline]
+    fn symbol(
+        &mut self,
+        _instruction: &Instruction,
+        _operand: u32,
+        _instruction_operand: Option<u32>,
+        address: u64,
+        _address_size: u32,
+    ) -> Option<SymbolResult<'_>> {
+        let (callback, context) = ACTIVE_RESOLVER.with(|active| active.get())?;
+        let mut symbol = MergenSymbol {
+            address: 0,
+            name: ptr::null(),
+            name_length: 0,
+        };
+        if !callback(context, address, &mut symbol) || symbol.name.is_null() {
+            return None;
+        }
+
+        let name = unsafe {
+            std::str::from_utf8_unchecked(slice::from_raw_parts(symbol.name, symbol.name_length))
+        };
+        Some(SymbolResult::with_str(symbol.address, name))
+    }
+}
+
+#[inline(always)]
+fn disas_text<F: TextFormatter>(
     out: *mut MergenDisassembledInstructionBase2,
     code_ptr: *const u8,
     len: usize,
@@ -397,31 +712,21 @@ pub extern "C" fn disas2(
     let mut instr = Instruction::default();
     decoder.decode_out(&mut instr);
 
-    // Specialized formatter options
-    struct MyTraitOptions;
-    impl SpecializedFormatterTraitOptions for MyTraitOptions {
-        const ENABLE_DB_DW_DD_DQ: bool = false;
-        unsafe fn verify_output_has_enough_bytes_left() -> bool {
-            false
-        }
-    }
-
-    type MyFormatter = SpecializedFormatter<MyTraitOptions>;
-    let mut formatter = MyFormatter::new();
-
     // Use thread-local cached string to avoid repeated allocations
-    let text = CACHED_STRING.with(|s| {
-        let mut s = s.borrow_mut();
-        s.clear(); // Clear previous content
-        formatter.format(&instr, &mut *s);
-
-        // Copy to fixed-size array
-        let bytes = s.as_bytes();
-        let mut text_array = [0u8; 64];
-        let copy_len = bytes.len().min(63);
-        text_array[..copy_len].copy_from_slice(&bytes[..copy_len]);
-        text_array[copy_len] = 0; // Null-terminate
-        text_array
+    let text = F::with(|formatter| {
+        CACHED_STRING.with(|s| {
+            let mut s = s.borrow_mut();
+            s.clear(); // Clear previous content
+            formatter.format_text(&instr, &mut *s);
+
+            // Copy to fixed-size array
+            let bytes = s.as_bytes();
+            let mut text_array = [0u8; 64];
+            let copy_len = bytes.len().min(63);
+            text_array[..copy_len].copy_from_slice(&bytes[..copy_len]);
+            text_array[copy_len] = 0; // Null-terminate
+            text_array
+        })
     });
 
     // Build the result
@@ -434,3 +739,354 @@ pub extern "C" fn disas2(
 
     0
 }
+
+#[no_mangle]
+pub extern "C" fn disas2(
+    out: *mut MergenDisassembledInstructionBase2,
+    code_ptr: *const u8,
+    len: usize,
+) -> i32 {
+    disas_text::<MyFormatter>(out, code_ptr, len)
+}
+
+#[no_mangle]
+pub extern "C" fn disas2_intel(
+    out: *mut MergenDisassembledInstructionBase2,
+    code_ptr: *const u8,
+    len: usize,
+) -> i32 {
+    disas_text::<IntelFormatter>(out, code_ptr, len)
+}
+
+#[no_mangle]
+pub extern "C" fn disas2_masm(
+    out: *mut MergenDisassembledInstructionBase2,
+    code_ptr: *const u8,
+    len: usize,
+) -> i32 {
+    disas_text::<MasmFormatter>(out, code_ptr, len)
+}
+
+#[no_mangle]
+pub extern "C" fn disas2_nasm(
+    out: *mut MergenDisassembledInstructionBase2,
+    code_ptr: *const u8,
+    len: usize,
+) -> i32 {
+    disas_text::<NasmFormatter>(out, code_ptr, len)
+}
+
+#[no_mangle]
+pub extern "C" fn disas2_gas(
+    out: *mut MergenDisassembledInstructionBase2,
+    code_ptr: *const u8,
+    len: usize,
+) -> i32 {
+    disas_text::<GasFormatter>(out, code_ptr, len)
+}
+
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MergenTextSpan {
+    pub offset: u64,
+    pub length: u32,
+    pub reserved: u32,
+}
+
+const _: () = assert!(std::mem::size_of::<MergenTextSpan>() == 16, "invalid size");
+
+// Formats the instructions at `count` addresses read from `ips` (one u64 every `ip_stride`
+// bytes, so callers can point straight at their own instruction array) and appends the
+// text to the caller's arena. Stops at the first instruction that no longer fits and
+// returns how many were formatted; `arena_used` is advanced accordingly.
+#[inline(always)]
+fn format_batch_core<F: FormatText>(
+    formatter: &mut F,
+    spans: *mut MergenTextSpan,
+    arena_ptr: *mut u8,
+    arena_capacity: usize,
+    arena_used: *mut usize,
+    code_ptr: *const u8,
+    len: usize,
+    base_ip: u64,
+    ips: *const u8,
+    ip_stride: usize,
+    count: usize,
+) -> isize {
+    if spans.is_null() || arena_ptr.is_null() || arena_used.is_null() || code_ptr.is_null() {
+        return handle_error() as isize;
+    }
+    if len == 0 || (count != 0 && ips.is_null()) {
+        return handle_error() as isize;
+    }
+
+    let code = unsafe { slice::from_raw_parts(code_ptr, len) };
+    let arena = unsafe { slice::from_raw_parts_mut(arena_ptr, arena_capacity) };
+    let spans = unsafe { slice::from_raw_parts_mut(spans, count) };
+    let mut used = unsafe { *arena_used };
+
+    let mut decoder = Decoder::with_ip(64, code, base_ip, DecoderOptions::NO_INVALID_CHECK);
+    let mut instr = Instruction::default();
+    let mut formatted = 0usize;
+
+    CACHED_STRING.with(|s| {
+        let mut s = s.borrow_mut();
+        for span in spans.iter_mut() {
+            let ip = unsafe { ptr::read_unaligned(ips.add(formatted * ip_stride) as *const u64) };
+            let offset = ip.wrapping_sub(base_ip);
+
+            // Addresses outside the buffer produce an empty span
+            s.clear();
+            if offset < len as u64 {
+                let _ = decoder.set_position(offset as usize);
+                decoder.set_ip(ip);
+                decoder.decode_out(&mut instr);
+                formatter.format_text(&instr, &mut *s);
+            }
+
+            let bytes = s.as_bytes();
+            let end = used + bytes.len();
+            if end > arena.len() {
+                break;
+            }
+            arena[used..end].copy_from_slice(bytes);
+            *span = MergenTextSpan {
+                offset: used as u64,
+                length: bytes.len() as u32,
+                reserved: 0,
+            };
+            used = end;
+            formatted += 1;
+        }
+    });
+
+    unsafe {
+        *arena_used = used;
+    }
+
+    formatted as isize
+}
+
+macro_rules! export_format_batch {
+    ($name:ident, $symbol_name:ident, $formatter:ty) => {
+        #[no_mangle]
+        pub extern "C" fn $name(
+            spans: *mut MergenTextSpan,
+            arena_ptr: *mut u8,
+            arena_capacity: usize,
+            arena_used: *mut usize,
+            code_ptr: *const u8,
+            len: usize,
+            base_ip: u64,
+            ips: *const u8,
+            ip_stride: usize,
+            count: usize,
+        ) -> isize {
+            <$formatter>::with(|formatter| {
+                format_batch_core(
+                    formatter,
+                    spans,
+                    arena_ptr,
+                    arena_capacity,
+                    arena_used,
+                    code_ptr,
+                    len,
+                    base_ip,
+                    ips,
+                    ip_stride,
+                    count,
+                )
+            })
+        }
+
+        // Same as above, but branch targets and memory operands are named through `resolver`
+        #[no_mangle]
+        pub extern "C" fn $symbol_name(
+            spans: *mut MergenTextSpan,
+            arena_ptr: *mut u8,
+            arena_capacity: usize,
+            arena_used: *mut usize,
+            code_ptr: *const u8,
+            len: usize,
+            base_ip: u64,
+            ips: *const u8,
+            ip_stride: usize,
+            count: usize,
+            resolver: MergenSymbolCallback,
+            context: *mut c_void,
+        ) -> isize {
+            let callback = match resolver {
+                Some(callback) => callback,
+                None => return handle_error() as isize,
+            };
+
+            let previous = ACTIVE_RESOLVER.with(|active| active.replace(Some((callback, context))));
+            let formatted = <$formatter>::with_symbols(|formatter| {
+                format_batch_core(
+                    formatter,
+                    spans,
+                    arena_ptr,
+                    arena_capacity,
+                    arena_used,
+                    code_ptr,
+                    len,
+                    base_ip,
+                    ips,
+                    ip_stride,
+                    count,
+                )
+            });
+            ACTIVE_RESOLVER.with(|active| active.set(previous));
+            formatted
+        }
+    };
+}
+
+export_format_batch!(format_batch, format_batch_sym, MyFormatter);
+export_format_batch!(format_batch_intel, format_batch_sym_intel, IntelFormatter);
+export_format_batch!(format_batch_masm, format_batch_sym_masm, MasmFormatter);
+export_format_batch!(format_batch_nasm, format_batch_sym_nasm, NasmFormatter);
+export_format_batch!(format_batch_gas, format_batch_sym_gas, GasFormatter);
+
+// Superset disassembly: decodes one instruction at every byte offset in
+// [first, first + count) of the buffer. `lengths[i]` receives the length of the instruction
+// at offset first + i, or 0 if the bytes there do not decode; `flows[i]` its FlowControl
+// class (same values as the C++ enum). Instructions may run past the range into the rest
+// of the buffer. Returns the number of valid offsets.
+#[no_mangle]
+pub extern "C" fn disas_superset(
+    lengths: *mut u8,
+    flows: *mut u8,
+    code_ptr: *const u8,
+    len: usize,
+    first: usize,
+    count: usize,
+) -> isize {
+    if lengths.is_null() || flows.is_null() || code_ptr.is_null() || len == 0 {
+        return handle_error() as isize;
+    }
+    if first > len || count > len - first {
+        return handle_error() as isize;
+    }
+
+    let code = unsafe { slice::from_raw_parts(code_ptr, len) };
+    let lengths = unsafe { slice::from_raw_parts_mut(lengths, count) };
+    let flows = unsafe { slice::from_raw_parts_mut(flows, count) };
+
+    // Invalid encodings must be reported here, so keep the decoder's checks enabled
+    let mut decoder = Decoder::new(64, code, DecoderOptions::NONE);
+    let mut instr = Instruction::default();
+    let mut valid = 0usize;
+
+    for (index, (length, flow)) in lengths.iter_mut().zip(flows.iter_mut()).enumerate() {
+        let _ = decoder.set_position(first + index);
+        decoder.decode_out(&mut instr);
+        if instr.is_invalid() {
+            *length = 0;
+            *flow = FlowControl::Next as u8;
+            continue;
+        }
+
+        *length = instr.len() as u8;
+        *flow = instr.flow_control() as u8;
+        valid += 1;
+    }
+
+    valid as isize
+}
+
+// Gather decode: decodes the instructions at `count` unrelated addresses in one call.
+// `out[i]` receives the same record `disas` produces for the bytes at ips[i]; addresses
+// outside the buffer get a zeroed record (Mnemonic::INVALID, length 0). Returns the number
+// of addresses that were inside the buffer.
+#[no_mangle]
+pub extern "C" fn disas_gather(
+    out: *mut MergenDisassembledInstructionBase,
+    code_ptr: *const u8,
+    len: usize,
+    base_ip: u64,
+    ips: *const u64,
+    count: usize,
+) -> isize {
+    if out.is_null() || code_ptr.is_null() || len == 0 || (count != 0 && ips.is_null()) {
+        return handle_error() as isize;
+    }
+
+    let code = unsafe { slice::from_raw_parts(code_ptr, len) };
+    let out = unsafe { slice::from_raw_parts_mut(out, count) };
+    let ips = unsafe { slice::from_raw_parts(ips, count) };
+
+    let mut decoder = Decoder::new(64, code, DecoderOptions::NO_INVALID_CHECK);
+    let mut instr = Instruction::default();
+    let mut decoded = 0usize;
+
+    for (record, &ip) in out.iter_mut().zip(ips.iter()) {
+        let offset = ip.wrapping_sub(base_ip);
+        if offset >= len as u64 {
+            *record = unsafe { std::mem::zeroed() };
+            continue;
+        }
+
+        // Records are relative to the instruction start, exactly like `disas`
+        let _ = decoder.set_position(offset as usize);
+        decoder.set_ip(0);
+        decoder.decode_out(&mut instr);
+        *record = disassemble_instruction(&instr);
+        decoded += 1;
+    }
+
+    decoded as isize
+}
+
+// CPUID scan: sweeps the buffer from offset `first` the way the C++ decoders do and writes the
+// address of every instruction whose CPUID groups intersect `groups` to `out`, at most
+// `capacity` of them. `next` receives the offset to resume from, `len` once the sweep is
+// complete. Returns the number of addresses written.
+#[no_mangle]
+pub extern "C" fn disas_find_cpuid(
+    out: *mut u64,
+    capacity: usize,
+    code_ptr: *const u8,
+    len: usize,
+    base_ip: u64,
+    first: usize,
+    groups: u8,
+    next: *mut usize,
+) -> isize {
+    if out.is_null() || code_ptr.is_null() || next.is_null() || first > len {
+        return handle_error() as isize;
+    }
+
+    let code = unsafe { slice::from_raw_parts(code_ptr, len) };
+    let out = unsafe { slice::from_raw_parts_mut(out, capacity) };
+
+    let mut decoder = Decoder::new(64, code, DecoderOptions::NO_INVALID_CHECK);
+    let _ = decoder.set_position(first);
+    decoder.set_ip(base_ip.wrapping_add(first as u64));
+    let mut instr = Instruction::default();
+    let mut found = 0usize;
+
+    while found < capacity && decoder.can_decode() {
+        decoder.decode_out(&mut instr);
+        if cpuid_groups(&instr) & groups != 0 {
+            out[found] = instr.ip();
+            found += 1;
+        }
+    }
+
+    unsafe {
+        *next = decoder.position();
+    }
+    found as isize
+}
+
+// Creates this thread's cached text buffer and formatters up front, so the first instruction
+// a new worker thread decodes or formats does not pay for the allocations.
+#[no_mangle]
+pub extern "C" fn warm_up_thread() {
+    CACHED_STRING.with(|s| s.borrow_mut().reserve(64));
+    IntelFormatter::with(|_| ());
+    MasmFormatter::with(|_| ());
+    NasmFormatter::with(|_| ());
+    GasFormatter::with(|_| ());
+}
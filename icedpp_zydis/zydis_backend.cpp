@@ -0,0 +1,525 @@
+// Zydis implementation of the backend entry points declared in iced.hpp, built instead of
+// icedpp_rust_lib when no Rust toolchain is available (BUILD_WITH_ZYDIS or Cargo not found).
+// It fills the same record layout as the Rust library: Zydis mnemonics and registers are mapped
+// to iced's enums through the name tables in iced_internal.hpp, and flow control comes from
+// the shared InstructionAccessors logic. Output syntaxes map to the closest Zydis style.
+// Experimental: the records have not been diffed against the Rust library on real Zydis yet.
+#include "iced.hpp"
+
+#include <Zydis/Zydis.h>
+
+#include <cstdio>
+
+namespace
+{
+	using __iced_internal::IcedInstruction;
+	using __iced_internal::IcedInstructionRecord;
+	using __iced_internal::IcedSymbol;
+	using __iced_internal::IcedSymbolCallback;
+
+	enum Style : std::size_t {
+		Intel, // also used for the fast and NASM syntaxes
+		Masm,
+		Att,
+		StyleCount,
+	};
+
+	struct ConditionAlias {
+		std::string_view zydis;
+		std::string_view iced;
+	};
+
+	// Zydis spells some condition codes differently: jnb, setz, cmovnle are jae, sete, cmovg in iced
+	constexpr ConditionAlias conditionAliases [ ] = {
+		{ "nb", "ae" }, { "nbe", "a" }, { "nl", "ge" }, { "nle", "g" }, { "nz", "ne" }, { "z", "e" },
+	};
+
+	Mnemonic translate_mnemonic ( std::string_view name ) {
+		if ( name == "xlat" ) {
+			return Mnemonic::Xlatb;
+		}
+
+		for ( const std::string_view prefix : { std::string_view ( "j" ), std::string_view ( "set" ), std::string_view ( "cmov" ) } ) {
+			if ( name.size ( ) <= prefix.size ( ) || name.substr ( 0, prefix.size ( ) ) != prefix ) {
+				continue;
+			}
+
+			for ( const auto& alias : conditionAliases ) {
+				if ( name.substr ( prefix.size ( ) ) == alias.zydis ) {
+					char spelled [ 16 ];
+					std::memcpy ( spelled, prefix.data ( ), prefix.size ( ) );
+					std::memcpy ( spelled + prefix.size ( ), alias.iced.data ( ), alias.iced.size ( ) );
+					return iced::parse_mnemonic ( std::string_view ( spelled, prefix.size ( ) + alias.iced.size ( ) ) );
+				}
+			}
+		}
+
+		return iced::parse_mnemonic ( name );
+	}
+
+	Register translate_register ( std::string_view name ) {
+		// Zydis names the low bytes of r8-r15 r8b..r15b, iced r8l..r15l
+		if ( name.size ( ) >= 3 && name.size ( ) < 8 && name [ 0 ] == 'r' && name [ 1 ] >= '0' && name [ 1 ] <= '9' && name.back ( ) == 'b' ) {
+			char spelled [ 8 ];
+			std::memcpy ( spelled, name.data ( ), name.size ( ) );
+			spelled [ name.size ( ) - 1 ] = 'l';
+			return iced::parse_register ( std::string_view ( spelled, name.size ( ) ) );
+		}
+
+		return iced::parse_register ( name );
+	}
+
+	/// Decoder, enum translation and formatters; configuration only, shared by all threads
+	struct Backend {
+		ZydisDecoder decoder;
+		Mnemonic mnemonics [ ZYDIS_MNEMONIC_MAX_VALUE + 1 ];
+		Register registers [ ZYDIS_REGISTER_MAX_VALUE + 1 ];
+		CpuidGroup isaGroups [ ZYDIS_ISA_EXT_MAX_VALUE + 1 ];
+		ZydisFormatter formatters [ StyleCount ];
+		ZydisFormatter symbolFormatters [ StyleCount ];
+		ZydisFormatterFunc printAddress [ StyleCount ];
+
+		Backend ( ) {
+			ZydisDecoderInit ( &decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64 );
+
+			for ( std::size_t value = 0; value <= ZYDIS_MNEMONIC_MAX_VALUE; ++value ) {
+				const auto* name = ZydisMnemonicGetString ( static_cast< ZydisMnemonic >( value ) );
+				mnemonics [ value ] = name ? translate_mnemonic ( name ) : Mnemonic::INVALID;
+			}
+			for ( std::size_t value = 0; value <= ZYDIS_REGISTER_MAX_VALUE; ++value ) {
+				const auto* name = ZydisRegisterGetString ( static_cast< ZydisRegister >( value ) );
+				registers [ value ] = name ? translate_register ( name ) : Register::None;
+			}
+			for ( std::size_t value = 0; value <= ZYDIS_ISA_EXT_MAX_VALUE; ++value ) {
+				const auto* name = ZydisISAExtGetString ( static_cast< ZydisISAExt >( value ) );
+				isaGroups [ value ] = name ? iced::cpuid_group ( name ) : CpuidGroup::General;
+			}
+
+			constexpr ZydisFormatterStyle styles [ StyleCount ] = {
+				ZYDIS_FORMATTER_STYLE_INTEL, ZYDIS_FORMATTER_STYLE_INTEL_MASM, ZYDIS_FORMATTER_STYLE_ATT,
+			};
+			for ( std::size_t style = 0; style < StyleCount; ++style ) {
+				ZydisFormatterInit ( &formatters [ style ], styles [ style ] );
+				ZydisFormatterInit ( &symbolFormatters [ style ], styles [ style ] );
+				printAddress [ style ] = &print_address;
+				ZydisFormatterSetHook ( &symbolFormatters [ style ], ZYDIS_FORMATTER_FUNC_PRINT_ADDRESS_ABS,
+										( const void** ) &printAddress [ style ] );
+			}
+		}
+
+		/// Passed as formatter user data while a batch is formatted with symbols
+		struct SymbolContext {
+			IcedSymbolCallback resolver;
+			void* context;
+			ZydisFormatterFunc printAddress;
+		};
+
+		static ZyanStatus print_address ( const ZydisFormatter* formatter, ZydisFormatterBuffer* buffer, ZydisFormatterContext* context ) {
+			const auto* symbols = static_cast< const SymbolContext* >( context->user_data );
+
+			ZyanU64 address = 0;
+			IcedSymbol symbol { };
+			if ( !ZYAN_SUCCESS ( ZydisCalcAbsoluteAddress ( context->instruction, context->operand, context->runtime_address, &address ) ) ||
+				 !symbols->resolver ( symbols->context, address, &symbol ) || !symbol.name ) {
+				return symbols->printAddress ( formatter, buffer, context );
+			}
+
+			ZYAN_CHECK ( ZydisFormatterBufferAppend ( buffer, ZYDIS_TOKEN_SYMBOL ) );
+			ZyanString* string = nullptr;
+			ZYAN_CHECK ( ZydisFormatterBufferGetString ( buffer, &string ) );
+
+			ZyanStringView view;
+			ZYAN_CHECK ( ZyanStringViewInsideBufferEx ( &view, symbol.name, symbol.name_length ) );
+			ZYAN_CHECK ( ZyanStringAppend ( string, &view ) );
+			if ( address == symbol.address ) {
+				return ZYAN_STATUS_SUCCESS;
+			}
+
+			char displacement [ 24 ];
+			const auto length = address > symbol.address
+				? std::snprintf ( displacement, sizeof ( displacement ), "+0x%llx", static_cast< unsigned long long >( address - symbol.address ) )
+				: std::snprintf ( displacement, sizeof ( displacement ), "-0x%llx", static_cast< unsigned long long >( symbol.address - address ) );
+			ZYAN_CHECK ( ZyanStringViewInsideBufferEx ( &view, displacement, static_cast< ZyanUSize >( length ) ) );
+			return ZyanStringAppend ( string, &view );
+		}
+	};
+
+	const Backend& backend ( ) {
+		static const Backend instance;
+		return instance;
+	}
+
+	OpKind register_kind ( Register reg ) {
+		switch ( iced::register_size ( reg ) ) {
+			case 1: return OpKind::Register8;
+			case 2: return OpKind::Register16;
+			case 4: return OpKind::Register32;
+			case 16: return OpKind::Register128;
+			case 32: return OpKind::Register256;
+			case 64: return OpKind::Register512;
+			default: return OpKind::Register64;
+		}
+	}
+
+	OpKind memory_kind ( const ZydisDecodedOperand& operand ) {
+		if ( operand.mem.type == ZYDIS_MEMOP_TYPE_AGEN ) {
+			return OpKind::Memory64;
+		}
+
+		switch ( operand.size / 8 ) {
+			case 1: return OpKind::Memory8;
+			case 2: return OpKind::Memory16;
+			case 4: return OpKind::Memory32;
+			case 16: return OpKind::Memory128;
+			case 32: return OpKind::Memory256;
+			case 64: return OpKind::Memory512;
+			default: return OpKind::Memory64;
+		}
+	}
+
+	std::uint8_t stack_growth ( const ZydisDecodedInstruction& instruction, const ZydisDecodedOperand* operands ) {
+		switch ( instruction.mnemonic ) {
+			case ZYDIS_MNEMONIC_PUSH:
+			case ZYDIS_MNEMONIC_POP:
+			case ZYDIS_MNEMONIC_PUSHF:
+			case ZYDIS_MNEMONIC_PUSHFD:
+			case ZYDIS_MNEMONIC_PUSHFQ:
+			case ZYDIS_MNEMONIC_POPF:
+			case ZYDIS_MNEMONIC_POPFD:
+			case ZYDIS_MNEMONIC_POPFQ:
+				return static_cast< std::uint8_t >( instruction.operand_width / 8 );
+			case ZYDIS_MNEMONIC_CALL:
+				return 8;
+			case ZYDIS_MNEMONIC_RET:
+				return static_cast< std::uint8_t >( 8 + ( instruction.operand_count_visible ? operands [ 0 ].imm.value.u : 0 ) );
+			default:
+				return 0;
+		}
+	}
+
+	Register segment_prefix ( const ZydisDecodedInstruction& instruction ) {
+		const auto attributes = instruction.attributes;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_CS ) return Register::CS;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_SS ) return Register::SS;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_DS ) return Register::DS;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_ES ) return Register::ES;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_FS ) return Register::FS;
+		if ( attributes & ZYDIS_ATTRIB_HAS_SEGMENT_GS ) return Register::GS;
+		return Register::None;
+	}
+
+	/// Same fields the Rust library derives from iced's Instruction; displacements stay relative
+	void fill_record ( const ZydisDecodedInstruction& instruction, const ZydisDecodedOperand* operands, IcedInstructionRecord& record ) {
+		const auto& maps = backend ( );
+
+		record = { };
+		record.mnemonic = maps.mnemonics [ instruction.mnemonic ];
+		record.length = instruction.length;
+		record.mem_scale = 1;
+		record.stack_growth = stack_growth ( instruction, operands );
+		record.attributes.rep = ( instruction.attributes & ( ZYDIS_ATTRIB_HAS_REP | ZYDIS_ATTRIB_HAS_REPE ) ) != 0;
+		record.attributes.repne = ( instruction.attributes & ZYDIS_ATTRIB_HAS_REPNE ) != 0;
+		record.attributes.lock = ( instruction.attributes & ZYDIS_ATTRIB_HAS_LOCK ) != 0;
+		switch ( instruction.mnemonic ) {
+			case ZYDIS_MNEMONIC_POP:
+			case ZYDIS_MNEMONIC_POPF:
+			case ZYDIS_MNEMONIC_POPFD:
+			case ZYDIS_MNEMONIC_POPFQ:
+			case ZYDIS_MNEMONIC_RET:
+				record.attributes.stack_positive = 1;
+				break;
+			default:
+				break;
+		}
+		record.segment_prefix = segment_prefix ( instruction );
+		// The first broadcast mode enumerator is "no broadcast"
+		record.is_broadcast = static_cast< int >( instruction.avx.broadcast.mode ) != 0;
+		// iced reports no opmask for k0, and its rounding modes follow Zydis' after "invalid"
+		if ( instruction.avx.mask.reg != ZYDIS_REGISTER_K0 ) {
+			record.op_mask = maps.registers [ instruction.avx.mask.reg ];
+		}
+		record.vector.zeroing = instruction.avx.mask.mode == ZYDIS_MASK_MODE_ZEROING || instruction.avx.mask.mode == ZYDIS_MASK_MODE_CONTROL_ZEROING;
+		record.vector.sae = instruction.avx.has_sae;
+		record.rounding = static_cast< RoundingControl >( instruction.avx.rounding.mode );
+		// Zydis has no counterpart of iced's Code, so only the ISA extension is reported
+		record.cpuid_groups = maps.isaGroups [ instruction.meta.isa_ext ];
+
+		const auto count = std::min<std::size_t> ( instruction.operand_count_visible, 4 );
+		record.operand_count_visible = static_cast< std::uint8_t >( count );
+
+		bool memory = false;
+		std::size_t immediates = 0;
+		for ( std::size_t index = 0; index < count; ++index ) {
+			const auto& operand = operands [ index ];
+			switch ( operand.type ) {
+				case ZYDIS_OPERAND_TYPE_REGISTER:
+					record.regs [ index ] = maps.registers [ operand.reg.value ];
+					record.types [ index ] = register_kind ( record.regs [ index ] );
+					break;
+
+				case ZYDIS_OPERAND_TYPE_MEMORY:
+					record.types [ index ] = memory_kind ( operand );
+					// iced leaves the implicit string operands ([rsi], [rdi]) without base and index
+					if ( !memory && operand.visibility == ZYDIS_OPERAND_VISIBILITY_EXPLICIT ) {
+						memory = true;
+						record.mem_base = maps.registers [ operand.mem.base ];
+						record.mem_index = maps.registers [ operand.mem.index ];
+						record.mem_scale = operand.mem.scale ? operand.mem.scale : 1;
+						record.mem_disp = static_cast< std::uint64_t >( operand.mem.disp.value );
+						record.vector.vsib = operand.mem.type == ZYDIS_MEMOP_TYPE_VSIB;
+					}
+					break;
+
+				case ZYDIS_OPERAND_TYPE_POINTER:
+					record.types [ index ] = OpKind::FarBranch;
+					record.mem_disp = operand.ptr.offset;
+					break;
+
+				case ZYDIS_OPERAND_TYPE_IMMEDIATE: {
+					const auto& raw = instruction.raw.imm [ std::min<std::size_t> ( immediates++, 1 ) ];
+					if ( operand.imm.is_relative ) {
+						record.types [ index ] = OpKind::NearBranch;
+						record.mem_disp = static_cast< std::uint64_t >( operand.imm.value.s );
+						break;
+					}
+
+					const auto second = immediates == 2 && raw.size == 8;
+					record.types [ index ] = second ? OpKind::Immediate8_2nd
+						: raw.size == 8 ? OpKind::Immediate8 : raw.size == 16 ? OpKind::Immediate16 : raw.size == 32 ? OpKind::Immediate32 : OpKind::Immediate64;
+
+					// iced keeps the second imm8 of enter, extrq and insertq in the displacement slot
+					if ( second ) {
+						record.immediate2 = operand.imm.value.u & 0xFF;
+					}
+					// Like iced: the last operand's value, zero-extended at its own size, sign-extended when widened
+					else if ( index + 1 == count ) {
+						record.immediate = operand.size == raw.size && raw.size < 64
+							? operand.imm.value.u & ( ( 1ULL << raw.size ) - 1 )
+							: operand.imm.value.u;
+					}
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+	}
+
+	/// Decodes one instruction; undecodable bytes give an INVALID record of length 1
+	bool decode ( const std::uint8_t* code, std::size_t length, IcedInstructionRecord& record,
+				  ZydisDecodedInstruction& instruction, ZydisDecodedOperand* operands ) {
+		if ( !ZYAN_SUCCESS ( ZydisDecoderDecodeFull ( &backend ( ).decoder, code, length, &instruction, operands ) ) ) {
+			record = { };
+			record.length = 1;
+			record.mem_scale = 1;
+			return false;
+		}
+
+		fill_record ( instruction, operands, record );
+		return true;
+	}
+
+	/// Writes NUL-terminated text into `buffer` and returns its length
+	std::size_t format_text ( const ZydisFormatter& formatter, const ZydisDecodedInstruction& instruction, const ZydisDecodedOperand* operands,
+							  std::uint64_t ip, void* userData, char* buffer, std::size_t size ) {
+		if ( !ZYAN_SUCCESS ( ZydisFormatterFormatInstruction ( &formatter, &instruction, operands, instruction.operand_count_visible,
+															   buffer, size, ip, userData ) ) ) {
+			std::snprintf ( buffer, size, "(bad)" );
+		}
+		return std::strlen ( buffer );
+	}
+
+	int disas_text ( Style style, void* obj, const void* code, std::size_t len ) {
+		if ( !obj || !code || !len ) {
+			return -1;
+		}
+
+		auto* out = static_cast< IcedInstruction* >( obj );
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		IcedInstructionRecord record;
+		const auto valid = decode ( static_cast< const std::uint8_t* >( code ), len, record, instruction, operands );
+
+		std::memcpy ( out, &record, sizeof ( record ) );
+		std::memset ( out->text, 0, sizeof ( out->text ) );
+		if ( valid ) {
+			( void )format_text ( backend ( ).formatters [ style ], instruction, operands, 0, nullptr, out->text, sizeof ( out->text ) );
+		}
+		return 0;
+	}
+
+	std::ptrdiff_t format_batch_core ( Style style, IcedSymbolCallback resolver, void* resolverContext, void* spans, void* arena,
+									   std::size_t arenaCapacity, std::size_t* arenaUsed, const void* code, std::size_t len,
+									   std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count ) {
+		if ( !spans || !arena || !arenaUsed || !code || !len || ( count && !ips ) ) {
+			return -1;
+		}
+
+		const auto& state = backend ( );
+		const auto& formatter = resolver ? state.symbolFormatters [ style ] : state.formatters [ style ];
+		Backend::SymbolContext symbols { resolver, resolverContext, state.printAddress [ style ] };
+
+		auto* out = static_cast< iced::TextSpan* >( spans );
+		auto* text = static_cast< char* >( arena );
+		const auto* bytes = static_cast< const std::uint8_t* >( code );
+		auto used = *arenaUsed;
+
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		char buffer [ 256 ];
+
+		std::size_t formatted = 0;
+		for ( ; formatted < count; ++formatted ) {
+			std::uint64_t ip;
+			std::memcpy ( &ip, static_cast< const std::uint8_t* >( ips ) + formatted * ipStride, sizeof ( ip ) );
+
+			// Addresses outside the buffer produce an empty span
+			std::size_t length = 0;
+			const auto offset = ip - baseAddress;
+			if ( offset < len ) {
+				if ( ZYAN_SUCCESS ( ZydisDecoderDecodeFull ( &state.decoder, bytes + offset, len - offset, &instruction, operands ) ) ) {
+					length = format_text ( formatter, instruction, operands, ip, &symbols, buffer, sizeof ( buffer ) );
+				}
+				else {
+					length = static_cast< std::size_t >( std::snprintf ( buffer, sizeof ( buffer ), "(bad)" ) );
+				}
+			}
+
+			if ( used + length > arenaCapacity ) {
+				break;
+			}
+
+			std::memcpy ( text + used, buffer, length );
+			out [ formatted ] = { used, static_cast< std::uint32_t >( length ), 0 };
+			used += length;
+		}
+
+		*arenaUsed = used;
+		return static_cast< std::ptrdiff_t >( formatted );
+	}
+};
+
+extern "C" {
+	int disas ( void* obj, const void* code, std::size_t len ) {
+		if ( !obj || !code || !len ) {
+			return -1;
+		}
+
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		IcedInstructionRecord record;
+		( void )decode ( static_cast< const std::uint8_t* >( code ), len, record, instruction, operands );
+		std::memcpy ( obj, &record, sizeof ( record ) );
+		return 0;
+	}
+
+	int disas2 ( void* obj, const void* code, std::size_t len ) { return disas_text ( Intel, obj, code, len ); }
+	int disas2_intel ( void* obj, const void* code, std::size_t len ) { return disas_text ( Intel, obj, code, len ); }
+	int disas2_masm ( void* obj, const void* code, std::size_t len ) { return disas_text ( Masm, obj, code, len ); }
+	int disas2_nasm ( void* obj, const void* code, std::size_t len ) { return disas_text ( Intel, obj, code, len ); }
+	int disas2_gas ( void* obj, const void* code, std::size_t len ) { return disas_text ( Att, obj, code, len ); }
+
+#define ICED_ZYDIS_FORMAT_BATCH( name, symbolName, style )                                                                                     \
+	std::ptrdiff_t name ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,                                        \
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count ) {             \
+		return format_batch_core ( style, nullptr, nullptr, spans, arena, arenaCapacity, arenaUsed, code, len, baseAddress, ips, ipStride, count ); \
+	}                                                                                                                                          \
+	std::ptrdiff_t symbolName ( void* spans, void* arena, std::size_t arenaCapacity, std::size_t* arenaUsed,                                  \
+		const void* code, std::size_t len, std::uint64_t baseAddress, const void* ips, std::size_t ipStride, std::size_t count,                \
+		IcedSymbolCallback resolver, void* context ) {                                                                                         \
+		if ( !resolver ) {                                                                                                                     \
+			return -1;                                                                                                                         \
+		}                                                                                                                                      \
+		return format_batch_core ( style, resolver, context, spans, arena, arenaCapacity, arenaUsed, code, len, baseAddress, ips, ipStride, count ); \
+	}
+
+	ICED_ZYDIS_FORMAT_BATCH ( format_batch, format_batch_sym, Intel )
+	ICED_ZYDIS_FORMAT_BATCH ( format_batch_intel, format_batch_sym_intel, Intel )
+	ICED_ZYDIS_FORMAT_BATCH ( format_batch_masm, format_batch_sym_masm, Masm )
+	ICED_ZYDIS_FORMAT_BATCH ( format_batch_nasm, format_batch_sym_nasm, Intel )
+	ICED_ZYDIS_FORMAT_BATCH ( format_batch_gas, format_batch_sym_gas, Att )
+
+#undef ICED_ZYDIS_FORMAT_BATCH
+
+	std::ptrdiff_t disas_superset ( void* lengths, void* flows, const void* code, std::size_t len, std::size_t first, std::size_t count ) {
+		if ( !lengths || !flows || !code || !len || first > len || count > len - first ) {
+			return -1;
+		}
+
+		auto* lengthOut = static_cast< std::uint8_t* >( lengths );
+		auto* flowOut = static_cast< std::uint8_t* >( flows );
+		const auto* bytes = static_cast< const std::uint8_t* >( code );
+
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		IcedInstructionRecord record;
+		std::ptrdiff_t valid = 0;
+		for ( std::size_t index = 0; index < count; ++index ) {
+			if ( !decode ( bytes + first + index, len - first - index, record, instruction, operands ) ) {
+				lengthOut [ index ] = 0;
+				flowOut [ index ] = static_cast< std::uint8_t >( FlowControl::Next );
+				continue;
+			}
+
+			// Valid for Zydis but without an iced mnemonic: treat as a plain instruction
+			const auto flow = record.mnemonic == Mnemonic::INVALID ? FlowControl::Next : iced::CompactInstruction ( record, 0 ).flow_control ( );
+			lengthOut [ index ] = record.length;
+			flowOut [ index ] = static_cast< std::uint8_t >( flow );
+			++valid;
+		}
+		return valid;
+	}
+
+	std::ptrdiff_t disas_gather ( void* out, const void* code, std::size_t len, std::uint64_t baseAddress, const std::uint64_t* ips, std::size_t count ) {
+		if ( !out || !code || !len || ( count && !ips ) ) {
+			return -1;
+		}
+
+		auto* records = static_cast< IcedInstructionRecord* >( out );
+		const auto* bytes = static_cast< const std::uint8_t* >( code );
+
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		std::ptrdiff_t decoded = 0;
+		for ( std::size_t index = 0; index < count; ++index ) {
+			const auto offset = ips [ index ] - baseAddress;
+			if ( offset >= len ) {
+				std::memset ( &records [ index ], 0, sizeof ( records [ index ] ) );
+				continue;
+			}
+
+			( void )decode ( bytes + offset, len - offset, records [ index ], instruction, operands );
+			++decoded;
+		}
+		return decoded;
+	}
+
+	std::ptrdiff_t disas_find_cpuid ( std::uint64_t* out, std::size_t capacity, const void* code, std::size_t len, std::uint64_t baseAddress,
+									  std::size_t first, std::uint8_t groups, std::size_t* next ) {
+		if ( !out || !code || !next || first > len ) {
+			return -1;
+		}
+
+		const auto* bytes = static_cast< const std::uint8_t* >( code );
+
+		ZydisDecodedInstruction instruction;
+		ZydisDecodedOperand operands [ ZYDIS_MAX_OPERAND_COUNT ];
+		IcedInstructionRecord record;
+		std::ptrdiff_t found = 0;
+		auto offset = first;
+		while ( static_cast< std::size_t >( found ) < capacity && offset < len ) {
+			( void )decode ( bytes + offset, len - offset, record, instruction, operands );
+			if ( static_cast< std::uint8_t >( record.cpuid_groups ) & groups ) {
+				out [ found++ ] = baseAddress + offset;
+			}
+			offset += record.length;
+		}
+		*next = offset;
+		return found;
+	}
+
+	void warm_up_thread ( ) {
+		( void )backend ( );
+	}
+}
@@ -0,0 +1,74 @@
+// Checks the Code values the backend writes into the records. Code is opaque on the C++ side,
+// so this holds the backend to what callers rely on: every Code is below codeTableSize, and a
+// Code always comes with the same mnemonic. A run that sees no Code at all fails rather than
+// passing vacuously; the Zydis backend, which has no Code, does not register this test.
+#include "iced.hpp"
+
+#include "../tools/corpus.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t corpusSize = 1 << 20;
+	constexpr std::size_t shownMismatches = 16;
+
+	/// <returns>True if every decoded Code is in range and maps to a single mnemonic</returns>
+	bool check ( const tools::Corpus& corpus ) {
+		const auto size = corpus.code.size ( );
+		const iced::ReleaseDecoder decoder ( corpus.code.data ( ), size, corpus.address );
+
+		std::vector<std::uint64_t> ips ( size );
+		for ( std::size_t offset = 0; offset < size; ++offset ) {
+			ips [ offset ] = corpus.address + offset;
+		}
+
+		std::vector<iced::CompactInstruction> instructions ( size );
+		decoder.gather ( ips.data ( ), ips.size ( ), instructions.data ( ) );
+
+		// Mnemonic first seen with each Code; INVALID while unseen
+		std::vector<Mnemonic> mnemonics ( iced::codeTableSize, Mnemonic::INVALID );
+		std::size_t checked = 0, distinct = 0, badCodes = 0, mismatched = 0;
+		for ( const auto& instruction : instructions ) {
+			const auto code = static_cast< std::size_t >( instruction.code ( ) );
+			if ( !instruction.valid ( ) ) {
+				continue;
+			}
+
+			++checked;
+			if ( code >= iced::codeTableSize || instruction.code ( ) == Code::INVALID ) {
+				if ( ++badCodes <= shownMismatches ) {
+					std::printf ( "0x%llx: code %zu invalid or out of range\n", static_cast< unsigned long long >( instruction.ip ), code );
+				}
+				continue;
+			}
+
+			auto& expected = mnemonics [ code ];
+			if ( expected == Mnemonic::INVALID ) {
+				expected = instruction.mnemonic ( );
+				++distinct;
+				continue;
+			}
+
+			if ( expected != instruction.mnemonic ( ) && ++mismatched <= shownMismatches ) {
+				const auto first = iced::mnemonic_name ( expected );
+				const auto now = iced::mnemonic_name ( instruction.mnemonic ( ) );
+				std::printf ( "0x%llx: code %zu, first %.*s, now %.*s\n", static_cast< unsigned long long >( instruction.ip ), code,
+							  static_cast< int >( first.size ( ) ), first.data ( ), static_cast< int >( now.size ( ) ), now.data ( ) );
+			}
+		}
+
+		std::printf ( "backend:      %.*s\n", static_cast< int >( iced::backendName.size ( ) ), iced::backendName.data ( ) );
+		std::printf ( "checked:      %zu instructions, %zu distinct codes\n", checked, distinct );
+		std::printf ( "bad code:     %zu\n", badCodes );
+		std::printf ( "mismatched:   %zu\n", mismatched );
+		return checked && !badCodes && !mismatched;
+	}
+};
+
+int main ( ) {
+	tools::Corpus corpus;
+	tools::generate_corpus ( corpus, corpusSize, 0xC0DE );
+	return check ( corpus ) ? 0 : 1;
+}
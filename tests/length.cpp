@@ -0,0 +1,116 @@
+// Differential test of iced::instruction_length against the backend at every byte offset of the
+// corpus: generated code, then seeded random bytes. Where both sides accept an encoding the
+// lengths must be equal. Validity disagreements in either direction are counted and printed
+// but allowed: the native decoder checks validity only coarsely (see iced_length.hpp), so it
+// accepts undefined VEX/EVEX/XOP opcodes and some invalid operand forms the backend rejects.
+#include "iced.hpp"
+#include "iced_length.hpp"
+#include "iced_superset.hpp"
+
+#include "../tools/corpus.hpp"
+
+#include <cstdio>
+
+namespace
+{
+	/// Encodings at the edges of the native decoder's rules, checked before the generated code
+	constexpr std::uint8_t edgeCases [ ] = {
+		0xF0, 0x0F, 0xB1, 0x0A,                   // lock cmpxchg [rdx], ecx
+		0xF0, 0x01, 0x0A,                         // lock add [rdx], ecx
+		0xF0, 0x03, 0x0A,                         // lock add ecx, [rdx]: invalid
+		0xF0, 0x48, 0x83, 0x6C, 0x24, 0x08, 0x01, // lock sub qword [rsp+8], 1
+		0xF0, 0x48, 0x83, 0xEC, 0x28,             // lock sub rsp, 0x28: invalid
+		0xF0, 0x83, 0x3A, 0x01,                   // lock cmp [rdx], 1: invalid
+		0xF0, 0x87, 0x0A,                         // lock xchg [rdx], ecx
+		0xF0, 0xFF, 0x02,                         // lock inc dword [rdx]
+		0xF0, 0xFF, 0x12,                         // lock call [rdx]: invalid
+		0xF0, 0x0F, 0xBA, 0x2A, 0x01,             // lock bts dword [rdx], 1
+		0xF0, 0x0F, 0xBA, 0x22, 0x01,             // lock bt dword [rdx], 1: invalid
+		0xF0, 0x0F, 0xC7, 0x0A,                   // lock cmpxchg8b [rdx]
+		0xF0, 0x0F, 0xC1, 0x0A,                   // lock xadd [rdx], ecx
+		0xF0, 0x55,                               // lock push rbp: invalid
+		0x8E, 0x10,                               // mov ss, [rax]
+		0x8E, 0x08,                               // mov cs, [rax]: invalid
+		0x8C, 0x38,                               // mov [rax], sreg 7: invalid
+		0x66, 0x0F, 0x78, 0xC1, 0x04, 0x08,       // extrq xmm1, 4, 8
+		0xF2, 0x0F, 0x78, 0xC1, 0x04, 0x08,       // insertq xmm0, xmm1, 4, 8
+		0xC8, 0x20, 0x00, 0x01,                   // enter 0x20, 1
+		0x66, 0xC2, 0x08, 0x00,                   // ret 8 with operand size prefix
+		0x48, 0xA1, 1, 2, 3, 4, 5, 6, 7, 8,       // mov rax, [moffs64]
+		0x67, 0xA1, 1, 2, 3, 4,                   // mov eax, [moffs32]
+		0x66, 0x68, 0x34, 0x12,                   // push 0x1234
+		0xF3, 0x0F, 0xB8, 0xC1,                   // popcnt eax, ecx
+		0x0F, 0xB8, 0xC1,                         // jmpe: invalid in 64-bit mode
+		0x0F, 0x20, 0xC0,                         // mov rax, cr0
+		0xC4, 0xE3, 0x79, 0x0F, 0xC1, 0x04,       // vpalignr xmm0, xmm0, xmm1, 4
+		0x62, 0xF1, 0x7C, 0x48, 0x28, 0xC1,       // vmovaps zmm0, zmm1
+		0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+	};
+
+	constexpr std::size_t corpusSize = 4 << 20;
+	constexpr std::size_t randomSize = 4 << 20;
+	constexpr std::size_t shownMismatches = 16;
+
+	/// Whether the bytes at `code` start with a VEX, EVEX or XOP escape after any legacy prefixes
+	bool vector_escape ( const std::uint8_t* code, std::size_t size ) {
+		std::size_t offset = 0;
+		while ( offset < size && offset < iced::length::maxLength && iced::length::tables.prefix [ code [ offset ] ] ) {
+			++offset;
+		}
+		if ( offset >= size ) {
+			return false;
+		}
+
+		const auto escape = code [ offset ];
+		return escape == 0xC4 || escape == 0xC5 || escape == 0x62 || ( escape == 0x8F && offset + 1 < size && ( code [ offset + 1 ] & 0x1F ) >= 8 );
+	}
+
+	/// <returns>True if the native decoder's length equals the backend's wherever both accept the encoding</returns>
+	bool check ( const tools::Corpus& corpus ) {
+		const auto* code = corpus.code.data ( );
+		const auto size = corpus.code.size ( );
+		const iced::Superset superset ( code, size, corpus.address );
+
+		std::size_t agreed = 0, rejected = 0, mismatched = 0, nativeOnlyVector = 0, nativeOnlyOther = 0, backendOnly = 0;
+		for ( std::size_t offset = 0; offset < size; ++offset ) {
+			const std::size_t expected = superset.lengths ( ) [ offset ];
+			const auto native = iced::instruction_length ( code + offset, size - offset );
+			if ( native == expected ) {
+				++( expected ? agreed : rejected );
+				continue;
+			}
+			if ( !expected ) {
+				++( vector_escape ( code + offset, size - offset ) ? nativeOnlyVector : nativeOnlyOther );
+				continue;
+			}
+			if ( !native ) {
+				++backendOnly;
+				continue;
+			}
+
+			if ( ++mismatched <= shownMismatches ) {
+				std::printf ( "0x%llx: backend %zu, native %zu:", static_cast< unsigned long long >( corpus.address + offset ), expected, native );
+				for ( std::size_t index = 0; index < iced::length::maxLength && offset + index < size; ++index ) {
+					std::printf ( " %02x", code [ offset + index ] );
+				}
+				std::printf ( "\n" );
+			}
+		}
+
+		std::printf ( "backend:      %.*s\n", static_cast< int >( iced::backendName.size ( ) ), iced::backendName.data ( ) );
+		std::printf ( "offsets:      %zu\n", size );
+		std::printf ( "agreed:       %zu valid, %zu invalid\n", agreed, rejected );
+		std::printf ( "native only:  %zu VEX/EVEX/XOP, %zu other (allowed)\n", nativeOnlyVector, nativeOnlyOther );
+		std::printf ( "backend only: %zu (allowed)\n", backendOnly );
+		std::printf ( "mismatched:   %zu\n", mismatched );
+		return !mismatched;
+	}
+};
+
+int main ( ) {
+	tools::Corpus corpus;
+	tools::generate_corpus ( corpus, corpusSize, 0x1CED );
+	tools::append_random_bytes ( corpus, randomSize, 0x1CED );
+	corpus.code.insert ( corpus.code.begin ( ), std::begin ( edgeCases ), std::end ( edgeCases ) );
+	return check ( corpus ) ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// Checks how MemoryDecoder combines segments with fetched pages. The segment below neither
+// starts nor ends on a page boundary, so one fetched page surrounds it: segment bytes must win
+// inside it, the fetched bytes on either side must stay mapped, and an instruction crossing
+// either edge must be decoded from the right bytes on both sides.
+#include "iced.hpp"
+#include "iced_memory.hpp"
+
+#include <cstdio>
+
+namespace
+{
+	constexpr std::uint64_t fetchedStart = 0x1000;
+	constexpr std::uint64_t fetchedEnd = 0x3000;
+	constexpr std::uint64_t segmentStart = 0x1008;
+
+	/// mov rbp, rsp split across both edges of the segment: 48 | 89 e5 ... 48 89 | e5
+	constexpr std::uint8_t segmentBytes [ ] = { 0x89, 0xE5, 0x90, 0x90, 0x90, 0x90, 0x48, 0x89 };
+	constexpr std::uint64_t segmentEnd = segmentStart + sizeof ( segmentBytes );
+
+	/// Maps [fetchedStart, fetchedEnd) with nops, int3 where the segment shadows it
+	std::size_t fetch ( void* context, std::uint64_t address, std::uint8_t* buffer, std::size_t size ) {
+		( void )context;
+		if ( address < fetchedStart || address >= fetchedEnd ) {
+			return 0;
+		}
+
+		const auto count = static_cast< std::size_t >( std::min<std::uint64_t> ( size, fetchedEnd - address ) );
+		for ( std::size_t index = 0; index < count; ++index ) {
+			const auto byteAddress = address + index;
+			buffer [ index ] = byteAddress == segmentStart - 1 ? 0x48 : byteAddress == segmentEnd ? 0xE5 :
+				byteAddress >= segmentStart && byteAddress < segmentEnd ? 0xCC : 0x90;
+		}
+		return count;
+	}
+
+	/// <returns>True if the instruction at `ip` decodes to `mnemonic` with `length` bytes</returns>
+	bool expect ( iced::MemoryDecoder& decoder, std::uint64_t ip, Mnemonic mnemonic, std::size_t length ) {
+		if ( !decoder.set_ip ( ip ) ) {
+			std::printf ( "0x%llx: unmapped\n", static_cast< unsigned long long >( ip ) );
+			return false;
+		}
+
+		const auto& instruction = decoder.decode ( );
+		if ( instruction.mnemonic ( ) == mnemonic && instruction.length ( ) == length ) {
+			return true;
+		}
+
+		const auto name = iced::mnemonic_name ( instruction.mnemonic ( ) );
+		std::printf ( "0x%llx: %.*s, %u bytes\n", static_cast< unsigned long long >( ip ), static_cast< int >( name.size ( ) ), name.data ( ),
+					  static_cast< unsigned >( instruction.length ( ) ) );
+		return false;
+	}
+};
+
+int main ( ) {
+	iced::MemoryImage image;
+	image.add_segment ( segmentStart, segmentBytes, sizeof ( segmentBytes ) );
+	image.set_fetch ( fetch, nullptr, 4096 );
+	iced::MemoryDecoder decoder ( image, 4 );
+
+	bool passed = true;
+	passed &= expect ( decoder, fetchedStart, Mnemonic::Nop, 1 );
+	passed &= expect ( decoder, segmentStart - 1, Mnemonic::Mov, 3 ); // fetched into the segment
+	passed &= expect ( decoder, segmentStart + 2, Mnemonic::Nop, 1 );
+	passed &= expect ( decoder, segmentEnd - 2, Mnemonic::Mov, 3 );   // segment into the fetched page
+	passed &= expect ( decoder, segmentEnd + 0x10, Mnemonic::Nop, 1 ); // after the segment, same page
+	passed &= expect ( decoder, fetchedEnd - 1, Mnemonic::Nop, 1 );
+
+	if ( decoder.set_ip ( fetchedEnd ) ) {
+		std::printf ( "0x%llx: mapped past the fetched range\n", static_cast< unsigned long long >( fetchedEnd ) );
+		passed = false;
+	}
+
+	std::printf ( "memory: %s\n", passed ? "passed" : "failed" );
+	return passed ? 0 : 1;
+}
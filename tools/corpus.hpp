@@ -0,0 +1,88 @@
+#pragma once
+#ifndef __ICEDPP_TOOLS_CORPUS_DEF
+#define __ICEDPP_TOOLS_CORPUS_DEF
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Shared by icedpp-bench and the tests
+namespace tools
+{
+	/// Code the benchmarks and tests run over; the same bytes for either backend given the same options
+	struct Corpus {
+		std::vector<std::uint8_t> code;
+		std::uint64_t address = 0x140001000;
+		std::string source;
+	};
+
+	/// <summary>
+	///  Compiler-like x86-64: prologues, moves, arithmetic, calls, branches and the odd SSE/AVX
+	///  instruction, drawn from a fixed table so every run sees the same instruction mix
+	/// </summary>
+	inline void generate_corpus ( Corpus& corpus, std::size_t size, std::uint64_t seed ) {
+		struct Encoding {
+			std::uint8_t length;
+			std::uint8_t bytes [ 11 ];
+		};
+
+		static constexpr Encoding encodings [ ] = {
+			{ 1, { 0x55 } },                                                  // push rbp
+			{ 3, { 0x48, 0x89, 0xE5 } },                                      // mov rbp, rsp
+			{ 4, { 0x48, 0x83, 0xEC, 0x28 } },                                // sub rsp, 0x28
+			{ 4, { 0x48, 0x8B, 0x45, 0xF8 } },                                // mov rax, [rbp-8]
+			{ 5, { 0x48, 0x89, 0x4C, 0x24, 0x08 } },                          // mov [rsp+8], rcx
+			{ 7, { 0x48, 0x8D, 0x05, 0x10, 0x20, 0x00, 0x00 } },              // lea rax, [rip+0x2010]
+			{ 5, { 0xE8, 0x00, 0x01, 0x00, 0x00 } },                          // call rel32
+			{ 2, { 0x74, 0x10 } },                                            // je rel8
+			{ 6, { 0x0F, 0x85, 0x00, 0x02, 0x00, 0x00 } },                    // jne rel32
+			{ 3, { 0x48, 0x85, 0xC0 } },                                      // test rax, rax
+			{ 3, { 0x48, 0x31, 0xD2 } },                                      // xor rdx, rdx
+			{ 4, { 0x8B, 0x44, 0x8E, 0x10 } },                                // mov eax, [rsi+rcx*4+0x10]
+			{ 5, { 0xB9, 0x40, 0x00, 0x00, 0x00 } },                          // mov ecx, 0x40
+			{ 10, { 0x48, 0xB8, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 } }, // mov rax, imm64
+			{ 6, { 0xFF, 0x15, 0x00, 0x30, 0x00, 0x00 } },                    // call [rip+0x3000]
+			{ 4, { 0x0F, 0xB6, 0x04, 0x0A } },                                // movzx eax, byte [rdx+rcx]
+			{ 4, { 0xC5, 0xF8, 0x28, 0xC1 } },                                // vmovaps xmm0, xmm1
+			{ 5, { 0xF3, 0x0F, 0x10, 0x45, 0xF0 } },                          // movss xmm0, [rbp-0x10]
+			{ 3, { 0xF3, 0x48, 0xAB } },                                      // rep stosq
+			{ 4, { 0xF0, 0x0F, 0xB1, 0x0A } },                                // lock cmpxchg [rdx], ecx
+			{ 4, { 0x48, 0x83, 0xC4, 0x28 } },                                // add rsp, 0x28
+			{ 1, { 0x5D } },                                                  // pop rbp
+			{ 1, { 0xC3 } },                                                  // ret
+			{ 1, { 0xCC } },                                                  // int3
+		};
+		constexpr auto encodingCount = sizeof ( encodings ) / sizeof ( encodings [ 0 ] );
+
+		corpus.code.clear ( );
+		corpus.code.reserve ( size + sizeof ( Encoding::bytes ) );
+		auto state = seed | 1;
+		while ( corpus.code.size ( ) < size ) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+
+			const auto& encoding = encodings [ state % encodingCount ];
+			corpus.code.insert ( corpus.code.end ( ), encoding.bytes, encoding.bytes + encoding.length );
+		}
+		corpus.code.resize ( size );
+		corpus.source = "generated";
+	}
+
+	/// <summary>
+	///  Appends `size` uniformly random bytes, so tests also see arbitrary opcodes, prefixes and
+	///  VEX/EVEX/XOP payloads the encoding table never produces
+	/// </summary>
+	inline void append_random_bytes ( Corpus& corpus, std::size_t size, std::uint64_t seed ) {
+		corpus.code.reserve ( corpus.code.size ( ) + size );
+		auto state = seed | 1;
+		for ( std::size_t index = 0; index < size; ++index ) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			corpus.code.push_back ( static_cast< std::uint8_t >( state >> 24 ) );
+		}
+	}
+};
+#endif
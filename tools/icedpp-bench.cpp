@@ -0,0 +1,388 @@
+#include "iced.hpp"
+#include "iced_descent.hpp"
+#include "iced_image.hpp"
+#include "iced_intern.hpp"
+#include "iced_io.hpp"
+#include "iced_length.hpp"
+#include "iced_parallel.hpp"
+#include "iced_superset.hpp"
+#include "iced_symbols.hpp"
+
+#include "corpus.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+	struct Options {
+		const char* input = nullptr;
+		std::size_t corpusSize = 64ULL << 20;
+		std::size_t threads = 0;
+		std::size_t repeat = 3;
+		std::uint64_t seed = 0x1CED;
+	};
+
+	using tools::Corpus;
+
+	struct Result {
+		double seconds;
+		std::size_t instructions;
+	};
+
+	/// parallel_sweep sink keeping instruction starts only
+	struct Starts {
+		std::vector<std::uint64_t> ips;
+
+		void operator()( const iced::Instruction& instruction ) { ips.push_back ( instruction.ip ); }
+
+		void discard_before ( std::uint64_t ip ) {
+			ips.erase ( ips.begin ( ), std::lower_bound ( ips.begin ( ), ips.end ( ), ip ) );
+		}
+	};
+
+	constexpr std::size_t batchSize = 4096;
+
+	using Clock = std::chrono::steady_clock;
+
+	void usage ( ) {
+		std::fputs (
+			"usage: icedpp-bench [options] [file]\n"
+			"  Times the backend Iced_Wrapper was built with: iced, or Zydis with -DBUILD_WITH_ZYDIS=ON.\n"
+			"  The generated corpus is identical across builds for the same --size and --seed.\n"
+			"  file                executable sections of a PE or ELF image, or the whole file as raw code\n"
+			"  -n, --size MB       size of the generated corpus when no file is given (default 64)\n"
+			"      --seed N        seed of the generated corpus\n"
+			"  -j, --threads N     threads of the parallel runs (default: one per hardware thread)\n"
+			"  -r, --repeat N      best of N runs per benchmark (default 3)\n",
+			stderr );
+	}
+
+	bool parse_options ( int argc, char** argv, Options& options ) {
+		for ( int index = 1; index < argc; ++index ) {
+			const std::string_view argument = argv [ index ];
+			const auto number = [ & ] ( auto& out ) {
+				if ( index + 1 >= argc ) {
+					return false;
+				}
+				char* end = nullptr;
+				const auto* text = argv [ ++index ];
+				out = static_cast< std::remove_reference_t<decltype( out )> >( std::strtoull ( text, &end, 0 ) );
+				return end != text && *end == '\0';
+			};
+
+			bool ok = true;
+			if ( argument == "-n" || argument == "--size" ) {
+				ok = number ( options.corpusSize ) && options.corpusSize;
+				options.corpusSize <<= 20;
+			}
+			else if ( argument == "--seed" ) {
+				ok = number ( options.seed );
+			}
+			else if ( argument == "-j" || argument == "--threads" ) {
+				ok = number ( options.threads );
+			}
+			else if ( argument == "-r" || argument == "--repeat" ) {
+				ok = number ( options.repeat ) && options.repeat;
+			}
+			else if ( argument == "-h" || argument == "--help" ) {
+				return false;
+			}
+			else if ( !argument.empty ( ) && argument [ 0 ] == '-' ) {
+				std::fprintf ( stderr, "icedpp-bench: unknown option '%s'\n", argv [ index ] );
+				return false;
+			}
+			else if ( !options.input ) {
+				options.input = argv [ index ];
+			}
+			else {
+				std::fprintf ( stderr, "icedpp-bench: more than one input file\n" );
+				return false;
+			}
+
+			if ( !ok ) {
+				std::fprintf ( stderr, "icedpp-bench: bad value for '%s'\n", argv [ index - 1 ] );
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Concatenated executable sections of an image, or the whole file when it is not one
+	bool load ( Corpus& corpus, const char* path ) {
+		iced::MappedFile file ( path );
+		if ( !file.is_open ( ) ) {
+			std::fprintf ( stderr, "icedpp-bench: cannot open '%s'\n", path );
+			return false;
+		}
+
+		iced::ImageView image ( file.data ( ), file.size ( ) );
+		if ( image.format ( ) != iced::ImageView::Format::Unknown ) {
+			corpus.address = ~0ULL;
+			for ( const auto& section : image.sections ( ) ) {
+				if ( section.executable ) {
+					const auto size = static_cast< std::size_t >( std::min ( section.size, section.fileSize ) );
+					corpus.address = std::min ( corpus.address, section.address );
+					corpus.code.insert ( corpus.code.end ( ), image.data ( ) + section.fileOffset, image.data ( ) + section.fileOffset + size );
+				}
+			}
+		}
+
+		if ( corpus.code.empty ( ) ) {
+			corpus.code.assign ( file.data ( ), file.data ( ) + file.size ( ) );
+			corpus.address = 0;
+		}
+		corpus.source = path;
+		return !corpus.code.empty ( );
+	}
+
+	/// Best of `repeat` runs of run ( ), which returns the number of instructions it handled
+	template<typename Run>
+	Result measure ( std::size_t repeat, Run&& run ) {
+		Result best { 0, 0 };
+		for ( std::size_t attempt = 0; attempt < repeat; ++attempt ) {
+			const auto start = Clock::now ( );
+			const auto instructions = run ( );
+			const auto seconds = std::chrono::duration<double> ( Clock::now ( ) - start ).count ( );
+			if ( !attempt || seconds < best.seconds ) {
+				best = { seconds, instructions };
+			}
+		}
+		return best;
+	}
+
+	void report ( const char* name, const Result& result, std::size_t bytes ) {
+		const auto megabytes = static_cast< double >( bytes ) / ( 1024.0 * 1024.0 );
+		const auto seconds = result.seconds > 0 ? result.seconds : 1e-9;
+		std::printf ( "%-22s %9.3f ms  %9.1f MB/s  %8.2f M instructions/s  %zu instructions\n", name, result.seconds * 1e3,
+					  megabytes / seconds, static_cast< double >( result.instructions ) / seconds / 1e6, result.instructions );
+	}
+
+	void run_benchmarks ( const Corpus& corpus, const Options& options ) {
+		const auto* code = corpus.code.data ( );
+		const auto size = corpus.code.size ( );
+		const auto base = corpus.address;
+		const auto threads = iced::worker_count ( options.threads );
+
+		char parallelName [ 32 ];
+		const auto parallel = [ & ] ( const char* name ) {
+			std::snprintf ( parallelName, sizeof ( parallelName ), "%s x%zu", name, threads );
+			return parallelName;
+		};
+
+		warm_up_thread ( );
+
+		// Instruction starts of the linear sweep, input to the format and gather benchmarks
+		std::vector<std::uint64_t> ips;
+		ips.reserve ( size / 4 );
+
+		report ( "decode (release)", measure ( options.repeat, [ & ] ( ) {
+			ips.clear ( );
+			iced::ReleaseDecoder decoder ( code, size, base );
+			while ( decoder.can_decode ( ) ) {
+				ips.push_back ( decoder.ip ( ) );
+				( void )decoder.decode ( );
+			}
+			return ips.size ( );
+		} ), size );
+
+		// The fast/tail split against the old path, which clamped the window to what is left on every call
+		report ( "decode (fast+tail)", measure ( options.repeat, [ & ] ( ) {
+			std::size_t count = 0;
+			iced::ReleaseDecoder decoder ( code, size, base );
+			while ( decoder.can_decode_fast ( ) ) {
+				( void )decoder.decode_unchecked ( );
+				++count;
+			}
+			while ( decoder.can_decode ( ) ) {
+				( void )decoder.decode ( );
+				++count;
+			}
+			return count;
+		} ), size );
+
+		report ( "decode (clamped)", measure ( options.repeat, [ & ] ( ) {
+			std::size_t count = 0;
+			iced::Instruction instruction;
+			for ( std::size_t offset = 0; offset < size; ++count ) {
+				__iced_internal::IcedInstruction icedInstruction {};
+				disas ( &icedInstruction, code + offset, std::min<std::size_t> ( 16, size - offset ) );
+				instruction = iced::Instruction { icedInstruction, base + offset };
+				if ( !icedInstruction.length ) {
+					break;
+				}
+				offset += icedInstruction.length;
+			}
+			return count;
+		} ), size );
+
+		report ( "length (native)", measure ( options.repeat, [ & ] ( ) {
+			std::size_t count = 0;
+			for ( std::size_t offset = 0; offset < size; ++count ) {
+				const auto length = iced::instruction_length ( code + offset, size - offset );
+				offset += length ? length : 1;
+			}
+			return count;
+		} ), size );
+
+		report ( "decode (debug)", measure ( options.repeat, [ & ] ( ) {
+			std::size_t count = 0;
+			iced::BasicDebugDecoder<iced::syntax::Fast> decoder ( code, size, base );
+			while ( decoder.can_decode ( ) ) {
+				( void )decoder.decode ( );
+				++count;
+			}
+			return count;
+		} ), size );
+
+		report ( parallel ( "sweep" ), measure ( options.repeat, [ & ] ( ) {
+			std::vector<Starts> sinks ( threads );
+			iced::parallel_sweep ( code, size, base, sinks );
+
+			std::size_t count = 0;
+			for ( const auto& sink : sinks ) {
+				count += sink.ips.size ( );
+			}
+			return count;
+		} ), size );
+
+		// Recursive descent seeded from every 1024th instruction of the sweep, standing in for a function table
+		std::vector<std::uint64_t> entries;
+		for ( std::size_t index = 0; index < ips.size ( ); index += 1024 ) {
+			entries.push_back ( ips [ index ] );
+		}
+
+		iced::RecursiveDescent descent;
+		const auto single = measure ( options.repeat, [ & ] ( ) {
+			descent.build ( code, size, base, entries, 1 );
+			return descent.instructions ( ).size ( );
+		} );
+		const auto multi = measure ( options.repeat, [ & ] ( ) {
+			descent.build ( code, size, base, entries, threads );
+			return descent.instructions ( ).size ( );
+		} );
+
+		// Only reachable code is decoded, so throughput is over the bytes actually covered
+		std::size_t covered = 0;
+		for ( const auto& instruction : descent.instructions ( ) ) {
+			covered += instruction.length ( );
+		}
+		report ( "descent", single, covered );
+		report ( parallel ( "descent" ), multi, covered );
+
+		{
+			iced::InternTable table;
+			iced::InternedListing listing;
+			report ( parallel ( "intern" ), measure ( options.repeat, [ & ] ( ) {
+				( void )listing.build ( code, size, base, table, threads );
+				return listing.size ( );
+			} ), size );
+
+			const auto records = static_cast< double >( listing.size ( ) * sizeof ( iced::CompactInstruction ) );
+			const auto interned = static_cast< double >( listing.memory_usage ( ) + table.memory_usage ( ) );
+			std::printf ( "%-22s %zu unique encodings, %.1f MB instead of %.1f MB\n", "", table.size ( ), interned / ( 1024.0 * 1024.0 ),
+						  records / ( 1024.0 * 1024.0 ) );
+		}
+
+		const auto batches = ( ips.size ( ) + batchSize - 1 ) / batchSize;
+		// One symbol per 4 KB, so most branch targets and RIP-relative operands resolve to name+offset
+		std::vector<iced::Symbol> symbolList;
+		for ( std::uint64_t offset = 0; offset < size; offset += 0x1000 ) {
+			char name [ 32 ];
+			std::snprintf ( name, sizeof ( name ), "sub_%llx", static_cast< unsigned long long >( base + offset ) );
+			symbolList.push_back ( { base + offset, 0, name } );
+		}
+		const iced::SymbolTable symbols ( std::move ( symbolList ) );
+
+		const auto format_batches = [ & ] ( auto syntax, std::size_t workers, const iced::SymbolTable* resolver = nullptr ) {
+			using Syntax = decltype( syntax );
+			std::atomic<std::size_t> formatted { 0 };
+			iced::parallel_for ( batches, workers, [ & ] ( std::size_t batch ) {
+				thread_local iced::TextArena arena;
+				thread_local std::vector<iced::TextSpan> spans;
+
+				const auto first = batch * batchSize;
+				const auto count = std::min ( batchSize, ips.size ( ) - first );
+				arena.clear ( );
+				spans.resize ( count );
+				iced::BasicBatchFormatter<Syntax> formatter ( code, size, base );
+				if ( resolver ) {
+					formatter.set_symbol_resolver ( iced::SymbolTable::resolve, resolver );
+				}
+				formatted.fetch_add ( formatter.format ( ips.data ( ) + first, count, arena, spans.data ( ) ), std::memory_order_relaxed );
+			} );
+			return formatted.load ( );
+		};
+
+		report ( "format", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Fast { }, 1 ); } ), size );
+		report ( "format (symbols)", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Fast { }, 1, &symbols ); } ), size );
+		report ( parallel ( "format" ), measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Fast { }, threads ); } ), size );
+		report ( "format (intel)", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Intel { }, 1 ); } ), size );
+		report ( "format (masm)", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Masm { }, 1 ); } ), size );
+		report ( "format (nasm)", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Nasm { }, 1 ); } ), size );
+		report ( "format (gas)", measure ( options.repeat, [ & ] ( ) { return format_batches ( iced::syntax::Gas { }, 1 ); } ), size );
+
+		iced::Superset superset;
+		report ( "superset", measure ( options.repeat, [ & ] ( ) {
+			superset.build ( code, size, base, 1 );
+			return superset.valid_count ( );
+		} ), size );
+		report ( parallel ( "superset" ), measure ( options.repeat, [ & ] ( ) {
+			superset.build ( code, size, base, threads );
+			return superset.valid_count ( );
+		} ), size );
+
+		std::vector<std::uint8_t> lengths ( size );
+		report ( "superset (native)", measure ( options.repeat, [ & ] ( ) {
+			std::size_t valid = 0;
+			for ( std::size_t offset = 0; offset < size; ++offset ) {
+				lengths [ offset ] = static_cast< std::uint8_t >( iced::instruction_length ( code + offset, size - offset ) );
+				valid += lengths [ offset ] != 0;
+			}
+			return valid;
+		} ), size );
+
+		// Gather visits the sweep's instructions in a scrambled but fixed order, as xref or CFG passes would
+		auto scrambled = ips;
+		for ( std::size_t index = scrambled.size ( ); index > 1; --index ) {
+			std::swap ( scrambled [ index - 1 ], scrambled [ ( index * 0x9E3779B97F4A7C15ULL >> 17 ) % index ] );
+		}
+
+		std::vector<iced::CompactInstruction> gathered ( scrambled.size ( ) );
+		iced::ReleaseDecoder decoder ( code, size, base );
+		report ( "gather", measure ( options.repeat, [ & ] ( ) {
+			return decoder.gather ( scrambled.data ( ), scrambled.size ( ), gathered.data ( ) );
+		} ), size );
+		report ( parallel ( "gather" ), measure ( options.repeat, [ & ] ( ) {
+			return iced::parallel_gather ( decoder, scrambled.data ( ), scrambled.size ( ), gathered.data ( ), threads );
+		} ), size );
+	}
+};
+
+int main ( int argc, char** argv ) {
+	Options options;
+	if ( !parse_options ( argc, argv, options ) ) {
+		usage ( );
+		return 2;
+	}
+
+	Corpus corpus;
+	if ( options.input ) {
+		if ( !load ( corpus, options.input ) ) {
+			return 1;
+		}
+	}
+	else {
+		tools::generate_corpus ( corpus, options.corpusSize, options.seed );
+	}
+
+	std::printf ( "backend: %.*s\n", static_cast< int >( iced::backendName.size ( ) ), iced::backendName.data ( ) );
+	std::printf ( "corpus:  %s, %zu bytes at 0x%llx\n", corpus.source.c_str ( ), corpus.code.size ( ),
+				  static_cast< unsigned long long >( corpus.address ) );
+	std::printf ( "threads: %zu, best of %zu\n\n", iced::worker_count ( options.threads ), options.repeat );
+
+	run_benchmarks ( corpus, options );
+	return 0;
+}
@@ -0,0 +1,420 @@
+#include "iced.hpp"
+#include "iced_image.hpp"
+#include "iced_io.hpp"
+#include "iced_parallel.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+	enum class Mode : std::uint8_t {
+		Listing, // address, bytes, text
+		Hex,     // address, bytes; decode only, nothing is formatted
+		Raw,     // text
+	};
+
+	struct Options {
+		std::vector<std::string> sections;
+		std::uint64_t start = 0;
+		std::uint64_t end = ~0ULL;
+		std::uint64_t base = 0;
+		std::size_t threads = 0;
+		const char* input = nullptr;
+		const char* output = nullptr;
+		const char* syntax = "fast";
+		Mode mode = Mode::Listing;
+		bool rawInput = false;
+		bool stats = false;
+	};
+
+	struct Region {
+		std::string name;
+		const std::uint8_t* code;
+		std::size_t size;
+		std::uint64_t address;
+	};
+
+	struct Stats {
+		std::size_t regions = 0;
+		std::uint64_t bytes = 0;
+		std::uint64_t instructions = 0;
+		double decodeSeconds = 0;
+		double formatSeconds = 0;
+		double writeSeconds = 0;
+	};
+
+	/// parallel_sweep sink keeping only instruction starts and lengths
+	struct Boundaries {
+		std::vector<std::uint64_t> ips;
+		std::vector<std::uint8_t> lengths;
+
+		void operator()( const iced::Instruction& instruction ) {
+			ips.push_back ( instruction.ip );
+			lengths.push_back ( instruction.length ( ) );
+		}
+
+		void discard_before ( std::uint64_t ip ) {
+			const auto count = std::lower_bound ( ips.begin ( ), ips.end ( ), ip ) - ips.begin ( );
+			ips.erase ( ips.begin ( ), ips.begin ( ) + count );
+			lengths.erase ( lengths.begin ( ), lengths.begin ( ) + count );
+		}
+	};
+
+	/// Consecutive instructions rendered by one task
+	struct Batch {
+		const std::uint64_t* ips;
+		const std::uint8_t* lengths;
+		std::size_t count;
+	};
+
+	constexpr std::size_t batchSize = 4096;
+	constexpr std::size_t bytesColumn = 10;
+
+	using Clock = std::chrono::steady_clock;
+
+	double seconds_since ( Clock::time_point start ) {
+		return std::chrono::duration<double> ( Clock::now ( ) - start ).count ( );
+	}
+
+	void usage ( ) {
+		std::fputs (
+			"usage: icedpp-dis [options] <file>\n"
+			"  -s, --section NAME  disassemble section NAME (repeatable; default: executable sections)\n"
+			"      --start ADDR    first address to disassemble\n"
+			"      --end ADDR      stop before ADDR\n"
+			"      --base ADDR     load address of raw input (default 0)\n"
+			"      --raw-input     treat the file as raw code even if it is a PE or ELF image\n"
+			"  -m, --mode MODE     listing (address, bytes, text; default), hex (address, bytes), raw (text)\n"
+			"      --syntax NAME   fast (default), intel, masm, nasm, gas\n"
+			"  -j, --threads N     worker threads (default: one per hardware thread)\n"
+			"  -o, --output FILE   write to FILE instead of stdout\n"
+			"      --stats         decode and format everything, print a throughput summary instead of the listing\n",
+			stderr );
+	}
+
+	bool parse_number ( const char* text, std::uint64_t& value ) {
+		char* end = nullptr;
+		value = std::strtoull ( text, &end, 0 );
+		return end != text && *end == '\0';
+	}
+
+	bool parse_options ( int argc, char** argv, Options& options ) {
+		for ( int index = 1; index < argc; ++index ) {
+			const std::string_view argument = argv [ index ];
+			const auto value = [ & ] ( ) -> const char* {
+				return index + 1 < argc ? argv [ ++index ] : nullptr;
+			};
+			const auto number = [ & ] ( std::uint64_t& out ) {
+				const auto* text = value ( );
+				return text && parse_number ( text, out );
+			};
+
+			bool ok = true;
+			if ( argument == "-s" || argument == "--section" ) {
+				const auto* name = value ( );
+				ok = name != nullptr;
+				if ( ok ) {
+					options.sections.emplace_back ( name );
+				}
+			}
+			else if ( argument == "--start" ) {
+				ok = number ( options.start );
+			}
+			else if ( argument == "--end" ) {
+				ok = number ( options.end );
+			}
+			else if ( argument == "--base" ) {
+				ok = number ( options.base );
+			}
+			else if ( argument == "--raw-input" ) {
+				options.rawInput = true;
+			}
+			else if ( argument == "-m" || argument == "--mode" ) {
+				const std::string_view mode = value ( ) ? argv [ index ] : "";
+				if ( mode == "listing" ) {
+					options.mode = Mode::Listing;
+				}
+				else if ( mode == "hex" ) {
+					options.mode = Mode::Hex;
+				}
+				else if ( mode == "raw" ) {
+					options.mode = Mode::Raw;
+				}
+				else {
+					ok = false;
+				}
+			}
+			else if ( argument == "--syntax" ) {
+				options.syntax = value ( );
+				const std::string_view syntax = options.syntax ? options.syntax : "";
+				ok = syntax == "fast" || syntax == "intel" || syntax == "masm" || syntax == "nasm" || syntax == "gas";
+			}
+			else if ( argument == "-j" || argument == "--threads" ) {
+				std::uint64_t threads = 0;
+				ok = number ( threads );
+				options.threads = static_cast< std::size_t >( threads );
+			}
+			else if ( argument == "-o" || argument == "--output" ) {
+				options.output = value ( );
+				ok = options.output != nullptr;
+			}
+			else if ( argument == "--stats" ) {
+				options.stats = true;
+			}
+			else if ( argument == "-h" || argument == "--help" ) {
+				return false;
+			}
+			else if ( !argument.empty ( ) && argument [ 0 ] != '-' && !options.input ) {
+				options.input = argv [ index ];
+			}
+			else {
+				ok = false;
+			}
+
+			if ( !ok ) {
+				std::fprintf ( stderr, "icedpp-dis: invalid argument '%s'\n", argv [ index ] );
+				return false;
+			}
+		}
+
+		if ( !options.input ) {
+			std::fputs ( "icedpp-dis: no input file\n", stderr );
+			return false;
+		}
+		return true;
+	}
+
+	/// Clips [address, address + size) to the requested range; false if nothing is left
+	bool add_region ( std::vector<Region>& regions, const Options& options, std::string name, const std::uint8_t* code,
+					  std::size_t size, std::uint64_t address ) {
+		const auto first = std::max ( address, options.start );
+		const auto last = std::min ( address + size, options.end );
+		if ( first >= last ) {
+			return false;
+		}
+
+		regions.push_back ( { std::move ( name ), code + ( first - address ), static_cast< std::size_t >( last - first ), first } );
+		return true;
+	}
+
+	bool select_regions ( const iced::MappedFile& file, const iced::ImageView& image, const Options& options, std::vector<Region>& regions ) {
+		if ( image.format ( ) == iced::ImageView::Format::Unknown ) {
+			add_region ( regions, options, "raw", file.data ( ), file.size ( ), options.base );
+			return true;
+		}
+
+		const auto add_section = [ & ] ( const iced::ImageSection& section ) {
+			const auto size = static_cast< std::size_t >( std::min ( section.size, section.fileSize ) );
+			add_region ( regions, options, section.name, image.data ( ) + section.fileOffset, size, section.address );
+		};
+
+		if ( options.sections.empty ( ) ) {
+			for ( const auto& section : image.sections ( ) ) {
+				if ( section.executable ) {
+					add_section ( section );
+				}
+			}
+			return true;
+		}
+
+		for ( const auto& name : options.sections ) {
+			const auto* section = image.find_section ( name.c_str ( ) );
+			if ( !section ) {
+				std::fprintf ( stderr, "icedpp-dis: no section '%s'\n", name.c_str ( ) );
+				return false;
+			}
+			add_section ( *section );
+		}
+		return true;
+	}
+
+	/// Right-aligned lowercase hex, padded with spaces to `width`
+	FORCE_INLINE void append_address ( std::string& out, std::uint64_t address, std::size_t width ) {
+		char digits [ 16 ];
+		const auto end = std::to_chars ( digits, digits + sizeof ( digits ), address, 16 ).ptr;
+		const auto length = static_cast< std::size_t >( end - digits );
+		out.append ( width > length ? width - length : 0, ' ' );
+		out.append ( digits, length );
+		out += ": ";
+	}
+
+	FORCE_INLINE void append_bytes ( std::string& out, const std::uint8_t* bytes, std::size_t length, bool pad ) {
+		constexpr char hex [ ] = "0123456789abcdef";
+		for ( std::size_t index = 0; index < length; ++index ) {
+			if ( index ) {
+				out += ' ';
+			}
+			out += hex [ bytes [ index ] >> 4 ];
+			out += hex [ bytes [ index ] & 0xF ];
+		}
+		if ( pad ) {
+			out.append ( length < bytesColumn ? ( bytesColumn - length ) * 3 + 1 : 1, ' ' );
+		}
+	}
+
+	template<typename Syntax>
+	void render ( const Region& region, const Batch& batch, Mode mode, std::size_t addressWidth, std::string& out ) {
+		thread_local iced::TextArena arena;
+		thread_local std::vector<iced::TextSpan> spans;
+
+		if ( mode != Mode::Hex ) {
+			arena.clear ( );
+			spans.resize ( batch.count );
+			iced::BasicBatchFormatter<Syntax> formatter ( region.code, region.size, region.address );
+			formatter.format ( batch.ips, batch.count, arena, spans.data ( ) );
+		}
+
+		out.reserve ( batch.count * ( mode == Mode::Raw ? 32 : 80 ) );
+		for ( std::size_t index = 0; index < batch.count; ++index ) {
+			if ( mode != Mode::Raw ) {
+				append_address ( out, batch.ips [ index ], addressWidth );
+				append_bytes ( out, region.code + ( batch.ips [ index ] - region.address ), batch.lengths [ index ], mode == Mode::Listing );
+			}
+			if ( mode != Mode::Hex ) {
+				out += arena.view ( spans [ index ] );
+			}
+			out += '\n';
+		}
+	}
+
+	template<typename Syntax>
+	bool disassemble ( const std::vector<Region>& regions, const Options& options, iced::BufferedWriter& writer, Stats& stats ) {
+		const auto threads = iced::worker_count ( options.threads );
+
+		for ( const auto& region : regions ) {
+			auto start = Clock::now ( );
+			std::vector<Boundaries> sinks ( threads );
+			iced::parallel_sweep ( region.code, region.size, region.address, sinks );
+			stats.decodeSeconds += seconds_since ( start );
+
+			std::vector<Batch> batches;
+			for ( const auto& sink : sinks ) {
+				for ( std::size_t first = 0; first < sink.ips.size ( ); first += batchSize ) {
+					batches.push_back ( { sink.ips.data ( ) + first, sink.lengths.data ( ) + first, std::min ( batchSize, sink.ips.size ( ) - first ) } );
+				}
+				stats.instructions += sink.ips.size ( );
+			}
+			stats.bytes += region.size;
+			++stats.regions;
+
+			char lastAddress [ 16 ];
+			const auto addressWidth = static_cast< std::size_t >(
+				std::to_chars ( lastAddress, lastAddress + sizeof ( lastAddress ), region.address + region.size - 1, 16 ).ptr - lastAddress );
+
+			if ( !options.stats && options.mode != Mode::Raw ) {
+				writer.write ( "\nDisassembly of section " );
+				writer.write ( region.name );
+				writer.write ( ":\n\n" );
+			}
+
+			// Batches are formatted in parallel and written in order; time not spent writing is formatting
+			start = Clock::now ( );
+			double writeSeconds = 0;
+			iced::parallel_ordered ( batches.size ( ), threads, [ & ] ( std::size_t index, std::string& text ) {
+				render<Syntax> ( region, batches [ index ], options.mode, addressWidth, text );
+			}, [ & ] ( std::string_view text ) {
+				if ( !options.stats ) {
+					const auto writeStart = Clock::now ( );
+					writer.write ( text );
+					writeSeconds += seconds_since ( writeStart );
+				}
+			} );
+			stats.formatSeconds += seconds_since ( start ) - writeSeconds;
+			stats.writeSeconds += writeSeconds;
+		}
+
+		const auto start = Clock::now ( );
+		const auto flushed = writer.flush ( );
+		stats.writeSeconds += seconds_since ( start );
+		return flushed;
+	}
+
+	void print_stats ( const Stats& stats, std::uint64_t written ) {
+		const auto megabytes = static_cast< double >( stats.bytes ) / ( 1024.0 * 1024.0 );
+		const auto rate = [ & ] ( double seconds ) { return seconds > 0 ? megabytes / seconds : 0.0; };
+		const auto total = stats.decodeSeconds + stats.formatSeconds + stats.writeSeconds;
+
+		std::fprintf ( stderr, "regions:      %zu\n", stats.regions );
+		std::fprintf ( stderr, "bytes:        %llu\n", static_cast< unsigned long long >( stats.bytes ) );
+		std::fprintf ( stderr, "instructions: %llu\n", static_cast< unsigned long long >( stats.instructions ) );
+		std::fprintf ( stderr, "decode:       %.3f s  %.1f MB/s\n", stats.decodeSeconds, rate ( stats.decodeSeconds ) );
+		std::fprintf ( stderr, "format:       %.3f s  %.1f MB/s\n", stats.formatSeconds, rate ( stats.formatSeconds ) );
+		std::fprintf ( stderr, "write:        %.3f s  %llu bytes\n", stats.writeSeconds, static_cast< unsigned long long >( written ) );
+		std::fprintf ( stderr, "total:        %.3f s  %.1f MB/s  %.1f M instructions/s\n", total, rate ( total ),
+					   total > 0 ? static_cast< double >( stats.instructions ) / total / 1e6 : 0.0 );
+	}
+};
+
+int main ( int argc, char** argv ) {
+	Options options;
+	if ( !parse_options ( argc, argv, options ) ) {
+		usage ( );
+		return 2;
+	}
+
+	iced::MappedFile file ( options.input );
+	if ( !file.is_open ( ) ) {
+		std::fprintf ( stderr, "icedpp-dis: cannot open '%s'\n", options.input );
+		return 1;
+	}
+
+	iced::ImageView image;
+	if ( !options.rawInput ) {
+		( void )image.parse ( file.data ( ), file.size ( ) );
+	}
+
+	std::vector<Region> regions;
+	if ( !select_regions ( file, image, options, regions ) ) {
+		return 1;
+	}
+
+	auto* output = stdout;
+	if ( options.output && !options.stats ) {
+		output = std::fopen ( options.output, "wb" );
+		if ( !output ) {
+			std::fprintf ( stderr, "icedpp-dis: cannot create '%s'\n", options.output );
+			return 1;
+		}
+	}
+
+	Stats stats;
+	bool ok = true;
+	std::uint64_t written = 0;
+	{
+		iced::BufferedWriter writer ( output );
+		const std::string_view syntax = options.syntax;
+		if ( syntax == "fast" ) {
+			ok = disassemble<iced::syntax::Fast> ( regions, options, writer, stats );
+		}
+		else if ( syntax == "intel" ) {
+			ok = disassemble<iced::syntax::Intel> ( regions, options, writer, stats );
+		}
+		else if ( syntax == "masm" ) {
+			ok = disassemble<iced::syntax::Masm> ( regions, options, writer, stats );
+		}
+		else if ( syntax == "nasm" ) {
+			ok = disassemble<iced::syntax::Nasm> ( regions, options, writer, stats );
+		}
+		else {
+			ok = disassemble<iced::syntax::Gas> ( regions, options, writer, stats );
+		}
+		written = writer.written ( );
+	}
+
+	if ( output != stdout ) {
+		ok = std::fclose ( output ) == 0 && ok;
+	}
+
+	if ( options.stats ) {
+		print_stats ( stats, written );
+	}
+
+	if ( !ok ) {
+		std::fputs ( "icedpp-dis: write failed\n", stderr );
+	}
+	return ok ? 0 : 1;
+}